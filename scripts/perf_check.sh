@@ -0,0 +1,141 @@
+#!/usr/bin/env bash
+# ==========================================================
+# 性能回归检查（仓库自带算例 × 多进程数，与基线 CSV 比较）
+# ==========================================================
+#
+# 对 ldc_uni / ldc_exp / poiseuille 三个算例，分别以 1、2、4 个进程运行固定
+# 次数的定常 SIMPLE 迭代（--fixed-iters --no-output --perf），每个组合重复
+# REPEATS 次取最快的一次，记录：
+#
+#   case,ranks,iters,time_per_iter,krylov_per_solve,res_u,res_v,res_p
+#
+# 然后与基线（默认 scripts/perf_baseline.csv）逐行比较，以下任一情况判为回归，
+# 脚本以非零状态退出：
+# - time_per_iter    > 基线 × (1 + PERF_TIME_TOL)   （吞吐量下降）
+# - krylov_per_solve > 基线 × (1 + PERF_ITER_TOL)   （线性求解迭代数上升）
+# - res_u/v/p        > 基线 × (1 + PERF_RES_TOL)    （固定迭代后残差变差）
+#
+# 计时与硬件相关：更换机器或有意改变性能后，用 -u 重新生成基线并提交。
+#
+# 用法:
+#   scripts/perf_check.sh [-u] [-r "1 2 4"] [-i 迭代次数] [-k 重复次数]
+#                         [-b baseline.csv] [-o out.csv]
+#     -u  将本次结果写为新基线（不做比较）
+#
+# 环境变量:
+#   MPIRUN          mpirun 命令（默认 "mpirun --oversubscribe"）
+#   BIN_DIR         求解器所在目录（默认为仓库根目录）
+#   PERF_TIME_TOL   每次迭代耗时的相对容差（默认 0.20）
+#   PERF_ITER_TOL   每次求解 Krylov 迭代数的相对容差（默认 0.02）
+#   PERF_RES_TOL    最终残差的相对容差（默认 0.05）
+# ==========================================================
+
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BIN_DIR="${BIN_DIR:-$ROOT_DIR}"
+MPIRUN="${MPIRUN:-mpirun --oversubscribe}"
+BIN="$BIN_DIR/solver_simple_steady"
+
+CASES="ldc_uni ldc_exp poiseuille"
+RANKS="1 2 4"
+ITERS=100
+REPEATS=5
+MU=0.01
+BASELINE="$ROOT_DIR/scripts/perf_baseline.csv"
+OUT=""
+UPDATE=0
+
+TIME_TOL="${PERF_TIME_TOL:-0.20}"
+ITER_TOL="${PERF_ITER_TOL:-0.02}"
+RES_TOL="${PERF_RES_TOL:-0.05}"
+
+while getopts "ur:i:k:b:o:h" opt; do
+    case "$opt" in
+        u) UPDATE=1 ;;
+        r) RANKS="$OPTARG" ;;
+        i) ITERS="$OPTARG" ;;
+        k) REPEATS="$OPTARG" ;;
+        b) BASELINE="$OPTARG" ;;
+        o) OUT="$OPTARG" ;;
+        *) sed -n '2,32p' "$0"; exit 0 ;;
+    esac
+done
+
+if [[ ! -x "$BIN" ]]; then
+    echo "找不到可执行文件 $BIN，请先 make" >&2
+    exit 1
+fi
+
+HEADER="case,ranks,iters,time_per_iter,krylov_per_solve,res_u,res_v,res_p"
+RESULT="$(mktemp)"
+trap 'rm -f "$RESULT"' EXIT
+echo "$HEADER" > "$RESULT"
+
+# 运行一次，输出 PERF 行中 tag 之后的字段
+run_once() {
+    local np="$1" case_dir="$2"
+    local tmp
+    tmp="$(mktemp -d)"
+    (cd "$tmp" && $MPIRUN -np "$np" "$BIN" "$case_dir" "$ITERS" "$MU" \
+        --fixed-iters --no-output --quiet --perf) | grep '^PERF,' | cut -d, -f3-
+    rm -rf "$tmp"
+}
+
+for c in $CASES; do
+    for np in $RANKS; do
+        best=""
+        for ((k = 0; k < REPEATS; k++)); do
+            line="$(run_once "$np" "$ROOT_DIR/$c")"
+            if [[ -z "$line" ]]; then
+                echo "[$c] np=$np 运行失败（无 PERF 输出）" >&2
+                exit 1
+            fi
+            IFS=, read -r _ _ iters tpi _ kry solves ru rv rp <<< "$line"
+            # 迭代数与残差在重复运行间不变，只取最快的计时
+            if [[ -z "$best" ]] || awk -v a="$tpi" -v b="$best" 'BEGIN{exit !(a < b)}'; then
+                best="$tpi"
+            fi
+        done
+        kps="$(awk -v k="$kry" -v s="$solves" 'BEGIN{printf "%.4f", (s > 0) ? k / s : 0}')"
+        echo "$c,$np,$iters,$best,$kps,$ru,$rv,$rp" >> "$RESULT"
+        printf "  %-12s np=%-2s  %s 秒/迭代  %s 次/求解\n" "$c" "$np" "$best" "$kps"
+    done
+done
+
+[[ -n "$OUT" ]] && cp "$RESULT" "$OUT"
+
+if [[ "$UPDATE" == 1 ]]; then
+    cp "$RESULT" "$BASELINE"
+    echo "基线已更新: $BASELINE"
+    exit 0
+fi
+
+if [[ ! -f "$BASELINE" ]]; then
+    echo "找不到基线 $BASELINE，请先运行 make perf-baseline" >&2
+    exit 1
+fi
+
+# 按 (case, ranks) 与基线逐项比较
+awk -F, -v tt="$TIME_TOL" -v it="$ITER_TOL" -v rt="$RES_TOL" '
+    FNR == 1 { next }
+    NR == FNR { key = $1 "," $2; base[key] = $0; next }
+    {
+        key = $1 "," $2
+        if (!(key in base)) { printf "  %-16s 基线中无此项（跳过）\n", key; next }
+        split(base[key], b, ",")
+        if ($3 != b[3]) { printf "  %-16s 迭代次数 %s 与基线 %s 不同（跳过）\n", key, $3, b[3]; next }
+        bad = ""
+        if ($4 > b[4] * (1 + tt)) bad = bad sprintf(" 耗时 %.3e→%.3e (%+.1f%%)", b[4], $4, 100 * ($4 / b[4] - 1))
+        if ($5 > b[5] * (1 + it)) bad = bad sprintf(" Krylov/求解 %s→%s", b[5], $5)
+        split("u v p", name, " ")
+        for (f = 6; f <= 8; f++)
+            if ($f > b[f] * (1 + rt)) bad = bad sprintf(" 残差%s %.3e→%.3e", name[f - 5], b[f], $f)
+        if (bad != "") { printf "  %-16s 回归:%s\n", key, bad; fail++ }
+        else printf "  %-16s OK（耗时 %+.1f%%）\n", key, 100 * ($4 / b[4] - 1)
+    }
+    END {
+        if (fail) { printf "\n%d 项性能回归\n", fail; exit 1 }
+        print "\n性能检查通过"
+    }
+' "$BASELINE" "$RESULT"
@@ -0,0 +1,116 @@
+#!/usr/bin/env bash
+# ==========================================================
+# 强 / 弱扩展性测试驱动（单机 mpirun 超额订阅即可运行）
+# ==========================================================
+#
+# 在内存生成的顶盖方腔网格（cavity:<nx>x<ny>）上，以 1..N 个本地 MPI 进程
+# 运行固定次数的 SIMPLE 迭代，解析求解器输出的 PERF 行，生成 CSV：
+#
+#   mode,solver,ranks,nx,ny,cells,cells_per_rank,iters,time_per_iter,
+#   comm_fraction,krylov_iters,speedup,efficiency
+#
+# - strong：全局网格固定为 SIZE×SIZE
+#           speedup = T(1)/T(p)，efficiency = speedup / p
+# - weak  ：每进程固定 SIZE×SIZE（沿 x 方向扩展，与域分解方向一致）
+#           efficiency = T(1)/T(p)，speedup = p · efficiency
+#
+# 用法:
+#   scripts/scaling.sh [-s steady|unsteady] [-m strong|weak|both]
+#                      [-n 最大进程数] [-g SIZE] [-i 迭代次数] [-o out.csv]
+#
+# 环境变量:
+#   MPIRUN   mpirun 命令（默认 "mpirun --oversubscribe"）
+#   BIN_DIR  求解器所在目录（默认为仓库根目录）
+# ==========================================================
+
+set -euo pipefail
+
+SOLVER="steady"
+MODE="both"
+MAX_RANKS="$(nproc)"
+SIZE=128
+ITERS=20
+OUT=""
+MU=0.01
+DT=0.01
+
+while getopts "s:m:n:g:i:o:h" opt; do
+    case "$opt" in
+        s) SOLVER="$OPTARG" ;;
+        m) MODE="$OPTARG" ;;
+        n) MAX_RANKS="$OPTARG" ;;
+        g) SIZE="$OPTARG" ;;
+        i) ITERS="$OPTARG" ;;
+        o) OUT="$OPTARG" ;;
+        *) sed -n '2,27p' "$0"; exit 0 ;;
+    esac
+done
+
+ROOT_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BIN_DIR="${BIN_DIR:-$ROOT_DIR}"
+MPIRUN="${MPIRUN:-mpirun --oversubscribe}"
+BIN="$BIN_DIR/solver_simple_$SOLVER"
+
+if [[ ! -x "$BIN" ]]; then
+    echo "找不到可执行文件 $BIN，请先 make" >&2
+    exit 1
+fi
+
+# 运行一次，输出 PERF 行的字段：ranks,cells,iters,time_per_iter,comm_fraction,krylov_iters,...
+run_case() {
+    local np="$1" nx="$2" ny="$3"
+    local mesh="cavity:${nx}x${ny}"
+    local args
+    if [[ "$SOLVER" == "steady" ]]; then
+        args=("$mesh" "$ITERS" "$MU")
+    else
+        # timesteps=0 → 只推进一个时间步，SIMPLE 次数由 --simple-iters 固定
+        args=("$mesh" "$DT" 0 "$MU" "--simple-iters=$ITERS")
+    fi
+    # 在临时目录运行，避免污染工作区
+    local tmp
+    tmp="$(mktemp -d)"
+    (cd "$tmp" && $MPIRUN -np "$np" "$BIN" "${args[@]}" \
+        --fixed-iters --no-output --quiet --perf) | grep '^PERF,' | cut -d, -f3-
+    rm -rf "$tmp"
+}
+
+emit() { if [[ -n "$OUT" ]]; then echo "$1" >> "$OUT"; else echo "$1"; fi; }
+
+[[ -n "$OUT" ]] && : > "$OUT"
+emit "mode,solver,ranks,nx,ny,cells,cells_per_rank,iters,time_per_iter,comm_fraction,krylov_iters,speedup,efficiency"
+
+run_mode() {
+    local mode="$1" t1=""
+    for ((np = 1; np <= MAX_RANKS; np++)); do
+        local nx ny
+        if [[ "$mode" == "strong" ]]; then nx="$SIZE"; else nx=$((SIZE * np)); fi
+        ny="$SIZE"
+
+        local line
+        line="$(run_case "$np" "$nx" "$ny")"
+        if [[ -z "$line" ]]; then
+            echo "[$mode] np=$np 运行失败（无 PERF 输出）" >&2
+            continue
+        fi
+        IFS=, read -r ranks cells iters tpi comm kry _ <<< "$line"
+        [[ -z "$t1" ]] && t1="$tpi"
+
+        local speedup eff
+        if [[ "$mode" == "strong" ]]; then
+            speedup="$(awk -v a="$t1" -v b="$tpi" 'BEGIN{printf "%.4f", a/b}')"
+            eff="$(awk -v s="$speedup" -v p="$np" 'BEGIN{printf "%.4f", s/p}')"
+        else
+            eff="$(awk -v a="$t1" -v b="$tpi" 'BEGIN{printf "%.4f", a/b}')"
+            speedup="$(awk -v e="$eff" -v p="$np" 'BEGIN{printf "%.4f", e*p}')"
+        fi
+        emit "$mode,$SOLVER,$ranks,$nx,$ny,$cells,$((cells / np)),$iters,$tpi,$comm,$kry,$speedup,$eff"
+    done
+}
+
+case "$MODE" in
+    strong) run_mode strong ;;
+    weak)   run_mode weak ;;
+    both)   run_mode strong; run_mode weak ;;
+    *)      echo "未知模式: $MODE" >&2; exit 1 ;;
+esac
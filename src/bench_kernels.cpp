@@ -0,0 +1,261 @@
+/**
+ * @file    bench_kernels.cpp
+ * @brief   核心计算内核微基准测试（合成网格，无需磁盘网格文件）
+ *
+ * @details
+ * 在内存中生成不同尺寸的顶盖驱动方腔网格（makeCavityMesh），先做少量
+ * SIMPLE 预热迭代使场变量非平凡，然后分别计时以下内核：
+ *
+ * | 内核                  | 说明                                   |
+ * |-----------------------|----------------------------------------|
+ * | momentum_function     | 动量方程离散（含 2 次 build_matrix）   |
+ * | face_velocity         | Rhie-Chow 面速度插值                   |
+ * | pressure_function     | 压力修正方程离散（含 build_matrix）    |
+ * | correct_velocity      | 速度/面速度修正                        |
+ * | build_matrix          | 五点系数 → Eigen 稀疏矩阵              |
+ * | SpMV                  | y = A·x（压力修正矩阵）                |
+ * | SpMV <order> bw=..    | row / col / rcm / tiled 编号下的 SpMV  |
+ * | SpMV (float)          | 单精度 y = A·x                         |
+ * | PCG_parallel          | 压力修正方程完整求解                   |
+ * | PCG_parallel_mixed    | 混合精度迭代精化求解                   |
+ *
+ * 合成网格为均匀网格，离散内核走 UniformGeometry 快速路径；
+ * "(general geom)" 行为同一内核强制走一般几何路径的对照。
+ *
+ * 输出指标：
+ * - Mcell/s ：每秒处理的网格单元数（PCG 为 单元×迭代 / 秒）
+ * - GB/s    ：有效带宽 = 必需数据量 / 耗时，数据量按每个数组读写一次估算
+ *             （见 parallel.h 中的 bytes_* 常量），可用于与 STREAM 带宽对比
+ * - iters   ：PCG 迭代次数
+ *
+ * 用法：
+ * @code
+ *   ./bench_kernels                 # 默认尺寸 64 128 256 512 1024
+ *   ./bench_kernels 256 4096        # 指定尺寸（nx = ny = N）
+ * @endcode
+ *
+ * @note 单进程运行即可（MPI 通信退化为 MPI_PROC_NULL），4096² 约需 5 GB 内存
+ */
+
+#include "fluid.h"
+#include <chrono>
+#include "parallel.h"
+
+using Clock = std::chrono::steady_clock;
+
+// 每单元必需数据量估算（bytes_* 常量）见 parallel.h 的内核计数器部分
+
+/**
+ * @brief 重复调用 f 直到累计耗时不少于 min_time 秒，返回单次平均耗时
+ */
+template <class F>
+double timeKernel(F&& f, double min_time = 0.2, int min_reps = 3)
+{
+    f();  // 预热（缓存、页分配）
+    int reps = 0;
+    double elapsed = 0.0;
+    auto t0 = Clock::now();
+    do {
+        f();
+        reps++;
+        elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    } while (elapsed < min_time || reps < min_reps);
+    return elapsed / reps;
+}
+
+static void printRow(const std::string& name, double sec, double cells,
+                     double bytes, int iters = -1)
+{
+    std::cout << "  " << std::left << std::setw(20) << name << std::right
+              << std::fixed << std::setprecision(3)
+              << std::setw(12) << sec * 1e3
+              << std::setw(12) << cells / sec / 1e6
+              << std::setw(10) << bytes / sec / 1e9;
+    if (iters >= 0) std::cout << std::setw(8) << iters;
+    else            std::cout << std::setw(8) << "-";
+    std::cout << std::endl;
+}
+
+/**
+ * @brief 在单个网格尺寸上运行全部内核基准
+ */
+static void benchSize(int N, int rank, int num_procs, MPI_Comm comm)
+{
+    Mesh mesh = makeCavityMesh(N, N);
+    Equation equ_u(mesh);
+    Equation equ_v(mesh);
+    Equation equ_p(mesh);
+
+    const double mu = 0.01, alpha_uv = 0.5, alpha_p = 0.3;
+    const double tol = 1e-5;
+    double l2_x, l2_y, l2_p;
+
+    // ===== 预热：几步 SIMPLE，使面速度 / 压力非零 =====
+    for (int n = 0; n < 3; ++n) {
+        momentum_function(mesh, equ_u, equ_v, mu, alpha_uv);
+        solveFieldPCG(equ_u, mesh, mesh.u, tol, 10, rank, num_procs, comm, l2_x, 0);
+        solveFieldPCG(equ_v, mesh, mesh.v, tol, 10, rank, num_procs, comm, l2_y, 0);
+        face_velocity(mesh, equ_u);
+        pressure_function(mesh, equ_p, equ_u);
+        solveFieldPCG(equ_p, mesh, mesh.p_prime, tol, 50, rank, num_procs, comm, l2_p, 0);
+        correct_pressure(mesh, alpha_p);
+        correct_velocity(mesh, equ_u);
+        mesh.p = mesh.p_star;
+    }
+
+    const double cells = static_cast<double>(mesh.nx) * mesh.ny;
+    const double n_int = mesh.internumber;
+
+    std::cout << "\n---- " << N << " × " << N << "  (内部点 " << mesh.internumber
+              << ") ----" << std::endl;
+    std::cout << "  " << std::left << std::setw(20) << "kernel" << std::right
+              << std::setw(12) << "ms/call" << std::setw(12) << "Mcell/s"
+              << std::setw(10) << "GB/s" << std::setw(8) << "iters" << std::endl;
+
+    // ── 动量方程离散 ─────────────────────────────────────────────
+    double t = timeKernel([&] { momentum_function(mesh, equ_u, equ_v, mu, alpha_uv); });
+    printRow("momentum_function", t, cells, cells * bytes_momentum);
+
+    // 同一网格强制走一般几何路径（逐单元读取 area_* / vol / x_c / y_c）作对比
+    const bool uniform = mesh.uniform;
+    if (uniform) {
+        mesh.uniform = false;
+        t = timeKernel([&] { momentum_function(mesh, equ_u, equ_v, mu, alpha_uv); });
+        printRow("  (general geom)", t, cells, cells * bytes_momentum);
+        mesh.uniform = true;
+    }
+
+    // momentum_function 会将 u/v 清零，重新求解以恢复非平凡速度场
+    solveFieldPCG(equ_u, mesh, mesh.u, tol, 10, rank, num_procs, comm, l2_x, 0);
+    solveFieldPCG(equ_v, mesh, mesh.v, tol, 10, rank, num_procs, comm, l2_y, 0);
+
+    // ── 面速度插值 ───────────────────────────────────────────────
+    t = timeKernel([&] { face_velocity(mesh, equ_u); });
+    printRow("face_velocity", t, cells, cells * bytes_face_vel);
+    if (uniform) {
+        mesh.uniform = false;
+        t = timeKernel([&] { face_velocity(mesh, equ_u); });
+        printRow("  (general geom)", t, cells, cells * bytes_face_vel);
+        mesh.uniform = true;
+    }
+
+    // ── 压力修正方程离散 ─────────────────────────────────────────
+    t = timeKernel([&] { pressure_function(mesh, equ_p, equ_u); });
+    printRow("pressure_function", t, cells, cells * bytes_pressure);
+    if (uniform) {
+        mesh.uniform = false;
+        t = timeKernel([&] { pressure_function(mesh, equ_p, equ_u); });
+        printRow("  (general geom)", t, cells, cells * bytes_pressure);
+        mesh.uniform = true;
+    }
+
+    // ── 稀疏矩阵组装 ─────────────────────────────────────────────
+    t = timeKernel([&] { equ_p.build_matrix(); });
+    printRow("build_matrix", t, cells, cells * bytes_build_matrix);
+
+    // ── SpMV ─────────────────────────────────────────────────────
+    VectorXd xv = VectorXd::Random(mesh.internumber);
+    VectorXd yv(mesh.internumber);
+    const double nnz = equ_p.A.nonZeros();
+    const double bytes_spmv = nnz * 12.0 + (n_int + 1) * 4.0 + 2 * n_int * 8.0;
+    t = timeKernel([&] { yv.noalias() = equ_p.A * xv; });
+    printRow("SpMV", t, n_int, bytes_spmv);
+
+    // ── 不同内部点编号策略下的 SpMV（bw = 矩阵半带宽）────────────
+    const std::pair<CellOrdering, const char*> orderings[] = {
+        {ORDER_ROW, "row"}, {ORDER_COL, "col"}, {ORDER_RCM, "rcm"}, {ORDER_TILED, "tiled"}};
+    for (const auto& ord : orderings) {
+        mesh.ordering = ord.first;
+        mesh.createInterId();
+        pressure_function(mesh, equ_p, equ_u);
+
+        int bw = 0;
+        for (int k = 0; k < equ_p.A.outerSize(); ++k)
+            for (SparseMatrix<double>::InnerIterator it(equ_p.A, k); it; ++it)
+                bw = std::max(bw, std::abs(static_cast<int>(it.row() - it.col())));
+
+        t = timeKernel([&] { yv.noalias() = equ_p.A * xv; });
+        printRow(std::string("SpMV ") + ord.second + " bw=" + std::to_string(bw),
+                 t, n_int, bytes_spmv);
+    }
+    mesh.ordering = ORDER_ROW;
+    mesh.createInterId();
+    pressure_function(mesh, equ_p, equ_u);
+
+    // ── 单精度 SpMV（混合精度内层使用）──────────────────────────
+    const SparseMatrix<float> A_f = equ_p.A.cast<float>();
+    VectorXf xf = xv.cast<float>();
+    VectorXf yf(mesh.internumber);
+    const double bytes_spmv_f = nnz * 8.0 + (n_int + 1) * 4.0 + 2 * n_int * 4.0;
+    t = timeKernel([&] { yf.noalias() = A_f * xf; });
+    printRow("SpMV (float)", t, n_int, bytes_spmv_f);
+
+    // ── PCG 完整求解 ─────────────────────────────────────────────
+    // 每次迭代：SpMV + 约 10 个长度 n 的向量读写 + 4 次整场扫描（场↔向量转换）
+    int iters = 0;
+    t = timeKernel([&] {
+        VectorXd x = VectorXd::Zero(mesh.internumber);
+        double r;
+        PCG_parallel(equ_p, mesh, equ_p.source, x, tol, 200, rank, num_procs, comm, r, 0);
+        iters = solver_stats.iterations;
+    });
+    const double bytes_iter = bytes_spmv + 10 * n_int * 8.0 + 4 * cells * (4 + 4 + 8);
+    const int it = std::max(iters, 1);
+    printRow("PCG_parallel", t, n_int * it, bytes_iter * it, iters);
+
+    // ── 混合精度 PCG（float 内层 + double 残差修正）────────────────
+    // 每次内层迭代：float SpMV + 约 10 个 float 向量读写（无整场扫描）
+    t = timeKernel([&] {
+        VectorXd x = VectorXd::Zero(mesh.internumber);
+        double r;
+        PCG_parallel_mixed(equ_p, mesh, equ_p.source, x, tol, 200, rank, num_procs, comm, r, 0);
+        iters = solver_stats.iterations;
+    });
+    const double bytes_iter_f = bytes_spmv_f + 10 * n_int * 4.0;
+    const int it_f = std::max(iters, 1);
+    printRow("PCG_parallel_mixed", t, n_int * it_f, bytes_iter_f * it_f, iters);
+
+    // ── 速度修正（放在最后：重复调用会累加修改面速度） ─────────────
+    t = timeKernel([&] { correct_velocity(mesh, equ_u); });
+    printRow("correct_velocity", t, cells, cells * bytes_correct_vel);
+}
+
+// ==================== 主函数 ====================
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+
+    int rank, num_procs;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
+
+    if (num_procs != 1) {
+        if (rank == 0)
+            std::cerr << "bench_kernels 仅支持单进程运行" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    std::vector<int> sizes;
+    for (int k = 1; k < argc; ++k) sizes.push_back(std::stoi(argv[k]));
+    if (sizes.empty()) sizes = {64, 128, 256, 512, 1024};
+
+    std::cout << "==================== 内核微基准测试 ====================" << std::endl;
+    std::cout << "网格尺寸: ";
+    for (int N : sizes) std::cout << N << "² ";
+    std::cout << "\n有效带宽按每数组读写一次估算（见 parallel.h 中的 bytes_* 常量）" << std::endl;
+
+    for (int N : sizes) {
+        if (N < 8) {
+            std::cerr << "跳过过小的网格尺寸: " << N << std::endl;
+            continue;
+        }
+        benchSize(N, rank, num_procs, comm);
+    }
+
+    std::cout << "\n=========================================================" << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
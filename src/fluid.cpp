@@ -119,6 +119,184 @@ void Mesh::createInterId() {
             }
         }
     }
+
+    // 非默认编号策略：先按行优先收集，再重排
+    if(ordering == ORDER_COL) {
+        // 列优先：与 Eigen ColMajor 场存储的内存顺序一致
+        interi.clear();
+        interj.clear();
+        for(int j = 0; j < bctype.cols(); j++)
+            for(int i = 0; i < bctype.rows(); i++)
+                if(bctype(i,j) == 0) { interi.push_back(i); interj.push_back(j); }
+    }
+    else if(ordering == ORDER_TILED) {
+        // 分块：order_tile×order_tile 小块按行优先排列，块内按列优先
+        const int T = std::max(1, order_tile);
+        interi.clear();
+        interj.clear();
+        for(int bi = 0; bi < bctype.rows(); bi += T)
+            for(int bj = 0; bj < bctype.cols(); bj += T)
+                for(int j = bj; j < std::min(bj + T, (int)bctype.cols()); j++)
+                    for(int i = bi; i < std::min(bi + T, (int)bctype.rows()); i++)
+                        if(bctype(i,j) == 0) { interi.push_back(i); interj.push_back(j); }
+    }
+    else if(ordering == ORDER_RCM) {
+        reorderRCM();
+    }
+    for(int k = 0; k < internumber; k++) interid(interi[k], interj[k]) = k;
+
+    buildActiveTopology();
+}
+
+void Mesh::reorderRCM() {
+    // 行优先编号下的五点邻接关系（interid 此时为行优先编号）
+    const int n = internumber;
+    const int di[4] = { 0,  0, -1, 1 };
+    const int dj[4] = { 1, -1,  0, 0 };
+    auto for_each_nb = [&](int k, auto&& f) {
+        for(int d = 0; d < 4; d++) {
+            const int i = interi[k] + di[d];
+            const int j = interj[k] + dj[d];
+            if(bctype(i,j) == 0) f(interid(i,j));
+        }
+    };
+    vector<int> degree(n, 0);
+    for(int k = 0; k < n; k++) for_each_nb(k, [&](int) { degree[k]++; });
+
+    vector<int> order;
+    order.reserve(n);
+    vector<char> visited(n, 0);
+    vector<int> level(n, -1);
+
+    // 从 start 出发做 BFS，返回最后一层中度数最小的点（伪外围点搜索用）
+    auto bfs_last = [&](int start) {
+        vector<int> queue(1, start);
+        std::fill(level.begin(), level.end(), -1);
+        level[start] = 0;
+        for(size_t q = 0; q < queue.size(); q++)
+            for_each_nb(queue[q], [&](int m) {
+                if(level[m] < 0) { level[m] = level[queue[q]] + 1; queue.push_back(m); }
+            });
+        int best = queue.back();
+        for(int m : queue)
+            if(level[m] == level[queue.back()] && degree[m] < degree[best]) best = m;
+        return best;
+    };
+
+    for(int seed = 0; seed < n; seed++) {
+        if(visited[seed]) continue;
+        // 每个连通分量：两次 BFS 近似伪外围点作为起点
+        int start = bfs_last(bfs_last(seed));
+
+        size_t head = order.size();
+        order.push_back(start);
+        visited[start] = 1;
+        vector<int> nbs;
+        while(head < order.size()) {
+            const int k = order[head++];
+            nbs.clear();
+            for_each_nb(k, [&](int m) { if(!visited[m]) { visited[m] = 1; nbs.push_back(m); } });
+            std::sort(nbs.begin(), nbs.end(),
+                      [&](int a, int b) { return degree[a] < degree[b]; });
+            order.insert(order.end(), nbs.begin(), nbs.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+
+    vector<int> new_i(n), new_j(n);
+    for(int k = 0; k < n; k++) {
+        new_i[k] = interi[order[k]];
+        new_j[k] = interj[order[k]];
+    }
+    interi.swap(new_i);
+    interj.swap(new_j);
+}
+
+CellOrdering parseCellOrdering(const std::string& name)
+{
+    if(name == "row")   return ORDER_ROW;
+    if(name == "col")   return ORDER_COL;
+    if(name == "rcm")   return ORDER_RCM;
+    if(name == "tiled") return ORDER_TILED;
+    throw std::runtime_error("未知的编号策略: " + name + "（可选 row / col / rcm / tiled）");
+}
+
+void Mesh::buildActiveTopology() {
+    nb_e.assign(internumber, -1);
+    nb_w.assign(internumber, -1);
+    nb_n.assign(internumber, -1);
+    nb_s.assign(internumber, -1);
+    bfaces.clear();
+
+    // 活动单元不会位于矩形最外圈（四周总有边界层或 ghost 层），邻居访问不越界
+    const int di[4] = { 0,  0, -1, 1 };   // E, W, N, S
+    const int dj[4] = { 1, -1,  0, 0 };
+    vector<int>* nb[4] = { &nb_e, &nb_w, &nb_n, &nb_s };
+
+    for(int k = 0; k < internumber; k++) {
+        for(int d = 0; d < 4; d++) {
+            const int i = interi[k] + di[d];
+            const int j = interj[k] + dj[d];
+            if(bctype(i,j) == 0) {
+                (*nb[d])[k] = interid(i,j);
+            } else {
+                bfaces.push_back({k, static_cast<FaceDir>(d), i, j, bctype(i,j)});
+            }
+        }
+    }
+}
+
+void Mesh::useCompactLayout() {
+    if (compact) return;
+
+    // ── 存储下标：活动单元取内部编号，边界环（与活动单元共面或为 ghost）按行优先追加 ──
+    cellid = MatrixXi::Constant(ny, nx, -1);
+    for (int k = 0; k < internumber; k++) cellid(interi[k], interj[k]) = k;
+
+    auto touches_active = [&](int i, int j) {
+        return (j + 1 < nx && bctype(i, j+1) == 0) || (j > 0      && bctype(i, j-1) == 0) ||
+               (i > 0      && bctype(i-1, j) == 0) || (i + 1 < ny && bctype(i+1, j) == 0);
+    };
+    ringi.clear();
+    ringj.clear();
+    for (int i = 0; i < ny; i++) {
+        for (int j = 0; j < nx; j++) {
+            if (bctype(i, j) == 0) continue;
+            if (bctype(i, j) == -3 || touches_active(i, j)) {
+                cellid(i, j) = internumber + static_cast<int>(ringi.size());
+                ringi.push_back(i);
+                ringj.push_back(j);
+            }
+        }
+    }
+    nstored = internumber + static_cast<int>(ringi.size());
+
+    // ── 两侧单元均存储的东面 / 南面（内核只读写这些面） ──────────────────
+    xface_i.clear(); xface_j.clear();
+    yface_i.clear(); yface_j.clear();
+    for (int i = 0; i < ny; i++)
+        for (int j = 0; j < nx - 1; j++)
+            if (cellid(i, j) >= 0 && cellid(i, j+1) >= 0) { xface_i.push_back(i); xface_j.push_back(j); }
+    for (int i = 0; i < ny - 1; i++)
+        for (int j = 0; j < nx; j++)
+            if (cellid(i, j) >= 0 && cellid(i+1, j) >= 0) { yface_i.push_back(i); yface_j.push_back(j); }
+
+    // ── 按存储下标收集场值（面场取西 / 北侧单元处的面） ──────────────────
+    auto gather = [&](MatrixXd& f) {
+        VectorXd c = VectorXd::Zero(nstored);
+        for (int s = 0; s < nstored; s++) {
+            const int i = (s < internumber) ? interi[s] : ringi[s - internumber];
+            const int j = (s < internumber) ? interj[s] : ringj[s - internumber];
+            if (i < f.rows() && j < f.cols()) c[s] = f(i, j);
+        }
+        f = c;
+    };
+    for (MatrixXd* f : { &u, &u0, &u_star, &v, &v0, &v_star, &x_c, &y_c,
+                         &area_e, &area_w, &area_s, &area_n, &vol,
+                         &p, &p_star, &p_prime, &u_face, &v_face })
+        gather(*f);
+
+    compact = true;
 }
 void Mesh::setBlock(int x1, int y1, int x2, int y2, double bcValue, double zoneValue) {
     // 确保坐标范围合法
@@ -401,15 +579,34 @@ void Mesh::initGeometry() {
         }
     }
 
+    detectUniform();
+}
+
+void Mesh::detectUniform() {
+    uniform = false;
+    dx = x(0, 1) - x(0, 0);
+    dy = y(1, 0) - y(0, 0);
+    if (dx == 0.0 || dy == 0.0) return;
+
+    const double tol_x = 1e-10 * std::abs(dx);
+    const double tol_y = 1e-10 * std::abs(dy);
+    for (int i = 0; i <= ny; ++i) {
+        for (int j = 0; j <= nx; ++j) {
+            // 坐标轴对齐：x 只随列变化，y 只随行变化；且间距处处相等
+            if (std::abs(x(i, j) - (x(0, 0) + j * dx)) > tol_x * (j + 1)) return;
+            if (std::abs(y(i, j) - (y(0, 0) + i * dy)) > tol_y * (i + 1)) return;
+        }
+    }
+    uniform = true;
 }
 
 // Equation 类的构造函数
 Equation::Equation(Mesh& mesh_)
-    : A_p(mesh_.ny , mesh_.nx ),
-      A_e(mesh_.ny , mesh_.nx ),
-      A_w(mesh_.ny , mesh_.nx ),
-      A_n(mesh_.ny , mesh_.nx ),
-      A_s(mesh_.ny , mesh_.nx ),
+    : A_p(mesh_.fieldRows(), mesh_.fieldCols()),
+      A_e(mesh_.fieldRows(), mesh_.fieldCols()),
+      A_w(mesh_.fieldRows(), mesh_.fieldCols()),
+      A_n(mesh_.fieldRows(), mesh_.fieldCols()),
+      A_s(mesh_.fieldRows(), mesh_.fieldCols()),
       source(mesh_.internumber),
       A(mesh_.internumber, mesh_.internumber),
       n_x(mesh_.nx), 
@@ -427,44 +624,24 @@ void Equation::initializeToZero() {
     A.setZero();
 }
 void Equation::build_matrix() {
+    if (!assemble_sparse) return;
+
     typedef Eigen::Triplet<double> T;
     std::vector<T> tripletList;
+    tripletList.reserve(5 * mesh.internumber);
 
-    // 遍历所有网格点
-    for(int i = 0; i <n_y ; i++) {
-        for(int j = 0; j < n_x; j++) {
-            // 只处理内部点（bctype为0的点）
-            if(mesh.bctype(i,j) == 0) {
-                int current_id = mesh.interid(i,j) ;  // 当前点在方程组中的编号
-                
-                // 添加中心点系数
-                tripletList.emplace_back(current_id, current_id, A_p(i,j));
-                
-                // 检查东邻接单元
-                if(mesh.bctype(i,j+1) == 0) {
-                    int east_id = mesh.interid(i,j+1) ;
-                    tripletList.emplace_back(current_id, east_id, -A_e(i,j));
-                }
-                
-                // 检查西邻接单元
-                if(mesh.bctype(i,j-1) == 0) {
-                    int west_id = mesh.interid(i,j-1) ;
-                    tripletList.emplace_back(current_id, west_id, -A_w(i,j));
-                }
-                
-                // 检查北邻接单元
-                if(mesh.bctype(i-1,j) == 0) {
-                    int north_id = mesh.interid(i-1,j) ;
-                    tripletList.emplace_back(current_id, north_id, -A_n(i,j));
-                }
-                
-                // 检查南邻接单元
-                if(mesh.bctype(i+1,j) == 0) {
-                    int south_id = mesh.interid(i+1,j) ;
-                    tripletList.emplace_back(current_id, south_id, -A_s(i,j));
-                }
-            }
-        }
+    // 只遍历活动单元，邻居编号取自 createInterId 建立的 nb_* 数组
+    for(int k = 0; k < mesh.internumber; k++) {
+        const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+
+        // 添加中心点系数
+        tripletList.emplace_back(k, k, A_p(c));
+
+        // 东 / 西 / 北 / 南邻接单元（-1 表示非内部点）
+        if(mesh.nb_e[k] >= 0) tripletList.emplace_back(k, mesh.nb_e[k], -A_e(c));
+        if(mesh.nb_w[k] >= 0) tripletList.emplace_back(k, mesh.nb_w[k], -A_w(c));
+        if(mesh.nb_n[k] >= 0) tripletList.emplace_back(k, mesh.nb_n[k], -A_n(c));
+        if(mesh.nb_s[k] >= 0) tripletList.emplace_back(k, mesh.nb_s[k], -A_s(c));
     }
     
     // 设置稀疏矩阵大小为内部点数量
@@ -475,14 +652,12 @@ void solve(Equation& equation, double epsilon, double& l2_norm, MatrixXd& phi){
     // 创建解向量，长度为内部点数量
     VectorXd x(equation.mesh.internumber);
 
-    // 根据 interid 构建初始解向量，遍历整个网格
-    for(int i = 0; i < equation.n_y ; i++) {
-        for(int j = 0; j < equation.n_x ; j++) {
-            if(equation.mesh.bctype(i,j) == 0) {
-                int n = equation.mesh.interid(i,j) ;
-                x[n] = phi(i,j);
-            }
-        }
+    // 根据 interid 构建初始解向量，仅遍历活动单元
+    for(int k = 0; k < equation.mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = equation.mesh.interi[k];
+        const int j = equation.mesh.interj[k];
+        int n = equation.mesh.interid(i,j) ;
+        x[n] = phi(equation.mesh.cell(i,j));
     }
 
     // 计算残差
@@ -496,216 +671,229 @@ void solve(Equation& equation, double epsilon, double& l2_norm, MatrixXd& phi){
     solver.setMaxIterations(1);     // 设置最大迭代次数
     x = solver.solve(equation.source);
 
-    // 将结果写回网格，同样遍历整个网格
-    for(int i = 0; i < equation.n_y ; i++) {
-        for(int j = 0; j < equation.n_x ; j++) {
-            if(equation.mesh.bctype(i,j) == 0) {
-                int n = equation.mesh.interid(i,j) ;
-                phi(i,j) = x[n];
-            }
-        }
+    // 将结果写回网格，同样仅遍历活动单元
+    for(int k = 0; k < equation.mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = equation.mesh.interi[k];
+        const int j = equation.mesh.interj[k];
+        int n = equation.mesh.interid(i,j) ;
+        phi(equation.mesh.cell(i,j)) = x[n];
     }
 }
 
-void face_velocity(Mesh& mesh, Equation& equ_u) {
-    MatrixXd& u_face = mesh.u_face;
-    MatrixXd& v_face = mesh.v_face;
+template <class Geo, class Layout>
+static void face_velocity_impl(Mesh& mesh, Equation& equ_u, const Geo& geo, const Layout& L) {
+    auto u_face = view<FIELD_XFACE>(L, mesh.u_face);
+    auto v_face = view<FIELD_YFACE>(L, mesh.v_face);
     MatrixXi& bctype = mesh.bctype;
-    MatrixXd& u = mesh.u;
-    MatrixXd& v = mesh.v;
-    MatrixXd& p = mesh.p;
-    MatrixXd& A_p = equ_u.A_p;
+    auto u = view<FIELD_CELL>(L, mesh.u);
+    auto v = view<FIELD_CELL>(L, mesh.v);
+    auto p = view<FIELD_CELL>(L, mesh.p);
+    auto A_p = view<FIELD_CELL>(L, equ_u.A_p);
     double dist_e,dist_ee,dist_w,dist_ss,dist_s,dist_n;
-    MatrixXd &x_c  = mesh.x_c;
-    MatrixXd &y_c  = mesh.y_c;
 
-    MatrixXd &vol    = mesh.vol;
 
 
-    for(int i = 0; i < mesh.ny ; i++) {
-        for(int j = 0; j < mesh.nx-1; j++) {
-            if ((bctype(i,j) == 0 && bctype(i,j+1) == 0) || 
-                (bctype(i,j) == 0 && bctype(i,j+1) == -3) ||
-                (bctype(i,j) == -3 && bctype(i,j+1) == 0)) {
+    L.forXFaces(mesh, [&](int i, int j) {
+        if ((bctype(i,j) == 0 && bctype(i,j+1) == 0) || 
+            (bctype(i,j) == 0 && bctype(i,j+1) == -3) ||
+            (bctype(i,j) == -3 && bctype(i,j+1) == 0)) {
 
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_ee = x_c(i, j+2) - x_c(i, j+1);   // 到东东侧cell中心距离
+            dist_e = geo.dist_e(i, j);   // 到东侧cell中心距离
+            dist_w = geo.dist_w(i, j); // 到西侧cell中心距离
+            dist_ee = geo.dist_e(i, j+1);   // 到东东侧cell中心距离
 
-                if (bctype(i,j+2) == -2) p(i,j+2) = p(i,j+1);
-                else if (bctype(i,j-1) == -2) p(i,j-1) = p(i,j);
-                else if (bctype(i,j+2) == -1) p(i,j+2) = 0;
-                else if (bctype(i,j-1) == -1) p(i,j-1) = 0;
-
-                u_face(i,j) = 0.5*(u(i,j) + u(i,j+1))
-                            + 0.5*(p(i,j+1) - p(i,j-1)) * vol(i,j) / (A_p(i,j)*(dist_e+dist_w))
-                            + 0.5*(p(i,j+2) - p(i,j)) * vol(i,j) / (A_p(i,j+1)*(dist_ee+dist_e))
-                            - 0.5*(1.0/A_p(i,j) + 1.0/A_p(i,j+1)) * (p(i,j+1) - p(i,j))  * vol(i,j)/dist_e;
-            }
-            else if (bctype(i,j) == 0 && bctype(i,j+1) == -1) {
-                u_face(i,j) = u(i,j);
-            }
-            else if (bctype(i,j) == -1 && bctype(i,j+1) == 0) {
-                u_face(i,j) = u(i,j+1);
-            }
-            else if (bctype(i,j) == 0 && bctype(i,j+1) == -2) {
-                u_face(i,j) = mesh.zoneu[mesh.zoneid(i,j+1)];
-            }
-            else if (bctype(i,j) == -2 && bctype(i,j+1) == 0) {
-                u_face(i,j) = mesh.zoneu[mesh.zoneid(i,j)];
-            }
-            else {
-                u_face(i,j) = 0.0;
-            }
+            if (bctype(i,j+2) == -2) p(i,j+2) = p(i,j+1);
+            else if (bctype(i,j-1) == -2) p(i,j-1) = p(i,j);
+            else if (bctype(i,j+2) == -1) p(i,j+2) = 0;
+            else if (bctype(i,j-1) == -1) p(i,j-1) = 0;
 
-            // NaN 检查
-            if (std::isnan(u_face(i,j))) u_face(i,j) = 0.0;
+            u_face(i,j) = 0.5*(u(i,j) + u(i,j+1))
+                        + 0.5*(p(i,j+1) - p(i,j-1)) * geo.vol(i,j) / (A_p(i,j)*(dist_e+dist_w))
+                        + 0.5*(p(i,j+2) - p(i,j)) * geo.vol(i,j) / (A_p(i,j+1)*(dist_ee+dist_e))
+                        - 0.5*(1.0/A_p(i,j) + 1.0/A_p(i,j+1)) * (p(i,j+1) - p(i,j))  * geo.vol(i,j)/dist_e;
+        }
+        else if (bctype(i,j) == 0 && bctype(i,j+1) == -1) {
+            u_face(i,j) = u(i,j);
+        }
+        else if (bctype(i,j) == -1 && bctype(i,j+1) == 0) {
+            u_face(i,j) = u(i,j+1);
+        }
+        else if (bctype(i,j) == 0 && bctype(i,j+1) == -2) {
+            u_face(i,j) = mesh.zoneu[mesh.zoneid(i,j+1)];
+        }
+        else if (bctype(i,j) == -2 && bctype(i,j+1) == 0) {
+            u_face(i,j) = mesh.zoneu[mesh.zoneid(i,j)];
+        }
+        else {
+            u_face(i,j) = 0.0;
         }
-    }
 
-    for(int i = 0; i < mesh.ny-1; i++) {
-        for(int j = 0; j < mesh.nx ; j++) {
-            if (bctype(i,j) == 0 && bctype(i+1,j) == 0) {
-                
-                dist_ss = y_c(i+2, j) - y_c(i+1, j);   // 到南侧cell中心距离
-                dist_s  = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n  = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-                if (bctype(i+2,j) == -2) p(i+2,j) = p(i+1,j);
-                else if (bctype(i-1,j) == -2) p(i-1,j) = p(i,j);
-                else if (bctype(i+2,j) == -1) p(i+2,j) = 0;
-                else if (bctype(i-1,j) == -1) p(i-1,j) = 0;
- 
-                v_face(i,j) = 0.5*(v(i+1,j) + v(i,j))
-                            + 0.5*(p(i,j) - p(i+2,j)) * vol(i,j) / (A_p(i+1,j)*(dist_ss+dist_s))
-                            + 0.5*(p(i-1,j) - p(i+1,j)) * vol(i,j) / (A_p(i,j)*(dist_n+dist_s))
-                            - 0.5*(1.0/A_p(i+1,j) + 1.0/A_p(i,j)) * (p(i,j) - p(i+1,j)) * vol(i,j)/dist_s;
-            }
-            else if (bctype(i,j) == 0 && bctype(i+1,j) == -2) {
-                v_face(i,j) = mesh.zonev[mesh.zoneid(i+1,j)];
-            }
-            else if (bctype(i,j) == -2 && bctype(i+1,j) == 0) {
-                v_face(i,j) = mesh.zonev[mesh.zoneid(i,j)];
-            }
-            else if (bctype(i,j) == 0 && bctype(i+1,j) == -1) {
-                v_face(i,j) = v(i,j);
-            }
-            else if (bctype(i,j) == -1 && bctype(i+1,j) == 0) {
-                v_face(i,j) = v(i+1,j);
-            }
-            else {
-                v_face(i,j) = 0.0;
-            }
+        // NaN 检查
+        if (std::isnan(u_face(i,j))) u_face(i,j) = 0.0;
+    });
 
-            // NaN 检查
-            if (std::isnan(v_face(i,j))) v_face(i,j) = 0.0;
+    L.forYFaces(mesh, [&](int i, int j) {
+        if (bctype(i,j) == 0 && bctype(i+1,j) == 0) {
+        
+            dist_ss = geo.dist_s(i+1, j);   // 到南侧cell中心距离
+            dist_s  = geo.dist_s(i, j);   // 到南侧cell中心距离
+            dist_n  = geo.dist_n(i, j); // 到北侧cell中心距离
+            if (bctype(i+2,j) == -2) p(i+2,j) = p(i+1,j);
+            else if (bctype(i-1,j) == -2) p(i-1,j) = p(i,j);
+            else if (bctype(i+2,j) == -1) p(i+2,j) = 0;
+            else if (bctype(i-1,j) == -1) p(i-1,j) = 0;
+ 
+            v_face(i,j) = 0.5*(v(i+1,j) + v(i,j))
+                        + 0.5*(p(i,j) - p(i+2,j)) * geo.vol(i,j) / (A_p(i+1,j)*(dist_ss+dist_s))
+                        + 0.5*(p(i-1,j) - p(i+1,j)) * geo.vol(i,j) / (A_p(i,j)*(dist_n+dist_s))
+                        - 0.5*(1.0/A_p(i+1,j) + 1.0/A_p(i,j)) * (p(i,j) - p(i+1,j)) * geo.vol(i,j)/dist_s;
+        }
+        else if (bctype(i,j) == 0 && bctype(i+1,j) == -2) {
+            v_face(i,j) = mesh.zonev[mesh.zoneid(i+1,j)];
+        }
+        else if (bctype(i,j) == -2 && bctype(i+1,j) == 0) {
+            v_face(i,j) = mesh.zonev[mesh.zoneid(i,j)];
+        }
+        else if (bctype(i,j) == 0 && bctype(i+1,j) == -1) {
+            v_face(i,j) = v(i,j);
+        }
+        else if (bctype(i,j) == -1 && bctype(i+1,j) == 0) {
+            v_face(i,j) = v(i+1,j);
+        }
+        else {
+            v_face(i,j) = 0.0;
         }
+
+        // NaN 检查
+        if (std::isnan(v_face(i,j))) v_face(i,j) = 0.0;
+    });
+}
+
+/**
+ * @brief 按 mesh.compact / mesh.uniform 选择布局与几何特化后调用 kernel(geo, layout)
+ */
+template <class Kernel>
+static void dispatchKernel(const Mesh& mesh, Kernel&& kernel)
+{
+    if (mesh.compact) {
+        const CompactLayout L(mesh);
+        if (mesh.uniform) kernel(UniformGeometry(mesh), L);
+        else              kernel(GeneralGeometry<CompactLayout>(mesh, L), L);
+    } else {
+        const RectLayout L(mesh);
+        if (mesh.uniform) kernel(UniformGeometry(mesh), L);
+        else              kernel(GeneralGeometry<RectLayout>(mesh, L), L);
     }
 }
 
+void face_velocity(Mesh& mesh, Equation& equ_u)
+{
+    dispatchKernel(mesh, [&](const auto& geo, const auto& L) { face_velocity_impl(mesh, equ_u, geo, L); });
+}
 
 
 
 
 
-void pressure_function(Mesh &mesh, Equation &equ_p, Equation &equ_u)
+
+template <class Geo, class Layout>
+static void pressure_function_impl(Mesh &mesh, Equation &equ_p, Equation &equ_u, const Geo& geo,
+                                   const Layout& L)
 {
     
-    MatrixXd &u_face = mesh.u_face;
-    MatrixXd &v_face = mesh.v_face;
+    auto u_face = view<FIELD_XFACE>(L, mesh.u_face);
+    auto v_face = view<FIELD_YFACE>(L, mesh.v_face);
     MatrixXi &bctype = mesh.bctype;
-    MatrixXd &A_p = equ_u.A_p;
-    MatrixXd &Ap_p = equ_p.A_p;
-    MatrixXd &Ap_e = equ_p.A_e;
-    MatrixXd &Ap_w = equ_p.A_w;
-    MatrixXd &Ap_n = equ_p.A_n;
-    MatrixXd &Ap_s = equ_p.A_s;
+    auto A_p  = view<FIELD_CELL>(L, equ_u.A_p);
+    auto Ap_p = view<FIELD_CELL>(L, equ_p.A_p);
+    auto Ap_e = view<FIELD_CELL>(L, equ_p.A_e);
+    auto Ap_w = view<FIELD_CELL>(L, equ_p.A_w);
+    auto Ap_n = view<FIELD_CELL>(L, equ_p.A_n);
+    auto Ap_s = view<FIELD_CELL>(L, equ_p.A_s);
     VectorXd &source_p = equ_p.source;
 
     double dist_e,dist_w,dist_s,dist_n;
-    MatrixXd &x_c  = mesh.x_c;
-    MatrixXd &y_c  = mesh.y_c;
-    MatrixXd &area_e = mesh.area_e;
-    MatrixXd &area_w = mesh.area_w;
-    MatrixXd &area_s = mesh.area_s;
-    MatrixXd &area_n = mesh.area_n;
-    MatrixXd &vol    = mesh.vol;
 
     equ_p.initializeToZero();
     mesh.p_prime.setZero();
     // 遍历网格点
-    for(int i = 0; i < equ_p.n_y; i++) {
-        for(int j = 0; j < equ_p.n_x; j++) {
-            if(bctype(i,j) == 0) {  // 内部点
-                int n = mesh.interid(i,j) ;
-                double Ap_temp = 0;
-                // 检查东面
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-                if(bctype(i,j+1) == 0) {
-                    Ap_e(i,j) = 0.5*(1/A_p(i,j) +1/A_p(i,j+1))*vol(i,j)*area_e(i,j)/dist_e;
-                    Ap_temp += Ap_e(i,j);
-                }  
-                else if (bctype(i,j+1) == -3)
-                {
-                    Ap_e(i,j) = 0.5*(1/A_p(i,j) +1/A_p(i,j+1))*vol(i,j)*area_e(i,j)/dist_e;
-                    Ap_temp += Ap_e(i,j);
-                }
-                
-              
-                else{
-                    Ap_e(i,j) = 0;
-                }
-
-                // 检查西面
-                if(bctype(i,j-1) == 0) {
-                    Ap_w(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i,j-1))*vol(i,j)*area_w(i,j)/dist_w;
-                    Ap_temp += Ap_w(i,j);
-                }
-                else if (bctype(i,j-1) == -3)
-                {
-                    Ap_w(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i,j-1))*vol(i,j)*area_w(i,j)/dist_w;
-                    Ap_temp += Ap_w(i,j);
-                }
-                
-                 else {
-                    Ap_w(i,j) = 0;
-                }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        int n = mesh.interid(i,j) ;
+        double Ap_temp = 0;
+        // 检查东面
+        dist_e = geo.dist_e(i, j);   // 到东侧cell中心距离
+        dist_w = geo.dist_w(i, j); // 到西侧cell中心距离
+        dist_s = geo.dist_s(i, j);   // 到南侧cell中心距离
+        dist_n = geo.dist_n(i, j); // 到北侧cell中心距离
+        if(bctype(i,j+1) == 0) {
+            Ap_e(i,j) = 0.5*(1/A_p(i,j) +1/A_p(i,j+1))*geo.vol(i,j)*geo.area_e(i,j)/dist_e;
+            Ap_temp += Ap_e(i,j);
+        }  
+        else if (bctype(i,j+1) == -3)
+        {
+            Ap_e(i,j) = 0.5*(1/A_p(i,j) +1/A_p(i,j+1))*geo.vol(i,j)*geo.area_e(i,j)/dist_e;
+            Ap_temp += Ap_e(i,j);
+        }
+        
+      
+        else{
+            Ap_e(i,j) = 0;
+        }
 
-                // 检查北面
-                if(bctype(i-1,j) == 0) {
-                    Ap_n(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i-1,j))*vol(i,j)*area_n(i,j)/dist_n;
-                    Ap_temp += Ap_n(i,j);
-                }
-               
-                 else {
-                    Ap_n(i,j) = 0;
-                }
+        // 检查西面
+        if(bctype(i,j-1) == 0) {
+            Ap_w(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i,j-1))*geo.vol(i,j)*geo.area_w(i,j)/dist_w;
+            Ap_temp += Ap_w(i,j);
+        }
+        else if (bctype(i,j-1) == -3)
+        {
+            Ap_w(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i,j-1))*geo.vol(i,j)*geo.area_w(i,j)/dist_w;
+            Ap_temp += Ap_w(i,j);
+        }
+        
+         else {
+            Ap_w(i,j) = 0;
+        }
 
-                // 检查南面
-                if(bctype(i+1,j) == 0) {
-                    Ap_s(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i+1,j))*vol(i,j)*area_s(i,j)/dist_s;
-                    Ap_temp += Ap_s(i,j);
-                } 
-                
-                else {
-                    Ap_s(i,j) = 0;
-                }
+        // 检查北面
+        if(bctype(i-1,j) == 0) {
+            Ap_n(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i-1,j))*geo.vol(i,j)*geo.area_n(i,j)/dist_n;
+            Ap_temp += Ap_n(i,j);
+        }
+       
+         else {
+            Ap_n(i,j) = 0;
+        }
 
-                // 设置中心系数和源项
-                Ap_p(i,j) = Ap_temp;
-                source_p[n]=0;
-                
-                source_p[n] +=   -(u_face(i,j)*area_e(i,j) - u_face(i,j-1)*area_w(i,j)) 
-                - (v_face(i-1,j)*area_n(i,j) - v_face(i,j)*area_s(i,j));         
-            }
+        // 检查南面
+        if(bctype(i+1,j) == 0) {
+            Ap_s(i,j) = 0.5*(1/A_p(i,j) + 1/A_p(i+1,j))*geo.vol(i,j)*geo.area_s(i,j)/dist_s;
+            Ap_temp += Ap_s(i,j);
+        } 
+        
+        else {
+            Ap_s(i,j) = 0;
         }
+
+        // 设置中心系数和源项
+        Ap_p(i,j) = Ap_temp;
+        source_p[n]=0;
+        
+        source_p[n] +=   -(u_face(i,j)*geo.area_e(i,j) - u_face(i,j-1)*geo.area_w(i,j)) 
+        - (v_face(i-1,j)*geo.area_n(i,j) - v_face(i,j)*geo.area_s(i,j));         
     }
     equ_p.build_matrix();
 }
 
 
+void pressure_function(Mesh &mesh, Equation &equ_p, Equation &equ_u)
+{
+    dispatchKernel(mesh, [&](const auto& geo, const auto& L) { pressure_function_impl(mesh, equ_p, equ_u, geo, L); });
+}
+
+
 void correct_pressure(Mesh &mesh,double alpha_p)
 {
     MatrixXd &p = mesh.p;
@@ -716,15 +904,19 @@ void correct_pressure(Mesh &mesh,double alpha_p)
     int n_y = mesh.ny;
 
  
-    for(int i = 0; i < n_y ; i++) {
-        for(int j = 0; j < n_x ; j++) {
-            if(bctype(i,j) > 0) {  // 边界点
-                
+    if(mesh.compact) {
+        // 紧凑布局：非活动单元只存储边界环
+        for(size_t r = 0; r < mesh.ringi.size(); r++)
+            if(bctype(mesh.ringi[r], mesh.ringj[r]) > 0) p_prime(mesh.internumber + r) = 0;
+    } else {
+        for(int i = 0; i < n_y ; i++) {
+            for(int j = 0; j < n_x ; j++) {
+                if(bctype(i,j) > 0) {  // 边界点
                     p_prime(i,j) = 0;
                 }
             }
         }
-    
+    }
 
     // 更新压力场
     
@@ -732,134 +924,128 @@ void correct_pressure(Mesh &mesh,double alpha_p)
 p_star =p + alpha_p *p_prime;
 }
 
-void correct_velocity(Mesh &mesh, Equation &equ_u)
+template <class Geo, class Layout>
+static void correct_velocity_impl(Mesh &mesh, Equation &equ_u, const Geo& geo, const Layout& L)
 {
-    MatrixXd &u = mesh.u;
-    MatrixXd &v = mesh.v;
-    MatrixXd &u_face = mesh.u_face;
-    MatrixXd &v_face = mesh.v_face;
-    MatrixXd &p_prime = mesh.p_prime;
-    MatrixXd &u_star = mesh.u_star;
-    MatrixXd &v_star = mesh.v_star;
+    auto u = view<FIELD_CELL>(L, mesh.u);
+    auto v = view<FIELD_CELL>(L, mesh.v);
+    auto u_face = view<FIELD_XFACE>(L, mesh.u_face);
+    auto v_face = view<FIELD_YFACE>(L, mesh.v_face);
+    auto p_prime = view<FIELD_CELL>(L, mesh.p_prime);
+    auto u_star = view<FIELD_CELL>(L, mesh.u_star);
+    auto v_star = view<FIELD_CELL>(L, mesh.v_star);
     MatrixXi &bctype = mesh.bctype;
-    MatrixXd &A_p = equ_u.A_p;
-    int n_x = mesh.nx;
-    int n_y = mesh.ny;
+    auto A_p = view<FIELD_CELL>(L, equ_u.A_p);
     double dist_e,dist_w,dist_s,dist_n;
-    MatrixXd &x_c  = mesh.x_c;
-    MatrixXd &y_c  = mesh.y_c;
 
-    MatrixXd &vol    = mesh.vol;
     
 
     // 修正 u_star
-    for (int i = 0; i < n_y; i++) {
-        for (int j = 0; j < n_x; j++) {
-            if (bctype(i,j) == 0) {
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-                double p_west, p_east;
-
-                // 西面
-                if (bctype(i,j-1) == 0 || bctype(i,j-1) == -3)
-                    p_west = p_prime(i,j-1);
-                else
-                    p_west = p_prime(i,j);
-
-                // 东面
-                if (bctype(i,j+1) == 0 || bctype(i,j+1) == -3)
-                    p_east = p_prime(i,j+1);
-                else
-                    p_east = p_prime(i,j);
-
-                u_star(i,j) = u(i,j) +  (p_west - p_east) * vol(i,j) / (A_p(i,j)*(dist_w+dist_e));
-            }
-        }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        dist_e = geo.dist_e(i, j);   // 到东侧cell中心距离
+        dist_w = geo.dist_w(i, j); // 到西侧cell中心距离
+        dist_s = geo.dist_s(i, j);   // 到南侧cell中心距离
+        dist_n = geo.dist_n(i, j); // 到北侧cell中心距离
+        double p_west, p_east;
+
+        // 西面
+        if (bctype(i,j-1) == 0 || bctype(i,j-1) == -3)
+            p_west = p_prime(i,j-1);
+        else
+            p_west = p_prime(i,j);
+
+        // 东面
+        if (bctype(i,j+1) == 0 || bctype(i,j+1) == -3)
+            p_east = p_prime(i,j+1);
+        else
+            p_east = p_prime(i,j);
+
+        u_star(i,j) = u(i,j) +  (p_west - p_east) * geo.vol(i,j) / (A_p(i,j)*(dist_w+dist_e));
     }
 
     // 修正 v_star
-    for (int i = 0; i < n_y; i++) {
-        for (int j = 0; j < n_x; j++) {
-            if (bctype(i,j) == 0) {
-
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-                double p_north, p_south;
-
-                // 北面
-                if (bctype(i-1,j) == 0 || bctype(i-1,j) == -3)
-                    p_north = p_prime(i-1,j);
-                else
-                    p_north = p_prime(i,j);
-
-                // 南面
-                if (bctype(i+1,j) == 0 || bctype(i+1,j) == -3)
-                    p_south = p_prime(i+1,j);
-                else
-                    p_south = p_prime(i,j);
-
-                v_star(i,j) = v(i,j) +  (p_south - p_north) * vol(i,j) / (A_p(i,j)*(dist_s+dist_n));
-            }
-        }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+
+        dist_e = geo.dist_e(i, j);   // 到东侧cell中心距离
+        dist_w = geo.dist_w(i, j); // 到西侧cell中心距离
+        dist_s = geo.dist_s(i, j);   // 到南侧cell中心距离
+        dist_n = geo.dist_n(i, j); // 到北侧cell中心距离
+        double p_north, p_south;
+
+        // 北面
+        if (bctype(i-1,j) == 0 || bctype(i-1,j) == -3)
+            p_north = p_prime(i-1,j);
+        else
+            p_north = p_prime(i,j);
+
+        // 南面
+        if (bctype(i+1,j) == 0 || bctype(i+1,j) == -3)
+            p_south = p_prime(i+1,j);
+        else
+            p_south = p_prime(i,j);
+
+        v_star(i,j) = v(i,j) +  (p_south - p_north) * geo.vol(i,j) / (A_p(i,j)*(dist_s+dist_n));
     }
 
     // 修正 u_face (互斥判断)
-    for (int i = 0; i < n_y; i++) {
-        for (int j = 0; j < n_x-1; j++) {
-            if ((bctype(i,j) == 0 && bctype(i,j+1) == 0) ||
-                (bctype(i,j) == 0 && bctype(i,j+1) == -3) ||
-                (bctype(i,j) == -3 && bctype(i,j+1) == 0)) {
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                // 情况1：内部或特殊内部 → 做压力修正
-                u_face(i,j) = u_face(i,j) + 
-                              (1/A_p(i,j) + 1/A_p(i,j+1)) * 
-                              (p_prime(i,j) - p_prime(i,j+1)) *vol(i,j) /(dist_e+dist_w);
-            }
-            else if (bctype(i,j) == 0 && bctype(i,j+1) == -1) {
-                // 情况2：内部-压力边界 → 用 u_star(i,j)
-                u_face(i,j) = u_star(i,j);
-            }
-            else if (bctype(i,j) == -1 && bctype(i,j+1) == 0) {
-                // 情况3：压力边界-内部 → 用 u_star(i,j+1)
-                u_face(i,j) = u_star(i,j+1);
-            }
-            else {
-                // 其它情况，保持不变或由边界条件处理
-            }
+    L.forXFaces(mesh, [&](int i, int j) {
+        if ((bctype(i,j) == 0 && bctype(i,j+1) == 0) ||
+            (bctype(i,j) == 0 && bctype(i,j+1) == -3) ||
+            (bctype(i,j) == -3 && bctype(i,j+1) == 0)) {
+            dist_e = geo.dist_e(i, j);   // 到东侧cell中心距离
+            dist_w = geo.dist_w(i, j); // 到西侧cell中心距离
+            // 情况1：内部或特殊内部 → 做压力修正
+            u_face(i,j) = u_face(i,j) + 
+                          (1/A_p(i,j) + 1/A_p(i,j+1)) * 
+                          (p_prime(i,j) - p_prime(i,j+1)) *geo.vol(i,j) /(dist_e+dist_w);
         }
-    }
+        else if (bctype(i,j) == 0 && bctype(i,j+1) == -1) {
+            // 情况2：内部-压力边界 → 用 u_star(i,j)
+            u_face(i,j) = u_star(i,j);
+        }
+        else if (bctype(i,j) == -1 && bctype(i,j+1) == 0) {
+            // 情况3：压力边界-内部 → 用 u_star(i,j+1)
+            u_face(i,j) = u_star(i,j+1);
+        }
+        else {
+            // 其它情况，保持不变或由边界条件处理
+        }
+    });
 
     // 修正 v_face (互斥判断)
-    for (int i = 0; i < n_y-1; i++) {
-        for (int j = 0; j < n_x; j++) {
-            if ((bctype(i,j) == 0 && bctype(i+1,j) == 0) ||
-                (bctype(i,j) == 0 && bctype(i+1,j) == -3) ||
-                (bctype(i,j) == -3 && bctype(i+1,j) == 0)) {
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-                // 情况1：内部或特殊内部 → 做压力修正
-                v_face(i,j) = v_face(i,j) + 
-                               (1/A_p(i,j) + 1/A_p(i+1,j)) * 
-                              (p_prime(i+1,j) - p_prime(i,j)) *vol(i,j) /(dist_s+dist_n);
-            }
-            else if (bctype(i,j) == 0 && bctype(i+1,j) == -1) {
-                // 情况2：内部-压力边界 → 用 v_star(i,j)
-                v_face(i,j) = v_star(i,j);
-            }
-            else if (bctype(i,j) == -1 && bctype(i+1,j) == 0) {
-                // 情况3：压力边界-内部 → 用 v_star(i+1,j)
-                v_face(i,j) = v_star(i+1,j);
-            }
-            else {
-                // 其它情况，保持不变或由边界条件处理
-            }
+    L.forYFaces(mesh, [&](int i, int j) {
+        if ((bctype(i,j) == 0 && bctype(i+1,j) == 0) ||
+            (bctype(i,j) == 0 && bctype(i+1,j) == -3) ||
+            (bctype(i,j) == -3 && bctype(i+1,j) == 0)) {
+            dist_s = geo.dist_s(i, j);   // 到南侧cell中心距离
+            dist_n = geo.dist_n(i, j); // 到北侧cell中心距离
+            // 情况1：内部或特殊内部 → 做压力修正
+            v_face(i,j) = v_face(i,j) + 
+                           (1/A_p(i,j) + 1/A_p(i+1,j)) * 
+                          (p_prime(i+1,j) - p_prime(i,j)) *geo.vol(i,j) /(dist_s+dist_n);
         }
-    }
+        else if (bctype(i,j) == 0 && bctype(i+1,j) == -1) {
+            // 情况2：内部-压力边界 → 用 v_star(i,j)
+            v_face(i,j) = v_star(i,j);
+        }
+        else if (bctype(i,j) == -1 && bctype(i+1,j) == 0) {
+            // 情况3：压力边界-内部 → 用 v_star(i+1,j)
+            v_face(i,j) = v_star(i+1,j);
+        }
+        else {
+            // 其它情况，保持不变或由边界条件处理
+        }
+    });
+}
+
+
+void correct_velocity(Mesh &mesh, Equation &equ_u)
+{
+    dispatchKernel(mesh, [&](const auto& geo, const auto& L) { correct_velocity_impl(mesh, equ_u, geo, L); });
 }
 
 void post_processing(Mesh &mseh)
@@ -925,40 +1111,84 @@ void show_progress_bar(int current_step, int total_steps, double elapsed_time) {
 }
 
 
-void momentum_function(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double alpha_uv)
+/**
+ * @brief 面循环：每个面的扩散导数、质量流量与中心距离只计算一次
+ *
+ * 东面 (i,j) 即单元 (i,j+1) 的西面，南面 (i,j) 即单元 (i+1,j) 的北面
+ * （area_w(i,j+1) 与 area_e(i,j) 由同一对顶点算出，dist_w(i,j+1) 与 dist_e(i,j)
+ * 由同一对单元中心算出，数值相同），相邻两单元读取同一项，
+ * 互为镜像的系数 A_e(i,j) 与 A_w(i,j+1) 由同一 (D, F) 得到。
+ *
+ * 面列表取自活动拓扑：nb_e / nb_s 给出两侧均为活动单元的东面 / 南面（每面恰好一次），
+ * bfaces 给出活动单元与边界 / ghost 单元之间的面；实体区内部的面不计算，也不被读取。
+ */
+template <class Geo, class Layout>
+static void face_fluxes(const Mesh &mesh, Equation &equ, double mu, const Geo& geo, const Layout& L)
+{
+    for (MatrixXd* f : { &equ.D_x, &equ.F_x, &equ.L_x })
+        f->resize(mesh.fieldRows(FIELD_XFACE), mesh.fieldCols(FIELD_XFACE));
+    for (MatrixXd* f : { &equ.D_y, &equ.F_y, &equ.L_y })
+        f->resize(mesh.fieldRows(FIELD_YFACE), mesh.fieldCols(FIELD_YFACE));
+    auto D_x = view<FIELD_XFACE>(L, equ.D_x);
+    auto F_x = view<FIELD_XFACE>(L, equ.F_x);
+    auto L_x = view<FIELD_XFACE>(L, equ.L_x);
+    auto D_y = view<FIELD_YFACE>(L, equ.D_y);
+    auto F_y = view<FIELD_YFACE>(L, equ.F_y);
+    auto L_y = view<FIELD_YFACE>(L, equ.L_y);
+    auto u_face = view<FIELD_XFACE>(L, mesh.u_face);
+    auto v_face = view<FIELD_YFACE>(L, mesh.v_face);
+
+    auto face_x = [&](int i, int j) {   // 单元 (i,j) 的东面
+        const double d = geo.dist_e(i, j);
+        L_x(i, j) = d;
+        D_x(i, j) = geo.area_e(i, j) * mu / d;
+        F_x(i, j) = geo.area_e(i, j) * u_face(i, j);
+    };
+    auto face_y = [&](int i, int j) {   // 单元 (i,j) 的南面
+        const double d = geo.dist_s(i, j);
+        L_y(i, j) = d;
+        D_y(i, j) = geo.area_s(i, j) * mu / d;
+        F_y(i, j) = geo.area_s(i, j) * v_face(i, j);
+    };
+
+    for (int k = 0; k < mesh.internumber; ++k) {
+        if (mesh.nb_e[k] >= 0) face_x(mesh.interi[k], mesh.interj[k]);
+        if (mesh.nb_s[k] >= 0) face_y(mesh.interi[k], mesh.interj[k]);
+    }
+    for (const BoundaryFace& f : mesh.bfaces) {
+        const int i = mesh.interi[f.cell], j = mesh.interj[f.cell];
+        switch (f.dir) {
+            case FACE_E: face_x(i, j);     break;
+            case FACE_W: face_x(i, j - 1); break;
+            case FACE_N: face_y(i - 1, j); break;
+            case FACE_S: face_y(i, j);     break;
+        }
+    }
+}
+
+template <class Geo, class Layout>
+static void momentum_function_impl(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double alpha_uv,
+                                   const Geo& geo, const Layout& L)
 {   
     //-1 压力出口(给定压强)
     //-2 固定速度
     //-3 并行交界面
 
     int n,i,j;
-    int n_x=equ_u.n_x;
-    int n_y=equ_u.n_y;
     double D_e,D_w,D_n,D_s,F_e,F_n,F_s,F_w;
     double dist_e,dist_w,dist_s,dist_n;
 
     // 引用网格变量
     MatrixXi &zoneid = mesh.zoneid;
     MatrixXi &bctype = mesh.bctype;
-    MatrixXd &u_face= mesh.u_face;
-    MatrixXd &v_face= mesh.v_face;
-
-    MatrixXd &x_c  = mesh.x_c;
-    MatrixXd &y_c  = mesh.y_c;
-    MatrixXd &area_e = mesh.area_e;
-    MatrixXd &area_w = mesh.area_w;
-    MatrixXd &area_s = mesh.area_s;
-    MatrixXd &area_n = mesh.area_n;
-    MatrixXd &vol    = mesh.vol;
-
-    MatrixXd &p= mesh.p;
-    MatrixXd &u_star= mesh.u_star;
-    MatrixXd &v_star= mesh.v_star;
-    MatrixXd &A_p=equ_u.A_p;
-    MatrixXd &A_e=equ_u.A_e;
-    MatrixXd &A_w=equ_u.A_w;
-    MatrixXd &A_n=equ_u.A_n;
-    MatrixXd &A_s=equ_u.A_s;
+    auto p= view<FIELD_CELL>(L, mesh.p);
+    auto u_star= view<FIELD_CELL>(L, mesh.u_star);
+    auto v_star= view<FIELD_CELL>(L, mesh.v_star);
+    auto A_p=view<FIELD_CELL>(L, equ_u.A_p);
+    auto A_e=view<FIELD_CELL>(L, equ_u.A_e);
+    auto A_w=view<FIELD_CELL>(L, equ_u.A_w);
+    auto A_n=view<FIELD_CELL>(L, equ_u.A_n);
+    auto A_s=view<FIELD_CELL>(L, equ_u.A_s);
     VectorXd &source_x=equ_u.source;
     VectorXd &source_y=equ_v.source;
     vector<double> zoneu=mesh.zoneu;
@@ -967,211 +1197,220 @@ void momentum_function(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,do
     mesh.v.setZero();
     equ_u.initializeToZero();
     equ_v.initializeToZero();
+    face_fluxes(mesh, equ_u, mu, geo, L);
+    // 面数组在 face_fluxes 中（首次）分配，视图须在其后建立
+    const MatrixXd &cD_x = equ_u.D_x, &cF_x = equ_u.F_x, &cL_x = equ_u.L_x;
+    const MatrixXd &cD_y = equ_u.D_y, &cF_y = equ_u.F_y, &cL_y = equ_u.L_y;
+    auto D_x = view<FIELD_XFACE>(L, cD_x);
+    auto F_x = view<FIELD_XFACE>(L, cF_x);
+    auto L_x = view<FIELD_XFACE>(L, cL_x);
+    auto D_y = view<FIELD_YFACE>(L, cD_y);
+    auto F_y = view<FIELD_YFACE>(L, cF_y);
+    auto L_y = view<FIELD_YFACE>(L, cL_y);
     // 遍历网格
-    for(i=0; i<n_y; i++) {
-        for(j=0; j<n_x; j++) {
-            if(bctype(i,j) == 0) {  // 内部面
-
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-
-                D_e=area_e(i,j)*mu/(dist_e);
-                D_w=area_w(i,j)*mu/(dist_w);
-                D_s=area_s(i,j)*mu/(dist_s);
-                D_n=area_n(i,j)*mu/(dist_n);
-                n = mesh.interid(i,j) ;
-                
-                // 计算面上流量
-                F_e = area_e(i,j)*u_face(i,j);
-                F_w = area_w(i,j)*u_face(i,j-1);
-                F_n = area_n(i,j)*v_face(i-1,j);
-                F_s = area_s(i,j)*v_face(i,j);
-                
-                double Ap_temp = 0;
-               // 初始化源项
-               double source_x_temp, source_y_temp;
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        i = mesh.interi[k];
+        j = mesh.interj[k];
+
+        // 到东 / 西 / 南 / 北侧 cell 中心距离取自面数组
+        dist_e = L_x(i, j);
+        dist_w = L_x(i, j-1);
+        dist_s = L_y(i, j);
+        dist_n = L_y(i-1, j);
+
+        // 扩散导数与面上流量取自面数组
+        D_e=D_x(i,j);
+        D_w=D_x(i,j-1);
+        D_s=D_y(i,j);
+        D_n=D_y(i-1,j);
+        n = mesh.interid(i,j) ;
+        
+        F_e = F_x(i,j);
+        F_w = F_x(i,j-1);
+        F_n = F_y(i-1,j);
+        F_s = F_y(i,j);
+        
+        double Ap_temp = 0;
+       // 初始化源项
+       double source_x_temp, source_y_temp;
+
+                   // 处理 x 方向源项
+    if((bctype(i,j-1) == 0 ||  bctype(i,j-1) == -3) && 
+       (bctype(i,j+1) == 0 ||  bctype(i,j+1) == -3)) {
+        // 两侧都是内部点或滑移边界，使用中心差分
+        source_x_temp = alpha_uv*(p(i,j-1)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+        
+    } else if(bctype(i,j-1) == -1) {
+        // 左边是压力为0的边界
+        source_x_temp = alpha_uv*(-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j+1) == -1) {
+        // 右边是压力为0的边界
+        source_x_temp = alpha_uv*(p(i,j-1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) == -2) {
+        // 左边是速度入口
+        source_x_temp = alpha_uv*(p(i,j)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j+1) == -2) {
+        // 右边是速度入口
+        source_x_temp = alpha_uv*(p(i,j-1)-p(i,j))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) != 0 && bctype(i,j+1) == 0) {
+        // 左边是其他边界，右边是内部点
+        source_x_temp = alpha_uv*(p(i,j)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) == 0 && bctype(i,j+1) != 0) {
+        // 左边是内部点，右边是其他边界
+        source_x_temp = alpha_uv*(p(i,j-1)-p(i,j))*geo.vol(i,j)/(dist_e+dist_w);
+    } else {
+        // 两边都是固定边界或其他情况
+        source_x_temp = 0.0; 
+    }
     
-                           // 处理 x 方向源项
-            if((bctype(i,j-1) == 0 ||  bctype(i,j-1) == -3) && 
-               (bctype(i,j+1) == 0 ||  bctype(i,j+1) == -3)) {
-                // 两侧都是内部点或滑移边界，使用中心差分
-                source_x_temp = alpha_uv*(p(i,j-1)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-                
-            } else if(bctype(i,j-1) == -1) {
-                // 左边是压力为0的边界
-                source_x_temp = alpha_uv*(-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j+1) == -1) {
-                // 右边是压力为0的边界
-                source_x_temp = alpha_uv*(p(i,j-1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) == -2) {
-                // 左边是速度入口
-                source_x_temp = alpha_uv*(p(i,j)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j+1) == -2) {
-                // 右边是速度入口
-                source_x_temp = alpha_uv*(p(i,j-1)-p(i,j))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) != 0 && bctype(i,j+1) == 0) {
-                // 左边是其他边界，右边是内部点
-                source_x_temp = alpha_uv*(p(i,j)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) == 0 && bctype(i,j+1) != 0) {
-                // 左边是内部点，右边是其他边界
-                source_x_temp = alpha_uv*(p(i,j-1)-p(i,j))*vol(i,j)/(dist_e+dist_w);
-            } else {
-                // 两边都是固定边界或其他情况
-                source_x_temp = 0.0; 
-            }
+    // 处理 y 方向源项
+    if((bctype(i-1,j) == 0 ||  bctype(i-1,j) == -3) && 
+       (bctype(i+1,j) == 0 ||  bctype(i+1,j) == -3)) {
+        // 上下都是内部点或滑移边界，使用中心差分
+        source_y_temp = alpha_uv*(p(i+1,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i-1,j) == -1) {
+        // 上边是压力为0的边界
+        source_y_temp = alpha_uv*(p(i+1,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i+1,j) == -1) {
+        // 下边是压力为0的边界  压力出口
+        source_y_temp = alpha_uv*(-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) == -2) {
+        // 上边是压力为0的边界
+        source_y_temp = alpha_uv*(p(i+1,j)-p(i,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i+1,j) == -2) {
+        // 下边是压力为0的边界
+        source_y_temp = alpha_uv*(p(i,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) != 0 && bctype(i+1,j) == 0) {
+        // 上边是其他边界，下边是内部点
+        source_y_temp = alpha_uv*(p(i+1,j)-p(i,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) == 0 && bctype(i+1,j) != 0) {
+        // 上边是内部点，下边是其他边界
+        source_y_temp = alpha_uv*(p(i,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else {
+        // 上下都是固定边界或其他情况
+        source_y_temp = 0.0;
+    }
+      
+        // 检查东面
+        if(bctype(i,j+1) == 0) {  // 内部点
+            A_e(i,j) = D_e + max(0.0,-F_e);
+            Ap_temp += D_e + max(0.0,F_e);
             
-            // 处理 y 方向源项
-            if((bctype(i-1,j) == 0 ||  bctype(i-1,j) == -3) && 
-               (bctype(i+1,j) == 0 ||  bctype(i+1,j) == -3)) {
-                // 上下都是内部点或滑移边界，使用中心差分
-                source_y_temp = alpha_uv*(p(i+1,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i-1,j) == -1) {
-                // 上边是压力为0的边界
-                source_y_temp = alpha_uv*(p(i+1,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i+1,j) == -1) {
-                // 下边是压力为0的边界  压力出口
-                source_y_temp = alpha_uv*(-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) == -2) {
-                // 上边是压力为0的边界
-                source_y_temp = alpha_uv*(p(i+1,j)-p(i,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i+1,j) == -2) {
-                // 下边是压力为0的边界
-                source_y_temp = alpha_uv*(p(i,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) != 0 && bctype(i+1,j) == 0) {
-                // 上边是其他边界，下边是内部点
-                source_y_temp = alpha_uv*(p(i+1,j)-p(i,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) == 0 && bctype(i+1,j) != 0) {
-                // 上边是内部点，下边是其他边界
-                source_y_temp = alpha_uv*(p(i,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else {
-                // 上下都是固定边界或其他情况
-                source_y_temp = 0.0;
-            }
-              
-                // 检查东面
-                if(bctype(i,j+1) == 0) {  // 内部点
-                    A_e(i,j) = D_e + max(0.0,-F_e);
-                    Ap_temp += D_e + max(0.0,F_e);
-                    
-                } 
-                else if(bctype(i,j+1) ==-3) {  // 其他边界
-                    A_e(i,j) = D_e + max(0.0,-F_e);
-                    Ap_temp += D_e + max(0.0,F_e);
-                }
-                
-                else if(bctype(i,j+1) > 0) {  // wall边界
-                    A_e(i,j) = 0;
-                    Ap_temp += 2*D_e + max(0.0,F_e);
-                    source_x_temp += alpha_uv*zoneu[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
-                    source_y_temp += alpha_uv*zonev[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
-                } 
-                else if(bctype(i,j+1) ==-1 ) {  // 其他边界
-                    A_e(i,j) = 0;
-                    Ap_temp += D_e + max(0.0,F_e);
-                    source_x_temp += alpha_uv*u_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
-                    source_y_temp += alpha_uv*v_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
-                }
-                else if(bctype(i,j+1) > -10) {  // 其他边界
-                    A_e(i,j) = 0;
-                    Ap_temp += D_e + max(0.0,F_e);  // 移除系数2
-                    source_x_temp += alpha_uv*zoneu[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
-                    source_y_temp += alpha_uv*zonev[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
-                }
-                 
-                // 检查西面
-                if(bctype(i,j-1) == 0) {  // 内部点
-                    A_w(i,j) = D_w + max(0.0,F_w);
-                    Ap_temp += D_w + max(0.0,-F_w);
-                } 
-                else if(bctype(i,j-1) ==-3) {  // 其他边界
-                    A_w(i,j) = D_w + max(0.0,F_w);
-                    Ap_temp += D_w + max(0.0,-F_w);
-                }
-                else if(bctype(i,j-1) ==-1) {  // 其他边界
-                    A_w(i,j) = 0;
-                    Ap_temp += D_w + max(0.0,-F_w);
-                    source_x_temp += alpha_uv*u_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
-                    source_y_temp += alpha_uv*v_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
-                }
-                else if(bctype(i,j-1) > 0) {  //wall边界
-                    A_w(i,j) = 0;
-                    Ap_temp += 2*D_w + max(0.0,-F_w);
-                    source_x_temp += alpha_uv*zoneu[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
-                    source_y_temp += alpha_uv*zonev[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
-                } else if(bctype(i,j-1) > -10) {  //其他
-                    A_w(i,j) = 0;
-                    Ap_temp += D_w + max(0.0,-F_w);  // 移除系数2
-                    source_x_temp += alpha_uv*zoneu[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
-                    source_y_temp += alpha_uv*zonev[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
-                }
-                
-                // 检查北面
-                if(bctype(i-1,j) == 0) {  // 内部点
-                    A_n(i,j) = D_n + max(0.0,-F_n);
-                    Ap_temp += D_n + max(0.0,F_n);
-                } 
-                else if(bctype(i-1,j) == -1) {  // 压力出口
-                    A_n(i,j) = 0;
-                    Ap_temp += D_n + max(0.0,F_n);
-                    source_x_temp += alpha_uv*u_star(i-1,j)*(D_n + max(0.0,-F_n));
-                    source_y_temp += alpha_uv*v_star(i-1,j)*(D_n + max(0.0,-F_n));
-                } 
-               
-                else if(bctype(i-1,j) > 0) {  // wall边界
-                    A_n(i,j) = 0;
-                    Ap_temp += 2*D_n + max(0.0,F_n);
-                    source_x_temp += alpha_uv*zoneu[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
-                    source_y_temp += alpha_uv*zonev[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
-                } else if(bctype(i-1,j) > -10) {  // 其他边界
-                    A_n(i,j) = 0;
-                    Ap_temp += D_n + max(0.0,F_n);  // 移除系数2
-                    source_x_temp += alpha_uv*zoneu[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
-                    source_y_temp += alpha_uv*zonev[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
-                }
-                
-                // 检查南面
-                if(bctype(i+1,j) == 0) {  // 内部点
-                    A_s(i,j) = D_s + max(0.0,F_s);
-                    Ap_temp += D_s + max(0.0,-F_s);
-                }
-                else if(bctype(i+1,j) == -1) {  // 压力出口
-                    A_s(i,j) =0;
-                    Ap_temp += D_s + max(0.0,-F_s);  
-                    source_x_temp += alpha_uv*u_star(i+1,j)*(D_s + max(0.0,F_s));  
-                    source_y_temp += alpha_uv*v_star(i+1,j)*(D_s + max(0.0,F_s));  
-                }
-                 else if(bctype(i+1,j) > 0) {  // wall边界
-                    A_s(i,j) = 0;
-                    Ap_temp += 2*D_s + max(0.0,-F_s);
-                    source_x_temp += alpha_uv*zoneu[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
-                    source_y_temp += alpha_uv*zonev[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
-                } else if(bctype(i+1,j) > -10) {  // 其他边界
-                    A_s(i,j) = 0;
-                    Ap_temp += D_s + max(0.0,-F_s);  // 移除系数2
-                    source_x_temp += alpha_uv*zoneu[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
-                    source_y_temp += alpha_uv*zonev[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
-                }
-                
-                A_p(i,j) = Ap_temp;
-                
-                source_x_temp += (1-alpha_uv)*A_p(i,j)*u_star(i,j);
-                source_y_temp += (1-alpha_uv)*A_p(i,j)*v_star(i,j);
-                // 设置源项
-                source_x[n] = source_x_temp;
-                source_y[n] = source_y_temp;
-            }
+        } 
+        else if(bctype(i,j+1) ==-3) {  // 其他边界
+            A_e(i,j) = D_e + max(0.0,-F_e);
+            Ap_temp += D_e + max(0.0,F_e);
+        }
+        
+        else if(bctype(i,j+1) > 0) {  // wall边界
+            A_e(i,j) = 0;
+            Ap_temp += 2*D_e + max(0.0,F_e);
+            source_x_temp += alpha_uv*zoneu[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
+            source_y_temp += alpha_uv*zonev[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
+        } 
+        else if(bctype(i,j+1) ==-1 ) {  // 其他边界
+            A_e(i,j) = 0;
+            Ap_temp += D_e + max(0.0,F_e);
+            source_x_temp += alpha_uv*u_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
+            source_y_temp += alpha_uv*v_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
+        }
+        else if(bctype(i,j+1) > -10) {  // 其他边界
+            A_e(i,j) = 0;
+            Ap_temp += D_e + max(0.0,F_e);  // 移除系数2
+            source_x_temp += alpha_uv*zoneu[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
+            source_y_temp += alpha_uv*zonev[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
+        }
+         
+        // 检查西面
+        if(bctype(i,j-1) == 0) {  // 内部点
+            A_w(i,j) = D_w + max(0.0,F_w);
+            Ap_temp += D_w + max(0.0,-F_w);
+        } 
+        else if(bctype(i,j-1) ==-3) {  // 其他边界
+            A_w(i,j) = D_w + max(0.0,F_w);
+            Ap_temp += D_w + max(0.0,-F_w);
+        }
+        else if(bctype(i,j-1) ==-1) {  // 其他边界
+            A_w(i,j) = 0;
+            Ap_temp += D_w + max(0.0,-F_w);
+            source_x_temp += alpha_uv*u_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
+            source_y_temp += alpha_uv*v_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
+        }
+        else if(bctype(i,j-1) > 0) {  //wall边界
+            A_w(i,j) = 0;
+            Ap_temp += 2*D_w + max(0.0,-F_w);
+            source_x_temp += alpha_uv*zoneu[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
+            source_y_temp += alpha_uv*zonev[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
+        } else if(bctype(i,j-1) > -10) {  //其他
+            A_w(i,j) = 0;
+            Ap_temp += D_w + max(0.0,-F_w);  // 移除系数2
+            source_x_temp += alpha_uv*zoneu[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
+            source_y_temp += alpha_uv*zonev[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
+        }
+        
+        // 检查北面
+        if(bctype(i-1,j) == 0) {  // 内部点
+            A_n(i,j) = D_n + max(0.0,-F_n);
+            Ap_temp += D_n + max(0.0,F_n);
+        } 
+        else if(bctype(i-1,j) == -1) {  // 压力出口
+            A_n(i,j) = 0;
+            Ap_temp += D_n + max(0.0,F_n);
+            source_x_temp += alpha_uv*u_star(i-1,j)*(D_n + max(0.0,-F_n));
+            source_y_temp += alpha_uv*v_star(i-1,j)*(D_n + max(0.0,-F_n));
+        } 
+       
+        else if(bctype(i-1,j) > 0) {  // wall边界
+            A_n(i,j) = 0;
+            Ap_temp += 2*D_n + max(0.0,F_n);
+            source_x_temp += alpha_uv*zoneu[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
+            source_y_temp += alpha_uv*zonev[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
+        } else if(bctype(i-1,j) > -10) {  // 其他边界
+            A_n(i,j) = 0;
+            Ap_temp += D_n + max(0.0,F_n);  // 移除系数2
+            source_x_temp += alpha_uv*zoneu[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
+            source_y_temp += alpha_uv*zonev[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
+        }
+        
+        // 检查南面
+        if(bctype(i+1,j) == 0) {  // 内部点
+            A_s(i,j) = D_s + max(0.0,F_s);
+            Ap_temp += D_s + max(0.0,-F_s);
+        }
+        else if(bctype(i+1,j) == -1) {  // 压力出口
+            A_s(i,j) =0;
+            Ap_temp += D_s + max(0.0,-F_s);  
+            source_x_temp += alpha_uv*u_star(i+1,j)*(D_s + max(0.0,F_s));  
+            source_y_temp += alpha_uv*v_star(i+1,j)*(D_s + max(0.0,F_s));  
         }
+         else if(bctype(i+1,j) > 0) {  // wall边界
+            A_s(i,j) = 0;
+            Ap_temp += 2*D_s + max(0.0,-F_s);
+            source_x_temp += alpha_uv*zoneu[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
+            source_y_temp += alpha_uv*zonev[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
+        } else if(bctype(i+1,j) > -10) {  // 其他边界
+            A_s(i,j) = 0;
+            Ap_temp += D_s + max(0.0,-F_s);  // 移除系数2
+            source_x_temp += alpha_uv*zoneu[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
+            source_y_temp += alpha_uv*zonev[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
+        }
+        
+        A_p(i,j) = Ap_temp;
+        
+        source_x_temp += (1-alpha_uv)*A_p(i,j)*u_star(i,j);
+        source_y_temp += (1-alpha_uv)*A_p(i,j)*v_star(i,j);
+        // 设置源项
+        source_x[n] = source_x_temp;
+        source_y[n] = source_y_temp;
     }
 
-    A_e = alpha_uv*A_e;
-    A_w = alpha_uv*A_w;
-    A_n = alpha_uv*A_n;
-    A_s = alpha_uv*A_s;
+    equ_u.A_e = alpha_uv*equ_u.A_e;
+    equ_u.A_w = alpha_uv*equ_u.A_w;
+    equ_u.A_n = alpha_uv*equ_u.A_n;
+    equ_u.A_s = alpha_uv*equ_u.A_s;
     
     // 将系数复制到v方程
     equ_v.A_p = equ_u.A_p;
@@ -1183,31 +1422,35 @@ void momentum_function(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,do
     equ_v.build_matrix();
 }
 
-void momentum_function_unsteady(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double dt)
+
+void momentum_function(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double alpha_uv)
+{
+    dispatchKernel(mesh, [&](const auto& geo, const auto& L) {
+        momentum_function_impl(mesh, equ_u, equ_v, mu, alpha_uv, geo, L);
+    });
+}
+
+template <class Geo>
+static void momentum_function_unsteady_impl(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double dt, const Geo& geo)
 {   
     //-1 压力出口(给定压强)
     //-2 固定速度
     //-3 并行交界面
 
     int n,i,j;
-    int n_x=equ_u.n_x;
-    int n_y=equ_u.n_y;
     double D_e,D_w,D_n,D_s,F_e,F_n,F_s,F_w;
     double dist_e,dist_w,dist_s,dist_n;
 
     // 引用网格变量
     MatrixXi &zoneid = mesh.zoneid;
     MatrixXi &bctype = mesh.bctype;
-    MatrixXd &u_face= mesh.u_face;
-    MatrixXd &v_face= mesh.v_face;
+    const MatrixXd &D_x = equ_u.D_x;
+    const MatrixXd &F_x = equ_u.F_x;
+    const MatrixXd &L_x = equ_u.L_x;
+    const MatrixXd &D_y = equ_u.D_y;
+    const MatrixXd &F_y = equ_u.F_y;
+    const MatrixXd &L_y = equ_u.L_y;
 
-    MatrixXd &x_c  = mesh.x_c;
-    MatrixXd &y_c  = mesh.y_c;
-    MatrixXd &area_e = mesh.area_e;
-    MatrixXd &area_w = mesh.area_w;
-    MatrixXd &area_s = mesh.area_s;
-    MatrixXd &area_n = mesh.area_n;
-    MatrixXd &vol    = mesh.vol;
 
     MatrixXd &p= mesh.p;
     MatrixXd &u_star= mesh.u_star;
@@ -1225,206 +1468,206 @@ void momentum_function_unsteady(Mesh &mesh, Equation &equ_u, Equation &equ_v,dou
     mesh.v.setZero();
     equ_u.initializeToZero();
     equ_v.initializeToZero();
+    face_fluxes(mesh, equ_u, mu, geo, RectLayout(mesh));
     // 遍历网格
-    for(i=0; i<n_y; i++) {
-        for(j=0; j<n_x; j++) {
-            if(bctype(i,j) == 0) {  // 内部面
-                
-                dist_e = x_c(i, j+1) - x_c(i, j);   // 到东侧cell中心距离
-                dist_w = x_c(i, j)   - x_c(i, j-1); // 到西侧cell中心距离
-                dist_s = y_c(i+1, j) - y_c(i, j);   // 到南侧cell中心距离
-                dist_n = y_c(i, j)   - y_c(i-1, j); // 到北侧cell中心距离
-
-                D_e=area_e(i,j)*mu/(dist_e);
-                D_w=area_w(i,j)*mu/(dist_w);
-                D_s=area_s(i,j)*mu/(dist_s);
-                D_n=area_n(i,j)*mu/(dist_n);
-                n = mesh.interid(i,j) ;
-                
-                // 计算面上流量
-                F_e = area_e(i,j)*u_face(i,j);
-                F_w = area_w(i,j)*u_face(i,j-1);
-                F_n = area_n(i,j)*v_face(i-1,j);
-                F_s = area_s(i,j)*v_face(i,j);
-                double Ap_temp = 0;
-               // 初始化源项
-               double source_x_temp, source_y_temp;
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        i = mesh.interi[k];
+        j = mesh.interj[k];
+        
+        // 到东 / 西 / 南 / 北侧 cell 中心距离取自面数组
+        dist_e = L_x(i, j);
+        dist_w = L_x(i, j-1);
+        dist_s = L_y(i, j);
+        dist_n = L_y(i-1, j);
+
+        // 扩散导数与面上流量取自面数组
+        D_e=D_x(i,j);
+        D_w=D_x(i,j-1);
+        D_s=D_y(i,j);
+        D_n=D_y(i-1,j);
+        n = mesh.interid(i,j) ;
+        
+        F_e = F_x(i,j);
+        F_w = F_x(i,j-1);
+        F_n = F_y(i-1,j);
+        F_s = F_y(i,j);
+        double Ap_temp = 0;
+       // 初始化源项
+       double source_x_temp, source_y_temp;
+
+                   // 处理 x 方向源项
+    if((bctype(i,j-1) == 0 ||  bctype(i,j-1) == -3) && 
+       (bctype(i,j+1) == 0 ||  bctype(i,j+1) == -3)) {
+        // 两侧都是内部点或滑移边界，使用中心差分
+        source_x_temp = (p(i,j-1)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+        
+    } else if(bctype(i,j-1) == -1) {
+        // 左边是压力为0的边界
+        source_x_temp = (-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j+1) == -1) {
+        // 右边是压力为0的边界
+        source_x_temp = (p(i,j-1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) == -2) {
+        // 左边是速度入口
+        source_x_temp = (p(i,j)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j+1) == -2) {
+        // 右边是速度入口
+        source_x_temp = (p(i,j-1)-p(i,j))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) != 0 && bctype(i,j+1) == 0) {
+        // 左边是其他边界，右边是内部点
+        source_x_temp = (p(i,j)-p(i,j+1))*geo.vol(i,j)/(dist_e+dist_w);
+    } else if(bctype(i,j-1) == 0 && bctype(i,j+1) != 0) {
+        // 左边是内部点，右边是其他边界
+        source_x_temp = (p(i,j-1)-p(i,j))*geo.vol(i,j)/(dist_e+dist_w);
+    } else {
+        // 两边都是固定边界或其他情况
+        source_x_temp = 0.0; 
+    }
     
-                           // 处理 x 方向源项
-            if((bctype(i,j-1) == 0 ||  bctype(i,j-1) == -3) && 
-               (bctype(i,j+1) == 0 ||  bctype(i,j+1) == -3)) {
-                // 两侧都是内部点或滑移边界，使用中心差分
-                source_x_temp = (p(i,j-1)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-                
-            } else if(bctype(i,j-1) == -1) {
-                // 左边是压力为0的边界
-                source_x_temp = (-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j+1) == -1) {
-                // 右边是压力为0的边界
-                source_x_temp = (p(i,j-1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) == -2) {
-                // 左边是速度入口
-                source_x_temp = (p(i,j)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j+1) == -2) {
-                // 右边是速度入口
-                source_x_temp = (p(i,j-1)-p(i,j))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) != 0 && bctype(i,j+1) == 0) {
-                // 左边是其他边界，右边是内部点
-                source_x_temp = (p(i,j)-p(i,j+1))*vol(i,j)/(dist_e+dist_w);
-            } else if(bctype(i,j-1) == 0 && bctype(i,j+1) != 0) {
-                // 左边是内部点，右边是其他边界
-                source_x_temp = (p(i,j-1)-p(i,j))*vol(i,j)/(dist_e+dist_w);
-            } else {
-                // 两边都是固定边界或其他情况
-                source_x_temp = 0.0; 
-            }
+    // 处理 y 方向源项
+    if((bctype(i-1,j) == 0 ||  bctype(i-1,j) == -3) && 
+       (bctype(i+1,j) == 0 ||  bctype(i+1,j) == -3)) {
+        // 上下都是内部点或滑移边界，使用中心差分
+        source_y_temp = (p(i+1,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i-1,j) == -1) {
+        // 上边是压力为0的边界
+        source_y_temp = (p(i+1,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i+1,j) == -1) {
+        // 下边是压力为0的边界  压力出口
+        source_y_temp = (-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) == -2) {
+        // 上边是压力为0的边界
+        source_y_temp = (p(i+1,j)-p(i,j))*geo.vol(i,j)/(dist_n+dist_s);
+        
+    } else if(bctype(i+1,j) == -2) {
+        // 下边是压力为0的边界
+        source_y_temp = (p(i,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) != 0 && bctype(i+1,j) == 0) {
+        // 上边是其他边界，下边是内部点
+        source_y_temp = (p(i+1,j)-p(i,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else if(bctype(i-1,j) == 0 && bctype(i+1,j) != 0) {
+        // 上边是内部点，下边是其他边界
+        source_y_temp = (p(i,j)-p(i-1,j))*geo.vol(i,j)/(dist_n+dist_s);
+    } else {
+        // 上下都是固定边界或其他情况
+        source_y_temp = 0.0;
+    }
+      
+        // 检查东面
+        if(bctype(i,j+1) == 0) {  // 内部点
+            A_e(i,j) = D_e + max(0.0,-F_e);
+            Ap_temp += D_e + max(0.0,F_e);
             
-            // 处理 y 方向源项
-            if((bctype(i-1,j) == 0 ||  bctype(i-1,j) == -3) && 
-               (bctype(i+1,j) == 0 ||  bctype(i+1,j) == -3)) {
-                // 上下都是内部点或滑移边界，使用中心差分
-                source_y_temp = (p(i+1,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i-1,j) == -1) {
-                // 上边是压力为0的边界
-                source_y_temp = (p(i+1,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i+1,j) == -1) {
-                // 下边是压力为0的边界  压力出口
-                source_y_temp = (-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) == -2) {
-                // 上边是压力为0的边界
-                source_y_temp = (p(i+1,j)-p(i,j))*vol(i,j)/(dist_n+dist_s);
-                
-            } else if(bctype(i+1,j) == -2) {
-                // 下边是压力为0的边界
-                source_y_temp = (p(i,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) != 0 && bctype(i+1,j) == 0) {
-                // 上边是其他边界，下边是内部点
-                source_y_temp = (p(i+1,j)-p(i,j))*vol(i,j)/(dist_n+dist_s);
-            } else if(bctype(i-1,j) == 0 && bctype(i+1,j) != 0) {
-                // 上边是内部点，下边是其他边界
-                source_y_temp = (p(i,j)-p(i-1,j))*vol(i,j)/(dist_n+dist_s);
-            } else {
-                // 上下都是固定边界或其他情况
-                source_y_temp = 0.0;
-            }
-              
-                // 检查东面
-                if(bctype(i,j+1) == 0) {  // 内部点
-                    A_e(i,j) = D_e + max(0.0,-F_e);
-                    Ap_temp += D_e + max(0.0,F_e);
-                    
-                } 
-                else if(bctype(i,j+1) ==-3) {  // 其他边界
-                    A_e(i,j) = D_e + max(0.0,-F_e);
-                    Ap_temp += D_e + max(0.0,F_e);
-                }
-                
-                else if(bctype(i,j+1) > 0) {  // wall边界
-                    A_e(i,j) = 0;
-                    Ap_temp += 2*D_e + max(0.0,F_e);
-                    source_x_temp += zoneu[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
-                    source_y_temp += zonev[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
-                } 
-                else if(bctype(i,j+1) ==-1 ) {  // 其他边界
-                    A_e(i,j) = 0;
-                    Ap_temp += D_e + max(0.0,F_e);
-                    source_x_temp += u_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
-                    source_y_temp += v_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
-                }
-                else if(bctype(i,j+1) > -10) {  // 其他边界
-                    A_e(i,j) = 0;
-                    Ap_temp += D_e + max(0.0,F_e);  // 移除系数2
-                    source_x_temp += zoneu[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
-                    source_y_temp += zonev[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
-                }
-                 
-                // 检查西面
-                if(bctype(i,j-1) == 0) {  // 内部点
-                    A_w(i,j) = D_w + max(0.0,F_w);
-                    Ap_temp += D_w + max(0.0,-F_w);
-                } 
-                else if(bctype(i,j-1) ==-3) {  // 其他边界
-                    A_w(i,j) = D_w + max(0.0,F_w);
-                    Ap_temp += D_w + max(0.0,-F_w);
-                }
-                else if(bctype(i,j-1) ==-1) {  // 其他边界
-                    A_w(i,j) = 0;
-                    Ap_temp += D_w + max(0.0,-F_w);
-                    source_x_temp += u_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
-                    source_y_temp += v_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
-                }
-                else if(bctype(i,j-1) > 0) {  //wall边界
-                    A_w(i,j) = 0;
-                    Ap_temp += 2*D_w + max(0.0,-F_w);
-                    source_x_temp += zoneu[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
-                    source_y_temp += zonev[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
-                } else if(bctype(i,j-1) > -10) {  //其他
-                    A_w(i,j) = 0;
-                    Ap_temp += D_w + max(0.0,-F_w);  // 移除系数2
-                    source_x_temp += zoneu[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
-                    source_y_temp += zonev[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
-                }
-                
-                // 检查北面
-                if(bctype(i-1,j) == 0) {  // 内部点
-                    A_n(i,j) = D_n + max(0.0,-F_n);
-                    Ap_temp += D_n + max(0.0,F_n);
-                } 
-                else if(bctype(i-1,j) == -1) {  // 压力出口
-                    A_n(i,j) = 0;
-                    Ap_temp += D_n + max(0.0,F_n);
-                    source_x_temp += u_star(i-1,j)*(D_n + max(0.0,-F_n));
-                    source_y_temp += v_star(i-1,j)*(D_n + max(0.0,-F_n));
-                } 
-               
-                else if(bctype(i-1,j) > 0) {  // wall边界
-                    A_n(i,j) = 0;
-                    Ap_temp += 2*D_n + max(0.0,F_n);
-                    source_x_temp += zoneu[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
-                    source_y_temp += zonev[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
-                } else if(bctype(i-1,j) > -10) {  // 其他边界
-                    A_n(i,j) = 0;
-                    Ap_temp += D_n + max(0.0,F_n);  // 移除系数2
-                    source_x_temp += zoneu[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
-                    source_y_temp += zonev[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
-                }
-                
-                // 检查南面
-                if(bctype(i+1,j) == 0) {  // 内部点
-                    A_s(i,j) = D_s + max(0.0,F_s);
-                    Ap_temp += D_s + max(0.0,-F_s);
-                }
-                else if(bctype(i+1,j) == -1) {  // 压力出口
-                    A_s(i,j) =0;
-                    Ap_temp += D_s + max(0.0,-F_s);  
-                    source_x_temp += u_star(i+1,j)*(D_s + max(0.0,F_s));  
-                    source_y_temp += v_star(i+1,j)*(D_s + max(0.0,F_s));  
-                }
-                 else if(bctype(i+1,j) > 0) {  // wall边界
-                    A_s(i,j) = 0;
-                    Ap_temp += 2*D_s + max(0.0,-F_s);
-                    source_x_temp += zoneu[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
-                    source_y_temp += zonev[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
-                } else if(bctype(i+1,j) > -10) {  // 其他边界
-                    A_s(i,j) = 0;
-                    Ap_temp += D_s + max(0.0,-F_s);  // 移除系数2
-                    source_x_temp += zoneu[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
-                    source_y_temp += zonev[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
-                }
-                
-                
-                
-                A_p(i,j) = Ap_temp+vol(i,j)/dt;
-                
-                source_x_temp += vol(i,j)*mesh.u0(i,j)/dt;
-                source_y_temp += vol(i,j)*mesh.v0(i,j)/dt;
-                // 设置源项
-                source_x[n] = source_x_temp;
-                source_y[n] = source_y_temp;
-            }
+        } 
+        else if(bctype(i,j+1) ==-3) {  // 其他边界
+            A_e(i,j) = D_e + max(0.0,-F_e);
+            Ap_temp += D_e + max(0.0,F_e);
+        }
+        
+        else if(bctype(i,j+1) > 0) {  // wall边界
+            A_e(i,j) = 0;
+            Ap_temp += 2*D_e + max(0.0,F_e);
+            source_x_temp += zoneu[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
+            source_y_temp += zonev[zoneid(i,j+1)]*(2*D_e + max(0.0,-F_e));
+        } 
+        else if(bctype(i,j+1) ==-1 ) {  // 其他边界
+            A_e(i,j) = 0;
+            Ap_temp += D_e + max(0.0,F_e);
+            source_x_temp += u_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
+            source_y_temp += v_star(i,j)*(D_e + max(0.0,-F_e));  // 移除系数2
+        }
+        else if(bctype(i,j+1) > -10) {  // 其他边界
+            A_e(i,j) = 0;
+            Ap_temp += D_e + max(0.0,F_e);  // 移除系数2
+            source_x_temp += zoneu[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
+            source_y_temp += zonev[zoneid(i,j+1)]*(D_e + max(0.0,-F_e));  // 移除系数2
+        }
+         
+        // 检查西面
+        if(bctype(i,j-1) == 0) {  // 内部点
+            A_w(i,j) = D_w + max(0.0,F_w);
+            Ap_temp += D_w + max(0.0,-F_w);
+        } 
+        else if(bctype(i,j-1) ==-3) {  // 其他边界
+            A_w(i,j) = D_w + max(0.0,F_w);
+            Ap_temp += D_w + max(0.0,-F_w);
+        }
+        else if(bctype(i,j-1) ==-1) {  // 其他边界
+            A_w(i,j) = 0;
+            Ap_temp += D_w + max(0.0,-F_w);
+            source_x_temp += u_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
+            source_y_temp += v_star(i,j)*(D_w + max(0.0,F_w));  // 移除系数2
+        }
+        else if(bctype(i,j-1) > 0) {  //wall边界
+            A_w(i,j) = 0;
+            Ap_temp += 2*D_w + max(0.0,-F_w);
+            source_x_temp += zoneu[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
+            source_y_temp += zonev[zoneid(i,j-1)]*(2*D_w + max(0.0,F_w));
+        } else if(bctype(i,j-1) > -10) {  //其他
+            A_w(i,j) = 0;
+            Ap_temp += D_w + max(0.0,-F_w);  // 移除系数2
+            source_x_temp += zoneu[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
+            source_y_temp += zonev[zoneid(i,j-1)]*(D_w + max(0.0,F_w));  // 移除系数2
         }
+        
+        // 检查北面
+        if(bctype(i-1,j) == 0) {  // 内部点
+            A_n(i,j) = D_n + max(0.0,-F_n);
+            Ap_temp += D_n + max(0.0,F_n);
+        } 
+        else if(bctype(i-1,j) == -1) {  // 压力出口
+            A_n(i,j) = 0;
+            Ap_temp += D_n + max(0.0,F_n);
+            source_x_temp += u_star(i-1,j)*(D_n + max(0.0,-F_n));
+            source_y_temp += v_star(i-1,j)*(D_n + max(0.0,-F_n));
+        } 
+       
+        else if(bctype(i-1,j) > 0) {  // wall边界
+            A_n(i,j) = 0;
+            Ap_temp += 2*D_n + max(0.0,F_n);
+            source_x_temp += zoneu[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
+            source_y_temp += zonev[zoneid(i-1,j)]*(2*D_n + max(0.0,-F_n));
+        } else if(bctype(i-1,j) > -10) {  // 其他边界
+            A_n(i,j) = 0;
+            Ap_temp += D_n + max(0.0,F_n);  // 移除系数2
+            source_x_temp += zoneu[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
+            source_y_temp += zonev[zoneid(i-1,j)]*(D_n + max(0.0,-F_n));  // 移除系数2
+        }
+        
+        // 检查南面
+        if(bctype(i+1,j) == 0) {  // 内部点
+            A_s(i,j) = D_s + max(0.0,F_s);
+            Ap_temp += D_s + max(0.0,-F_s);
+        }
+        else if(bctype(i+1,j) == -1) {  // 压力出口
+            A_s(i,j) =0;
+            Ap_temp += D_s + max(0.0,-F_s);  
+            source_x_temp += u_star(i+1,j)*(D_s + max(0.0,F_s));  
+            source_y_temp += v_star(i+1,j)*(D_s + max(0.0,F_s));  
+        }
+         else if(bctype(i+1,j) > 0) {  // wall边界
+            A_s(i,j) = 0;
+            Ap_temp += 2*D_s + max(0.0,-F_s);
+            source_x_temp += zoneu[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
+            source_y_temp += zonev[zoneid(i+1,j)]*(2*D_s + max(0.0,F_s));
+        } else if(bctype(i+1,j) > -10) {  // 其他边界
+            A_s(i,j) = 0;
+            Ap_temp += D_s + max(0.0,-F_s);  // 移除系数2
+            source_x_temp += zoneu[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
+            source_y_temp += zonev[zoneid(i+1,j)]*(D_s + max(0.0,F_s));  // 移除系数2
+        }
+        
+        
+        
+        A_p(i,j) = Ap_temp+geo.vol(i,j)/dt;
+        
+        source_x_temp += geo.vol(i,j)*mesh.u0(i,j)/dt;
+        source_y_temp += geo.vol(i,j)*mesh.v0(i,j)/dt;
+        // 设置源项
+        source_x[n] = source_x_temp;
+        source_y[n] = source_y_temp;
     }
 
     A_e = A_e;
@@ -1443,6 +1686,15 @@ void momentum_function_unsteady(Mesh &mesh, Equation &equ_u, Equation &equ_v,dou
 }
 
 
+void momentum_function_unsteady(Mesh &mesh, Equation &equ_u, Equation &equ_v,double mu,double dt)
+{
+    // 非定常求解器只使用矩形布局
+    if (mesh.uniform) momentum_function_unsteady_impl(mesh, equ_u, equ_v, mu, dt, UniformGeometry(mesh));
+    else              momentum_function_unsteady_impl(mesh, equ_u, equ_v, mu, dt,
+                                                      GeneralGeometry<RectLayout>(mesh, RectLayout(mesh)));
+}
+
+
 
 // ============================================================================
 // 并行计算相关函数
@@ -1460,19 +1712,38 @@ void momentum_function_unsteady(Mesh &mesh, Equation &equ_u, Equation &equ_v,dou
  */
 vector<Mesh> splitMeshVertically(const Mesh& original, int n)
 {
-    vector<Mesh> sub_meshes;
-
-    const int Nx = original.nx;
-    const int Ny = original.ny;
+    return splitMeshVertically(original, uniformWidths(original.nx, n));
+}
 
-    // ===== 计算每段宽度 =====
+vector<int> uniformWidths(int nx, int n)
+{
     vector<int> widths(n);
-    int remain = Nx;
+    int remain = nx;
     for(int k = 0; k < n; ++k)
     {
         widths[k] = remain / (n - k);
         remain -= widths[k];
     }
+    return widths;
+}
+
+vector<Mesh> splitMeshVertically(const Mesh& original, const vector<int>& widths)
+{
+    vector<Mesh> sub_meshes;
+
+    const int Nx = original.nx;
+    const int Ny = original.ny;
+    const int n  = static_cast<int>(widths.size());
+
+    int total_w = 0;
+    for(int w : widths)
+    {
+        if(n > 1 && w < 2)
+            throw std::runtime_error("子网格真实列数不能少于 2 列!");
+        total_w += w;
+    }
+    if(total_w != Nx)
+        throw std::runtime_error("子网格列宽之和与网格 nx 不一致!");
 
     int start = 0;
 
@@ -1539,6 +1810,14 @@ vector<Mesh> splitMeshVertically(const Mesh& original, int n)
         }
 
         sub.initializeBoundaryConditions();
+        sub.ordering   = original.ordering;
+        sub.order_tile = original.order_tile;
+        sub.col_offset = orig_node_col_offset;
+        // 粗化映射：行原样继承，列取本子网格（含 ghost 列）对应的一段
+        sub.fine_row0 = original.fine_row0;
+        if(!original.fine_col0.empty())
+            sub.fine_col0.assign(original.fine_col0.begin() + orig_node_col_offset,
+                                 original.fine_col0.begin() + orig_node_col_offset + sub_nx + 1);
         sub.createInterId();
         sub.initGeometry();
         sub_meshes.push_back(sub);
@@ -1549,6 +1828,385 @@ vector<Mesh> splitMeshVertically(const Mesh& original, int n)
     return sub_meshes;
 }
 
+// ============================================================================
+// 负载均衡划分
+// ============================================================================
+
+vector<double> columnWorkload(const Mesh& original, double solid_cost,
+                              const MatrixXd& cell_cost)
+{
+    const bool measured = (cell_cost.rows() == original.ny &&
+                           cell_cost.cols() == original.nx);
+    vector<double> col_weight(original.nx, 0.0);
+    for(int j = 0; j < original.nx; ++j)
+    {
+        for(int i = 0; i < original.ny; ++i)
+        {
+            if(measured)
+                col_weight[j] += cell_cost(i,j);
+            else
+                col_weight[j] += (original.bctype(i,j) == 0) ? 1.0 : solid_cost;
+        }
+    }
+    return col_weight;
+}
+
+vector<int> weightedWidths(const vector<double>& col_weight, int n, int min_width)
+{
+    const int Nx = static_cast<int>(col_weight.size());
+    if(n <= 1) return vector<int>(1, Nx);
+    if(Nx < n * min_width)
+        throw std::runtime_error("网格列数不足以划分为指定数量的子网格!");
+
+    // prefix[j] = 前 j 列负载之和
+    vector<double> prefix(Nx + 1, 0.0);
+    for(int j = 0; j < Nx; ++j) prefix[j+1] = prefix[j] + col_weight[j];
+    const double total = prefix[Nx];
+
+    // 全部列负载为 0（如全固体）时退化为均匀划分
+    if(total <= 0.0) return uniformWidths(Nx, n);
+
+    vector<int> cut(n + 1, 0);
+    cut[n] = Nx;
+    for(int k = 1; k < n; ++k)
+    {
+        const double target = total * k / n;
+        // 切点范围：保证前后各段均不少于 min_width 列
+        const int lo = cut[k-1] + min_width;
+        const int hi = Nx - (n - k) * min_width;
+
+        int c = static_cast<int>(std::lower_bound(prefix.begin() + lo,
+                                                  prefix.begin() + hi + 1,
+                                                  target) - prefix.begin());
+        if(c > hi) c = hi;
+        if(c > lo && target - prefix[c-1] < prefix[c] - target) c--;
+        cut[k] = c;
+    }
+
+    vector<int> widths(n);
+    for(int k = 0; k < n; ++k) widths[k] = cut[k+1] - cut[k];
+    return widths;
+}
+
+double reportPartitionBalance(const Mesh& original, const vector<int>& widths,
+                              const vector<double>& col_weight)
+{
+    const int n = static_cast<int>(widths.size());
+    vector<double> load(n, 0.0);
+    vector<int>    fluid(n, 0);
+
+    int start = 0;
+    for(int k = 0; k < n; ++k)
+    {
+        for(int j = start; j < start + widths[k]; ++j)
+        {
+            load[k] += col_weight[j];
+            for(int i = 0; i < original.ny; ++i)
+                if(original.bctype(i,j) == 0) fluid[k]++;
+        }
+        start += widths[k];
+    }
+
+    double max_load = 0.0, sum_load = 0.0;
+    for(int k = 0; k < n; ++k)
+    {
+        max_load = std::max(max_load, load[k]);
+        sum_load += load[k];
+    }
+    const double mean_load = sum_load / n;
+    const double imbalance = (mean_load > 0.0) ? max_load / mean_load : 1.0;
+
+    std::cout << "==================== 负载均衡信息 ====================" << std::endl;
+    for(int k = 0; k < n; ++k)
+    {
+        std::cout << "  子网格 " << k << ": 列数 " << std::setw(5) << widths[k]
+                  << "  流体单元 " << std::setw(8) << fluid[k]
+                  << "  负载 " << std::setw(10) << std::fixed << std::setprecision(1)
+                  << load[k] << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "负载不均衡度 (max/mean): " << std::setprecision(4) << imbalance << std::endl;
+    std::cout << "======================================================\n" << std::endl;
+    return imbalance;
+}
+
+vector<Mesh> partitionMesh(const Mesh& original, int n, const RunOptions& opts,
+                           bool report)
+{
+    const std::string mode = opts.getString("partition", "uniform");
+    if(mode != "uniform" && mode != "weighted")
+        throw std::runtime_error("未知的划分方式: " + mode);
+
+    // 可选的逐单元实测代价（与 bctype.dat 相同的 ny×nx 文本格式）
+    MatrixXd cell_cost;
+    const std::string cost_file = opts.getString("cost-file", "");
+    if(!cost_file.empty())
+    {
+        std::ifstream costFile(cost_file);
+        if(!costFile)
+            throw std::runtime_error("无法打开代价文件: " + cost_file);
+        cell_cost.resize(original.ny, original.nx);
+        for(int i = 0; i < original.ny; i++)
+            for(int j = 0; j < original.nx; j++)
+                costFile >> cell_cost(i,j);
+        if(!costFile)
+            throw std::runtime_error("代价文件尺寸与网格不一致: " + cost_file);
+    }
+
+    const vector<double> col_weight =
+        columnWorkload(original, opts.getDouble("solid-cost", 0.0), cell_cost);
+    const vector<int> widths = (mode == "weighted")
+                             ? weightedWidths(col_weight, n)
+                             : uniformWidths(original.nx, n);
+
+    if(report) reportPartitionBalance(original, widths, col_weight);
+    return splitMeshVertically(original, widths);
+}
+
+// ============================================================================
+// 合成网格生成
+// ============================================================================
+
+Mesh makeCavityMesh(int nx, int ny, double Lx, double Ly,
+                    double lid_u, double stretch)
+{
+    // 与 gen.ipynb 中 exp_stretch 相同的两端加密映射
+    auto node_coord = [stretch](int k, int n, double L) {
+        double t = static_cast<double>(k) / n;
+        if (stretch <= 0.0) return L * t;
+        double half = std::exp(stretch * 0.5) - 1.0;
+        if (t <= 0.5) return L / 2.0 * (std::exp(stretch * t) - 1.0) / half;
+        return L - L / 2.0 * (std::exp(stretch * (1.0 - t)) - 1.0) / half;
+    };
+
+    Mesh mesh(ny, nx);
+    mesh.initializeToZero();
+
+    // ===== 节点坐标 (ny+1)×(nx+1) =====
+    for (int i = 0; i <= ny; ++i) {
+        for (int j = 0; j <= nx; ++j) {
+            mesh.x(i, j) = node_coord(j, nx, Lx);
+            mesh.y(i, j) = node_coord(i, ny, Ly);
+        }
+    }
+
+    // ===== 边界：四周壁面，第 0 行为顶盖 =====
+    mesh.bctype.row(0).setConstant(1);
+    mesh.bctype.row(ny - 1).setConstant(1);
+    mesh.bctype.col(0).setConstant(1);
+    mesh.bctype.col(nx - 1).setConstant(1);
+    mesh.zoneid.row(0).setConstant(1);
+
+    mesh.setZoneUV(0, 0.0, 0.0);
+    mesh.setZoneUV(1, lid_u, 0.0);
+
+    mesh.createInterId();
+    mesh.initializeBoundaryConditions();
+    mesh.initGeometry();
+    return mesh;
+}
+
+Mesh loadMesh(const std::string& spec)
+{
+    const std::string prefix = "cavity:";
+    if (spec.compare(0, prefix.size(), prefix) != 0) {
+        return Mesh(spec);
+    }
+
+    int gen_nx = 0, gen_ny = 0;
+    char sep = 0;
+    std::istringstream ss(spec.substr(prefix.size()));
+    if (!(ss >> gen_nx >> sep >> gen_ny) || sep != 'x' || gen_nx < 3 || gen_ny < 3) {
+        throw std::runtime_error("网格描述格式错误（应为 cavity:<nx>x<ny>）: " + spec);
+    }
+    return makeCavityMesh(gen_nx, gen_ny);
+}
+
+// ============================================================================
+// 网格序列：粗化与插值
+// ============================================================================
+
+// 一个方向上的分组：相邻两条线（行或列）的 bctype 与 zoneid 完全相同时合并，否则单独成组；
+// 返回各组起点，末尾补上线数
+template <class Same>
+static vector<int> coarsenLines(int n, Same same)
+{
+    vector<int> start;
+    for (int k = 0; k < n; ) {
+        start.push_back(k);
+        k += (k + 1 < n && same(k, k + 1)) ? 2 : 1;
+    }
+    start.push_back(n);
+    return start;
+}
+
+Mesh coarsenMesh(const Mesh& fine)
+{
+    const vector<int> rows = coarsenLines(fine.ny, [&](int a, int b) {
+        return fine.bctype.row(a) == fine.bctype.row(b) && fine.zoneid.row(a) == fine.zoneid.row(b);
+    });
+    const vector<int> cols = coarsenLines(fine.nx, [&](int a, int b) {
+        return fine.bctype.col(a) == fine.bctype.col(b) && fine.zoneid.col(a) == fine.zoneid.col(b);
+    });
+    const int cny = static_cast<int>(rows.size()) - 1;
+    const int cnx = static_cast<int>(cols.size()) - 1;
+
+    Mesh coarse(cny, cnx);
+    coarse.initializeToZero();
+    coarse.zoneu      = fine.zoneu;
+    coarse.zonev      = fine.zonev;
+    coarse.ordering   = fine.ordering;
+    coarse.order_tile = fine.order_tile;
+    coarse.fine_row0  = rows;
+    coarse.fine_col0  = cols;
+
+    // ===== 节点坐标：各组首尾的细网格节点 =====
+    for (int I = 0; I <= cny; ++I) {
+        for (int J = 0; J <= cnx; ++J) {
+            coarse.x(I, J) = fine.x(rows[I], cols[J]);
+            coarse.y(I, J) = fine.y(rows[I], cols[J]);
+        }
+    }
+
+    // ===== 边界类型：同组子单元完全相同，取第一个 =====
+    for (int I = 0; I < cny; ++I) {
+        for (int J = 0; J < cnx; ++J) {
+            coarse.bctype(I, J) = fine.bctype(rows[I], cols[J]);
+            coarse.zoneid(I, J) = fine.zoneid(rows[I], cols[J]);
+        }
+    }
+
+    coarse.createInterId();
+    coarse.initializeBoundaryConditions();
+    coarse.initGeometry();
+    return coarse;
+}
+
+// 细网格第 k 条线所在的粗线（lines 为粗网格的 fine_row0 / fine_col0）；
+// side 返回插值的相邻粗线方向：两条线合并的组中前一条取 -1、后一条取 +1，单线组取 0
+static int parentLine(const vector<int>& lines, int k, int& side)
+{
+    const int n = static_cast<int>(lines.size()) - 1;
+    int P = static_cast<int>(std::upper_bound(lines.begin(), lines.end(), k) - lines.begin()) - 1;
+    P = std::clamp(P, 0, n - 1);
+    side = (lines[P + 1] - lines[P] < 2) ? 0 : (k == lines[P] ? -1 : 1);
+    return P;
+}
+
+// 细单元 (i, j) 的双线性插值模板：父单元及 x / y 方向上朝细单元中心一侧的相邻粗单元，
+// 权重只在 coarse_bc == 0 的粗单元上归一化；返回参与插值的粗单元数。
+// 列号经 col_offset 换算，全局网格与按列对齐分割的子网格均适用。
+static int coarseStencil(const Mesh& coarse, const MatrixXi& coarse_bc, const Mesh& fine,
+                         int i, int j, int ci[4], int cj[4], double w[4])
+{
+    auto weight = [](double xf, double xp, double xq) {
+        const double d = xq - xp;
+        if (d == 0.0) return 0.0;
+        return std::clamp((xf - xp) / d, 0.0, 1.0);
+    };
+
+    int si, sj;
+    const int I = parentLine(coarse.fine_row0, i, si);
+    const int J = parentLine(coarse.fine_col0, j + fine.col_offset, sj);
+    const double xf = fine.x_c(i, j), yf = fine.y_c(i, j);
+
+    // 相邻粗单元：细单元中心位于父单元中心的哪一侧
+    const int Jq = std::clamp(J + sj, 0, coarse.nx - 1);
+    const int Iq = std::clamp(I + si, 0, coarse.ny - 1);
+    const double wx = (Jq == J) ? 0.0 : weight(xf, coarse.x_c(I, J), coarse.x_c(I, Jq));
+    const double wy = (Iq == I) ? 0.0 : weight(yf, coarse.y_c(I, J), coarse.y_c(Iq, J));
+
+    const int    ti[4] = {I, I, Iq, Iq};
+    const int    tj[4] = {J, Jq, J, Jq};
+    const double tw[4] = {(1 - wx) * (1 - wy), wx * (1 - wy), (1 - wx) * wy, wx * wy};
+
+    int n = 0;
+    double sw = 0.0;
+    for (int k = 0; k < 4; ++k) {
+        if (tw[k] == 0.0 || coarse_bc(ti[k], tj[k]) != 0) continue;
+        ci[n] = ti[k];
+        cj[n] = tj[k];
+        w[n]  = tw[k];
+        sw   += tw[k];
+        ++n;
+    }
+    for (int k = 0; k < n; ++k) w[k] /= sw;
+    return n;
+}
+
+void prolongFields(const Mesh& coarse, Mesh& fine)
+{
+    int ci[4], cj[4];
+    double w[4];
+    for (int i = 0; i < fine.ny; ++i) {
+        for (int j = 0; j < fine.nx; ++j) {
+            if (fine.bctype(i, j) != 0) continue;
+            const int n = coarseStencil(coarse, coarse.bctype, fine, i, j, ci, cj, w);
+            if (n == 0) continue;   // 周围没有粗内部点（粗化时被并入边界）
+
+            double su = 0.0, sv = 0.0, sp = 0.0;
+            for (int k = 0; k < n; ++k) {
+                su += w[k] * coarse.u_star(ci[k], cj[k]);
+                sv += w[k] * coarse.v_star(ci[k], cj[k]);
+                sp += w[k] * coarse.p(ci[k], cj[k]);
+            }
+            fine.u(i, j) = fine.u_star(i, j) = su;
+            fine.v(i, j) = fine.v_star(i, j) = sv;
+            fine.p(i, j) = fine.p_star(i, j) = sp;
+        }
+    }
+
+    // ===== 内部面速度：相邻两单元的平均 =====
+    for (int i = 0; i < fine.ny; ++i)
+        for (int j = 0; j < fine.nx - 1; ++j)
+            if (fine.bctype(i, j) == 0 && fine.bctype(i, j + 1) == 0)
+                fine.u_face(i, j) = 0.5 * (fine.u_star(i, j) + fine.u_star(i, j + 1));
+    for (int i = 0; i < fine.ny - 1; ++i)
+        for (int j = 0; j < fine.nx; ++j)
+            if (fine.bctype(i, j) == 0 && fine.bctype(i + 1, j) == 0)
+                fine.v_face(i, j) = 0.5 * (fine.v_star(i, j) + fine.v_star(i + 1, j));
+}
+
+void restrictField(const Mesh& fine, const MatrixXi& fine_bc, const MatrixXd& f,
+                   const Mesh& coarse, const MatrixXi& coarse_bc, MatrixXd& c, bool average)
+{
+    // 只写粗网格真实列；子单元可能落在细网格右侧 ghost 列（须已交换）
+    const int lg = (coarse.bctype(0, 0) == -3) ? 2 : 0;
+    const int rg = (coarse.bctype(0, coarse.nx - 1) == -3) ? 2 : 0;
+    for (int J = lg; J < coarse.nx - rg; ++J) {
+        const int j0 = coarse.fine_col0[J] - fine.col_offset;
+        const int j1 = std::min(coarse.fine_col0[J + 1] - fine.col_offset, fine.nx);
+        for (int I = 0; I < coarse.ny; ++I) {
+            if (coarse_bc(I, J) != 0) continue;
+            double sum = 0.0, vol = 0.0;
+            for (int i = coarse.fine_row0[I]; i < coarse.fine_row0[I + 1]; ++i) {
+                for (int j = j0; j < j1; ++j) {
+                    if (fine_bc(i, j) != 0) continue;
+                    const double wv = average ? fine.vol(i, j) : 1.0;
+                    sum += wv * f(i, j);
+                    vol += wv;
+                }
+            }
+            c(I, J) = (average && vol > 0.0) ? sum / vol : sum;
+        }
+    }
+}
+
+void prolongCorrection(const Mesh& coarse, const MatrixXi& coarse_bc, const MatrixXd& ec,
+                       const Mesh& fine, MatrixXd& ef)
+{
+    int ci[4], cj[4];
+    double w[4];
+    for (int k = 0; k < fine.internumber; ++k) {
+        const int i = fine.interi[k];
+        const int j = fine.interj[k];
+        const int n = coarseStencil(coarse, coarse_bc, fine, i, j, ci, cj, w);
+        double e = 0.0;
+        for (int q = 0; q < n; ++q) e += w[q] * ec(ci[q], cj[q]);
+        ef(i, j) += e;
+    }
+}
+
 // ============================================================================
 // 文件I/O函数
 // ============================================================================
@@ -1591,11 +2249,34 @@ void saveMeshData(
             f << field;
         };
 
-        write("u", mesh.u_star);
-        write("v", mesh.v_star);
-        write("xc", mesh.x_c);
-        write("yc", mesh.y_c);        
-        write("p", mesh.p);
+        if (!mesh.compact) {
+            write("u", mesh.u_star);
+            write("v", mesh.v_star);
+            write("xc", mesh.x_c);
+            write("yc", mesh.y_c);        
+            write("p", mesh.p);
+            return;
+        }
+
+        // 紧凑布局：逐场展开为 ny×nx，未存储的实体单元取矩形布局下的值（速度、压力为 0）
+        auto expand = [&](const MatrixXd& f, auto solid) {
+            MatrixXd r(mesh.ny, mesh.nx);
+            for (int j = 0; j < mesh.nx; ++j)
+                for (int i = 0; i < mesh.ny; ++i) {
+                    const int c = mesh.cellid(i, j);
+                    r(i, j) = (c >= 0) ? f(c) : solid(i, j);
+                }
+            return r;
+        };
+        auto node_mean = [&](const MatrixXd& X, int i, int j) {
+            return 0.25 * (X(i, j) + X(i, j+1) + X(i+1, j) + X(i+1, j+1));
+        };
+        auto zero = [](int, int) { return 0.0; };
+        write("u", expand(mesh.u_star, zero));
+        write("v", expand(mesh.v_star, zero));
+        write("xc", expand(mesh.x_c, [&](int i, int j) { return node_mean(mesh.x, i, j); }));
+        write("yc", expand(mesh.y_c, [&](int i, int j) { return node_mean(mesh.y, i, j); }));
+        write("p", expand(mesh.p, zero));
 
     } catch (const std::exception& e) {
         std::cerr << "[Rank " << rank << "] 保存 Mesh 数据失败: "
@@ -1643,12 +2324,144 @@ void saveforecastData(
     }
 }
 
+// ==================== 时间平均统计量 ====================
+
+void FlowStatistics::reset(const Mesh& mesh)
+{
+    samples = 0;
+    for (MatrixXd* m : { &mean_u, &mean_v, &mean_p, &m_uu, &m_vv, &m_uv, &m_pp }) {
+        m->setZero(mesh.ny, mesh.nx);
+    }
+}
+
+MatrixXd& FlowStatistics::accumulator(int k)
+{
+    MatrixXd* acc[NACC] = { &mean_u, &mean_v, &mean_p, &m_uu, &m_vv, &m_uv, &m_pp };
+    return *acc[k];
+}
+
+const MatrixXd& FlowStatistics::accumulator(int k) const
+{
+    return const_cast<FlowStatistics*>(this)->accumulator(k);
+}
+
+void FlowStatistics::update(const Mesh& mesh)
+{
+    if (mean_u.rows() != mesh.ny || mean_u.cols() != mesh.nx) reset(mesh);
+    samples++;
+    const double inv_n = 1.0 / static_cast<double>(samples);
+
+    // Welford：先用旧均值求偏差，更新均值后再乘新偏差
+    const ArrayXXd du = mesh.u_star.array() - mean_u.array();
+    const ArrayXXd dv = mesh.v_star.array() - mean_v.array();
+    const ArrayXXd dp = mesh.p.array()      - mean_p.array();
+    mean_u.array() += du * inv_n;
+    mean_v.array() += dv * inv_n;
+    mean_p.array() += dp * inv_n;
+    m_uu.array() += du * (mesh.u_star.array() - mean_u.array());
+    m_vv.array() += dv * (mesh.v_star.array() - mean_v.array());
+    m_uv.array() += du * (mesh.v_star.array() - mean_v.array());
+    m_pp.array() += dp * (mesh.p.array()      - mean_p.array());
+}
+
+void FlowStatistics::save(const Mesh& mesh, int rank, const std::string& folder) const
+{
+    if (samples == 0) return;
+    const double inv_n = 1.0 / static_cast<double>(samples);
+    try {
+        fs::path dir(folder);
+        fs::create_directories(dir);   // MPI-safe 幂等
+
+        auto write = [&](const std::string& name, const MatrixXd& field) {
+            fs::path p = dir / (name + "_" + std::to_string(rank) + ".dat");
+            std::ofstream f(p);
+            if (!f) throw std::runtime_error("无法创建文件: " + p.string());
+            f << field;
+        };
+
+        write("u_mean", mean_u);
+        write("v_mean", mean_v);
+        write("p_mean", mean_p);
+        write("uu", m_uu * inv_n);
+        write("vv", m_vv * inv_n);
+        write("uv", m_uv * inv_n);
+        write("pp", m_pp * inv_n);
+        write("xc", mesh.x_c);
+        write("yc", mesh.y_c);
+
+        if (rank == 0) {
+            std::ofstream info(dir / "samples.txt");
+            info << samples << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Rank " << rank << "] 保存统计量失败: " << e.what() << std::endl;
+        throw;
+    }
+}
+
+// ==================== 运行选项 ====================
+
+RunOptions::RunOptions(int argc, char* argv[], int first)
+{
+    for (int k = first; k < argc; ++k) {
+        std::string arg = argv[k];
+        if (arg.compare(0, 2, "--") != 0) {
+            std::cerr << "忽略无法识别的参数: " << arg << std::endl;
+            continue;
+        }
+        arg = arg.substr(2);
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) values[arg] = "1";
+        else                         values[arg.substr(0, eq)] = arg.substr(eq + 1);
+    }
+}
+
+bool RunOptions::has(const std::string& key) const
+{
+    return values.count(key) > 0;
+}
+
+int RunOptions::getInt(const std::string& key, int def) const
+{
+    auto it = values.find(key);
+    return (it == values.end()) ? def : std::stoi(it->second);
+}
+
+double RunOptions::getDouble(const std::string& key, double def) const
+{
+    auto it = values.find(key);
+    return (it == values.end()) ? def : std::stod(it->second);
+}
+
+std::string RunOptions::getString(const std::string& key, const std::string& def) const
+{
+    auto it = values.find(key);
+    return (it == values.end()) ? def : it->second;
+}
+
+bool RunOptions::getBool(const std::string& key, bool def) const
+{
+    auto it = values.find(key);
+    if (it == values.end()) return def;
+    const std::string& v = it->second;
+    return !(v == "0" || v == "false" || v == "off");
+}
+
+void RunOptions::print() const
+{
+    if (values.empty()) return;
+    std::cout << "==================== 运行选项 ====================" << std::endl;
+    for (const auto& kv : values)
+        std::cout << "  --" << kv.first << " = " << kv.second << std::endl;
+    std::cout << "==================================================\n" << std::endl;
+}
+
 // ==================== 辅助函数实现 ====================
 
 void parseInputParameters(int argc, char* argv[], std::string& mesh_folder, 
                          int& timesteps, double& mu, int& n_splits) 
 {
-    if (argc == 4) {
+    if (argc >= 4) {
         mesh_folder = argv[1];
         timesteps = std::stoi(argv[2]);
         mu = std::stod(argv[3]);
@@ -1769,7 +2582,8 @@ void printSimulationSetup(const std::vector<Mesh>& sub_meshes, int n_splits)
     std::cout << "总分割数: " << n_splits << " 个子网格" << std::endl;
     for (size_t i = 0; i < sub_meshes.size(); i++) {
         std::cout << "  子网格 " << i << " 尺寸: " 
-                  << sub_meshes[i].nx << " × " << sub_meshes[i].ny << std::endl;
+                  << sub_meshes[i].nx << " × " << sub_meshes[i].ny
+                  << (sub_meshes[i].uniform ? "  [均匀网格快速路径]" : "") << std::endl;
     }
     std::cout << "======================================================\n" << std::endl;
 }
@@ -1786,8 +2600,8 @@ bool checkConvergence(double norm_res_x, double norm_res_y, double norm_res_p)
 void parseInputParameters_unsteady(int argc, char* argv[], std::string& mesh_folder, 
                                    double& dt, int& timesteps, double& mu, int& n_splits) 
 {
-    if (argc == 5) {
-        // 命令行参数: mesh_folder dt timesteps mu n_splits
+    if (argc >= 5) {
+        // 命令行参数: mesh_folder dt timesteps mu [--选项...]
         mesh_folder = argv[1];
         dt = std::stod(argv[2]);
         timesteps = std::stoi(argv[3]);
@@ -1919,7 +2733,8 @@ void printSimulationSetup_unsteady(const std::vector<Mesh>& sub_meshes, int n_sp
     std::cout << "总分割数: " << n_splits << " 个子网格" << std::endl;
     for (size_t i = 0; i < sub_meshes.size(); i++) {
         std::cout << "  子网格 " << i << " 尺寸: " 
-                  << sub_meshes[i].nx << " × " << sub_meshes[i].ny << std::endl;
+                  << sub_meshes[i].nx << " × " << sub_meshes[i].ny
+                  << (sub_meshes[i].uniform ? "  [均匀网格快速路径]" : "") << std::endl;
     }
     std::cout << "------------------------------------------------------" << std::endl;
     std::cout << "时间离散信息:" << std::endl;
@@ -1929,3 +2744,85 @@ void printSimulationSetup_unsteady(const std::vector<Mesh>& sub_meshes, int n_sp
     std::cout << "======================================================\n" << std::endl;
 }
 
+// -------------------- 集合模式算例 --------------------
+std::vector<EnsembleCase> readEnsembleCases(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("无法打开集合算例文件: " + path);
+    }
+
+    std::vector<EnsembleCase> cases;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        ++line_no;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::istringstream ss(line);
+        EnsembleCase c;
+        if (!(ss >> c.mu >> c.dt) || c.dt <= 0.0) {
+            throw std::runtime_error("集合算例文件第 " + std::to_string(line_no)
+                                     + " 行格式错误（应为 <mu> <dt> [<zone> <u> <v>]...）");
+        }
+        int zone;
+        double zu, zv;
+        while (ss >> zone) {
+            if (!(ss >> zu >> zv) || zone < 0) {
+                throw std::runtime_error("集合算例文件第 " + std::to_string(line_no)
+                                         + " 行区域速度应为 <zone> <u> <v> 三元组");
+            }
+            c.zones.push_back(zone);
+            c.zone_u.push_back(zu);
+            c.zone_v.push_back(zv);
+        }
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+void broadcastEnsembleCases(std::vector<EnsembleCase>& cases, int rank)
+{
+    // 打包为 [mu, dt, nz, (zone, u, v)*nz]... 的扁平数组
+    std::vector<double> buf;
+    if (rank == 0) {
+        for (const EnsembleCase& c : cases) {
+            buf.push_back(c.mu);
+            buf.push_back(c.dt);
+            buf.push_back(static_cast<double>(c.zones.size()));
+            for (size_t z = 0; z < c.zones.size(); ++z) {
+                buf.push_back(c.zones[z]);
+                buf.push_back(c.zone_u[z]);
+                buf.push_back(c.zone_v[z]);
+            }
+        }
+    }
+    int len = static_cast<int>(buf.size());
+    MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    buf.resize(len);
+    MPI_Bcast(buf.data(), len, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) return;
+    cases.clear();
+    for (size_t k = 0; k < buf.size(); ) {
+        EnsembleCase c;
+        c.mu = buf[k++];
+        c.dt = buf[k++];
+        const int nz = static_cast<int>(buf[k++]);
+        for (int z = 0; z < nz; ++z) {
+            c.zones.push_back(static_cast<int>(buf[k++]));
+            c.zone_u.push_back(buf[k++]);
+            c.zone_v.push_back(buf[k++]);
+        }
+        cases.push_back(c);
+    }
+}
+
+std::string ensembleCaseFolder(int index, double mu)
+{
+    std::ostringstream ss;
+    ss << "ensemble/case_" << index << "_mu_" << std::fixed << std::setprecision(6) << mu;
+    return ss.str();
+}
+
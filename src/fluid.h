@@ -34,6 +34,8 @@
 #include <algorithm>
 #include <fstream>
 #include <vector>
+#include <map>
+#include <string>
 
 using namespace Eigen;
 using namespace std;
@@ -57,6 +59,36 @@ void printMatrix(const MatrixXd& matrix, const string& name, int precision = 4);
 // Mesh 类 —— 网格数据容器
 // ============================================================================
 
+/** @brief 活动单元面方向（东 / 西 / 北 / 南） */
+enum FaceDir { FACE_E = 0, FACE_W = 1, FACE_N = 2, FACE_S = 3 };
+
+/**
+ * @brief 内部点（线性方程组未知量）编号策略
+ *
+ * | 策略        | 说明                                              |
+ * |-------------|---------------------------------------------------|
+ * | ORDER_ROW   | 行优先（默认，原始编号）                          |
+ * | ORDER_COL   | 列优先，与 Eigen ColMajor 场存储顺序一致          |
+ * | ORDER_RCM   | 逆 Cuthill–McKee，减小矩阵带宽                    |
+ * | ORDER_TILED | order_tile×order_tile 分块，块内列优先            |
+ */
+enum CellOrdering { ORDER_ROW = 0, ORDER_COL = 1, ORDER_RCM = 2, ORDER_TILED = 3 };
+
+/**
+ * @brief 场数组的下标种类：单元中心、东面（与 u_face 同形）、南面（与 v_face 同形）
+ */
+enum FieldKind { FIELD_CELL = 0, FIELD_XFACE = 1, FIELD_YFACE = 2 };
+
+/**
+ * @brief 活动单元的一个边界面：单元 cell 在 dir 方向的邻居 (i,j) 不是内部点
+ */
+struct BoundaryFace {
+    int     cell;   ///< 活动单元内部编号
+    FaceDir dir;    ///< 面方向
+    int     i, j;   ///< 邻居单元行 / 列
+    int     type;   ///< 邻居 bctype（>0 壁面，-1 压力出口，-2 速度入口，-3 ghost）
+};
+
 /**
  * @class Mesh
  * @brief 存储结构化四边形网格的几何信息、场变量和边界条件
@@ -70,6 +102,13 @@ void printMatrix(const MatrixXd& matrix, const string& name, int precision = 4);
  * - 所有 ny×nx 矩阵按 (i=行, j=列) 存储
  * - u_face 大小为 ny×(nx-1)，位于相邻单元东面
  * - v_face 大小为 (ny-1)×nx，位于相邻单元南面
+ *
+ * 紧凑布局（useCompactLayout 之后，compact == true）：
+ * - 单元场（u、p、vol、x_c 等）与面场（u_face、v_face）均为 nstored×1 向量，
+ *   前 internumber 个元素即内部编号 k 的活动单元（interi / interj 映射回 (i,j)），
+ *   其后为与活动单元共面的边界 / 实体单元及全部 ghost 单元（ringi / ringj）
+ * - 东面 (i,j) 与南面 (i,j) 存放在西侧 / 北侧单元 (i,j) 的下标处
+ * - 统一通过 cell / xface / yface 取线性下标，两种布局下 f(mesh.cell(i,j)) 均有效
  */
 class Mesh {
 public:
@@ -110,15 +149,43 @@ public:
     MatrixXi interid; ///< 内部点全局编号（用于线性方程组组装），ny×nx
 
     int internumber;  ///< 内部点总数（线性方程组规模）
+    CellOrdering ordering = ORDER_ROW;  ///< createInterId 使用的编号策略
+    int order_tile = 16;                ///< ORDER_TILED 的分块边长
     int nx;           ///< x 方向单元数
     int ny;           ///< y 方向单元数
+    int col_offset = 0;  ///< 第 0 列（含 ghost）在原始网格中的列号（子网格由 splitMeshVertically 设置）
 
     vector<int> interi;  ///< 内部点行索引列表（与 interid 配套）
     vector<int> interj;  ///< 内部点列索引列表（与 interid 配套）
 
+    // ── 活动单元拓扑（createInterId 中建立，长度均为 internumber） ──────────
+    vector<int> nb_e;    ///< 东邻居的内部编号，非内部点为 -1
+    vector<int> nb_w;    ///< 西邻居的内部编号，非内部点为 -1
+    vector<int> nb_n;    ///< 北邻居的内部编号，非内部点为 -1
+    vector<int> nb_s;    ///< 南邻居的内部编号，非内部点为 -1
+    vector<BoundaryFace> bfaces;  ///< 活动单元与非活动单元（壁面/出入口/ghost）之间的面
+
+    // ── 粗化映射（coarsenMesh 建立并由 splitMeshVertically 切片；其余网格为空） ──
+    vector<int> fine_row0;  ///< 第 I 行覆盖细网格行 [fine_row0[I], fine_row0[I+1])，长度 ny+1
+    vector<int> fine_col0;  ///< 第 J 列覆盖细网格全局列 [fine_col0[J], fine_col0[J+1])，长度 nx+1
+
     vector<double> zoneu;  ///< 各区域指定的 x 方向速度（壁面/入口条件）
     vector<double> zonev;  ///< 各区域指定的 y 方向速度（壁面/入口条件）
 
+    // ── 均匀网格快速路径（initGeometry 中检测） ──────────────────────────
+    bool   uniform = false;  ///< 是否为坐标轴对齐的等间距网格
+    double dx = 0.0;         ///< 均匀网格：相邻单元中心 x 间距（带符号）
+    double dy = 0.0;         ///< 均匀网格：相邻单元中心 y 间距（带符号，行号增大方向）
+
+    // ── 紧凑场布局（--layout=compact，useCompactLayout 建立；矩形布局下为空） ──
+    bool compact = false;   ///< 场数组是否只存储活动单元及其边界环
+    int  nstored = 0;       ///< 紧凑布局存储的单元数（internumber + 边界环单元数）
+    MatrixXi cellid;        ///< (i,j) → 存储下标，未存储为 -1（ny×nx）
+    vector<int> ringi;      ///< 边界环单元行索引（存储下标 internumber + r）
+    vector<int> ringj;      ///< 边界环单元列索引
+    vector<int> xface_i, xface_j;  ///< 两侧单元均存储的东面，按行优先（与矩形扫描顺序一致）
+    vector<int> yface_i, yface_j;  ///< 两侧单元均存储的南面，按行优先
+
     // ── 构造函数 ──────────────────────────────────────────────────────────
 
     /** @brief 默认构造函数（允许延迟初始化） */
@@ -162,15 +229,68 @@ public:
      *
      * @details 依赖节点坐标矩阵 x / y 已经正确填充。
      *          体积采用对角线叉积公式：vol = 0.5|d1×d2|
+     *          最后调用 detectUniform() 判断是否可走均匀网格快速路径。
      */
     void initGeometry();
 
+    /**
+     * @brief 检测网格是否为坐标轴对齐的等间距网格，并设置 uniform / dx / dy
+     *
+     * @details 判据：x 仅随列变化、y 仅随行变化，且相邻节点间距在
+     *          相对误差 1e-10 内处处相等。
+     */
+    void detectUniform();
+
     /**
      * @brief 遍历 bctype，为所有内部点（bctype==0）分配连续编号，
      *        并填充 interid、interi、interj、internumber
+     *
+     * @details 编号顺序由 ordering 决定（默认行优先）；interid、interi/interj、
+     *          矩阵行号与求解向量下标始终一致。结束时调用 buildActiveTopology()
+     *          建立邻居数组与边界面列表。
      */
     void createInterId();
 
+    /** @brief 按逆 Cuthill–McKee 重排 interi / interj（由 createInterId 调用） */
+    void reorderRCM();
+
+    /**
+     * @brief 由 interi / interj 建立活动单元邻居数组 nb_* 与边界面列表 bfaces
+     *
+     * @details 离散内核、矩阵组装与并行修正只遍历活动单元 / 边界面，
+     *          扫描开销随流体单元数而非包围矩形缩放。
+     *          矩形布局下场数组仍按 ny×nx 存储（内存随包围矩形缩放），
+     *          只存储活动单元的紧凑布局见 useCompactLayout()。
+     */
+    void buildActiveTopology();
+
+    /**
+     * @brief 切换为紧凑布局：场数组只保留活动单元与边界环
+     *
+     * @details 存储集合为活动单元（下标即内部编号）、与活动单元共面的非活动单元
+     *          以及全部 ghost 单元；边界环按行优先追加在活动单元之后。
+     *          须在 createInterId / initializeBoundaryConditions / initGeometry 之后调用，
+     *          之后场数组与面数组的内存随流体单元数而非包围矩形缩放。
+     *          节点坐标 x / y 与整型标记数组（bctype、zoneid、interid、cellid）仍为矩形，
+     *          结果输出（saveMeshData）需要节点坐标恢复实体区单元中心。
+     */
+    void useCompactLayout();
+
+    // ── 布局无关的场访问 ──────────────────────────────────────────────────
+
+    /** @brief 单元 (i,j) 在单元场中的线性下标（紧凑布局下未存储为 -1） */
+    int cell(int i, int j) const { return compact ? cellid(i, j) : i + j * ny; }
+
+    /** @brief 东面 (i,j) 在 u_face 同形场中的线性下标 */
+    int xface(int i, int j) const { return compact ? cellid(i, j) : i + j * ny; }
+
+    /** @brief 南面 (i,j) 在 v_face 同形场中的线性下标 */
+    int yface(int i, int j) const { return compact ? cellid(i, j) : i + j * (ny - 1); }
+
+    /** @brief 当前布局下 kind 类场数组的行数 / 列数（紧凑布局为 nstored×1） */
+    int fieldRows(FieldKind kind = FIELD_CELL) const { return compact ? nstored : ny - (kind == FIELD_YFACE); }
+    int fieldCols(FieldKind kind = FIELD_CELL) const { return compact ? 1 : nx - (kind == FIELD_XFACE); }
+
     // ── 辅助设置方法 ──────────────────────────────────────────────────────
 
     /**
@@ -206,6 +326,135 @@ public:
 };
 
 
+// ============================================================================
+// 场布局策略 —— 离散内核按模板参数特化
+// ============================================================================
+
+/**
+ * @brief 矩形布局：场为 ny×nx（面场 ny×(nx−1) / (ny−1)×nx）列优先矩阵
+ *
+ * 线性下标 i + j·rows 与 Eigen 的 (i,j) 访问指向同一元素；面循环扫描整个面矩形。
+ */
+struct RectLayout {
+    int ny;
+
+    explicit RectLayout(const Mesh& m) : ny(m.ny) {}
+
+    template <int Kind> int index(int i, int j) const
+    { return i + j * (Kind == FIELD_YFACE ? ny - 1 : ny); }
+
+    template <class F> void forXFaces(const Mesh& m, F&& f) const
+    { for (int i = 0; i < m.ny; i++) for (int j = 0; j < m.nx - 1; j++) f(i, j); }
+
+    template <class F> void forYFaces(const Mesh& m, F&& f) const
+    { for (int i = 0; i < m.ny - 1; i++) for (int j = 0; j < m.nx; j++) f(i, j); }
+};
+
+/**
+ * @brief 紧凑布局：场为 nstored×1 向量，下标取自 cellid
+ *
+ * 东 / 南面存放在西 / 北侧单元的下标处；面循环只走 xface_* / yface_* 列表
+ * （两侧单元均存储的面，顺序与矩形扫描一致）。
+ */
+struct CompactLayout {
+    const int* id;   ///< cellid 数据（列优先）
+    int ny;
+
+    explicit CompactLayout(const Mesh& m) : id(m.cellid.data()), ny(m.ny) {}
+
+    template <int Kind> int index(int i, int j) const { return id[i + j * ny]; }
+
+    template <class F> void forXFaces(const Mesh& m, F&& f) const
+    { for (size_t k = 0; k < m.xface_i.size(); k++) f(m.xface_i[k], m.xface_j[k]); }
+
+    template <class F> void forYFaces(const Mesh& m, F&& f) const
+    { for (size_t k = 0; k < m.yface_i.size(); k++) f(m.yface_i[k], m.yface_j[k]); }
+};
+
+/**
+ * @brief 按 (i,j) 访问场数组的轻量视图，下标由布局给出
+ *
+ * 内核中 u(i,j) 等写法在两种布局下保持不变。
+ */
+template <class Layout, int Kind, class T = double>
+struct FieldView {
+    T*     d;
+    Layout l;
+
+    T& operator()(int i, int j) const { return d[l.template index<Kind>(i, j)]; }
+};
+
+template <int Kind, class Layout>
+FieldView<Layout, Kind> view(const Layout& l, MatrixXd& f) { return { f.data(), l }; }
+
+template <int Kind, class Layout>
+FieldView<Layout, Kind, const double> view(const Layout& l, const MatrixXd& f) { return { f.data(), l }; }
+
+
+// ============================================================================
+// 几何访问策略 —— 离散内核按模板参数特化
+// ============================================================================
+
+/**
+ * @brief 一般四边形网格：逐单元读取 x_c / y_c / area_* / vol
+ *
+ * dist_e(i,j) 为单元 (i,j) 到东侧单元中心的距离，其余同理；
+ * 与原内核中 x_c(i,j+1) - x_c(i,j) 等写法逐一对应。
+ */
+template <class Layout>
+struct GeneralGeometry {
+    using View = FieldView<Layout, FIELD_CELL, const double>;
+    View x_c;
+    View y_c;
+    View ae;
+    View aw;
+    View as;
+    View an;
+    View v;
+
+    GeneralGeometry(const Mesh& m, const Layout& l)
+        : x_c(view<FIELD_CELL>(l, m.x_c)), y_c(view<FIELD_CELL>(l, m.y_c)),
+          ae(view<FIELD_CELL>(l, m.area_e)), aw(view<FIELD_CELL>(l, m.area_w)),
+          as(view<FIELD_CELL>(l, m.area_s)), an(view<FIELD_CELL>(l, m.area_n)),
+          v(view<FIELD_CELL>(l, m.vol)) {}
+
+    double dist_e(int i, int j) const { return x_c(i, j+1) - x_c(i, j); }
+    double dist_w(int i, int j) const { return x_c(i, j) - x_c(i, j-1); }
+    double dist_s(int i, int j) const { return y_c(i+1, j) - y_c(i, j); }
+    double dist_n(int i, int j) const { return y_c(i, j) - y_c(i-1, j); }
+    double area_e(int i, int j) const { return ae(i, j); }
+    double area_w(int i, int j) const { return aw(i, j); }
+    double area_s(int i, int j) const { return as(i, j); }
+    double area_n(int i, int j) const { return an(i, j); }
+    double vol(int i, int j)    const { return v(i, j); }
+};
+
+/**
+ * @brief 均匀笛卡尔网格：间距、面积、体积均为常量
+ *
+ * 内核只读取解与系数数组，几何量在内联后成为循环不变量。
+ */
+struct UniformGeometry {
+    double dx, dy;       ///< 单元中心间距（带符号）
+    double ax, ay;       ///< 东西面长度 |dy|，南北面长度 |dx|
+    double cell_vol;     ///< 单元体积 |dx·dy|
+
+    explicit UniformGeometry(const Mesh& m)
+        : dx(m.dx), dy(m.dy), ax(std::abs(m.dy)), ay(std::abs(m.dx)),
+          cell_vol(std::abs(m.dx * m.dy)) {}
+
+    double dist_e(int, int) const { return dx; }
+    double dist_w(int, int) const { return dx; }
+    double dist_s(int, int) const { return dy; }
+    double dist_n(int, int) const { return dy; }
+    double area_e(int, int) const { return ax; }
+    double area_w(int, int) const { return ax; }
+    double area_s(int, int) const { return ay; }
+    double area_n(int, int) const { return ay; }
+    double vol(int, int)    const { return cell_vol; }
+};
+
+
 // ============================================================================
 // Equation 类 —— 离散线性方程组容器
 // ============================================================================
@@ -223,19 +472,28 @@ public:
  */
 class Equation {
 public:
-    // ── 离散系数（五点格式，ny×nx） ──────────────────────────────────────
+    // ── 离散系数（五点格式，ny×nx；紧凑布局下与单元场同形） ────────────
     MatrixXd A_p;  ///< 中心系数（对角项）
     MatrixXd A_e;  ///< 东向系数（离轴项）
     MatrixXd A_w;  ///< 西向系数（离轴项）
     MatrixXd A_n;  ///< 北向系数（离轴项）
     MatrixXd A_s;  ///< 南向系数（离轴项）
 
+    // ── 动量方程面通量（每个面只算一次，首次组装时分配；只填写与活动单元相邻的面） ──
+    MatrixXd D_x;  ///< 东面扩散导数 μ·A_e/δx_e（与 u_face 同形）
+    MatrixXd F_x;  ///< 东面质量流量 A_e·u_face
+    MatrixXd L_x;  ///< 东面两侧单元中心距离 δx_e（压力梯度源项用）
+    MatrixXd D_y;  ///< 南面扩散导数 μ·A_s/δy_s（与 v_face 同形）
+    MatrixXd F_y;  ///< 南面质量流量 A_s·v_face
+    MatrixXd L_y;  ///< 南面两侧单元中心距离 δy_s（压力梯度源项用）
+
     VectorXd source;          ///< 右端源项向量（长度 = internumber）
     SparseMatrix<double> A;   ///< 组装后的稀疏系数矩阵（internumber × internumber）
 
     int n_x;  ///< 所关联网格的 nx
     int n_y;  ///< 所关联网格的 ny
     Mesh& mesh;  ///< 关联的网格对象引用
+    bool assemble_sparse = true;  ///< build_matrix 是否组装 A（批量求解只读五点系数，可关闭）
 
     /**
      * @brief 构造函数，按网格尺寸分配所有矩阵和向量
@@ -253,6 +511,7 @@ public:
      * 仅遍历 bctype==0 的内部点，邻居若为边界点则不添加对应列项
      * （边界贡献已在 momentum_function / pressure_function 中并入源项）。
      *
+     * assemble_sparse 为 false 时直接返回（A 保持上次组装结果）。
      */
     void build_matrix();
 };
@@ -295,6 +554,8 @@ void face_velocity(Mesh& mesh, Equation& equ_u);
  *
  * @details
  * 采用一阶迎风对流格式和中心差分扩散格式，同时处理全部边界类型。
+ * 各面的扩散导数、质量流量与中心距离先按面计算一次（equ_u.D_x/F_x/L_x 等），相邻两单元共用；
+ * 面循环由 nb_e / nb_s 与 bfaces 驱动，只计算与活动单元相邻的面。
  * 完成后自动将 u、v 方程的系数矩阵同步（equ_v 共享 equ_u 的系数），
  * 并调用 build_matrix() 组装稀疏矩阵。
  *
@@ -392,7 +653,7 @@ void show_progress_bar(int current_step, int total_steps, double elapsed_time);
  * 1. 尽量均匀分配：widths[k] ≈ nx / n
  * 2. 在接口处各添加 2 列 ghost 层（bctype=-3），用于通信边界插值
  * 3. 子网格完整继承原始网格的 zoneu/zonev 边界速度配置
- * 4. 各子网格独立调用 initGeometry() 和 createInterId()
+ * 4. 各子网格继承 ordering / order_tile，独立调用 initGeometry() 和 createInterId()
  *
  * 子网格列数：real_w + left_ghost(0或2) + right_ghost(0或2)
  *
@@ -402,6 +663,151 @@ void show_progress_bar(int current_step, int total_steps, double elapsed_time);
  */
 vector<Mesh> splitMeshVertically(const Mesh& original, int n);
 
+/** @brief 由名称（row / col / rcm / tiled）解析编号策略，未知名称抛出异常 */
+CellOrdering parseCellOrdering(const std::string& name);
+
+/**
+ * @brief 按给定的各段真实列宽分割网格
+ *
+ * @details
+ * splitMeshVertically(original, n) 的底层实现：widths 之和必须等于 nx，
+ * 且每段宽度 ≥ 2（ghost 交换需要两列真实单元）。
+ *
+ * @param original  原始完整网格（只读）
+ * @param widths    各子网格的真实列数（不含 ghost）
+ */
+vector<Mesh> splitMeshVertically(const Mesh& original, const vector<int>& widths);
+
+/**
+ * @brief 计算每一列的计算负载
+ *
+ * @details
+ * 默认每个流体单元（bctype==0）计 1，其余单元计 solid_cost。
+ * 若 cell_cost 非空（ny×nx，如实测的单元耗时），则直接按其逐列求和。
+ *
+ * @param original    原始完整网格
+ * @param solid_cost  非流体单元的相对代价（通常为 0）
+ * @param cell_cost   可选的逐单元代价矩阵
+ * @return            长度为 nx 的列负载
+ */
+vector<double> columnWorkload(const Mesh& original, double solid_cost,
+                              const MatrixXd& cell_cost = MatrixXd());
+
+/**
+ * @brief 按列负载做一维前缀和划分，使各段负载尽量相等
+ *
+ * @details
+ * 第 k 个切点取前缀和最接近 k·W/n 的列边界，并约束每段宽度 ≥ min_width。
+ *
+ * @param col_weight  每列负载（见 columnWorkload）
+ * @param n           分割数
+ * @param min_width   每段最少列数
+ * @return            各段真实列宽
+ */
+vector<int> weightedWidths(const vector<double>& col_weight, int n, int min_width = 2);
+
+/** @brief 均匀列宽：widths[k] ≈ nx / n（原 splitMeshVertically 的策略） */
+vector<int> uniformWidths(int nx, int n);
+
+/**
+ * @brief 打印各段的列数、流体单元数、负载与负载不均衡度
+ *
+ * 不均衡度 = 最大段负载 / 平均段负载（1.0 为完全均衡）。
+ *
+ * @return 不均衡度
+ */
+double reportPartitionBalance(const Mesh& original, const vector<int>& widths,
+                              const vector<double>& col_weight);
+
+
+// ============================================================================
+// 合成网格生成（基准测试 / 扩展性测试用，无需磁盘网格文件）
+// ============================================================================
+
+/**
+ * @brief 在内存中生成顶盖驱动方腔网格（与 gen.ipynb 的布局一致）
+ *
+ * @details
+ * - 四周一圈单元为无滑移壁面（bctype=1），第 0 行为顶盖（zoneid=1）
+ * - zone 0 速度为 (0,0)，zone 1 速度为 (lid_u, 0)
+ * - stretch > 0 时采用 gen.ipynb 中的两端指数加密（exp_stretch），
+ *   stretch == 0 时为均匀网格
+ *
+ * 返回的网格已完成 createInterId / initializeBoundaryConditions / initGeometry，
+ * 与 Mesh(folderPath) 构造结果等价。
+ *
+ * @param nx       x 方向单元数（含壁面列）
+ * @param ny       y 方向单元数（含壁面行）
+ * @param Lx,Ly    计算域尺寸
+ * @param lid_u    顶盖速度
+ * @param stretch  指数拉伸系数（0 表示均匀）
+ */
+Mesh makeCavityMesh(int nx, int ny, double Lx = 1.0, double Ly = 1.0,
+                    double lid_u = 1.0, double stretch = 0.0);
+
+/**
+ * @brief 按网格描述字符串加载网格
+ *
+ * @details
+ * - "cavity:<nx>x<ny>"  ：调用 makeCavityMesh 在内存中生成均匀方腔网格
+ * - 其他                 ：视为网格文件夹路径，等价于 Mesh(spec)
+ *
+ * @param spec 网格描述字符串（即命令行中的 mesh_folder 参数）
+ * @throws std::runtime_error 若描述格式错误或文件夹不存在
+ */
+Mesh loadMesh(const std::string& spec);
+
+/**
+ * @brief 将网格在两个方向上各粗化约 2 倍（网格序列与 FAS 多重网格）
+ *
+ * @details
+ * 每个方向分别把相邻两行 / 两列合并为一个粗行 / 粗列，但只合并 bctype 与 zoneid
+ * 完全相同的两列（行同理）；不能合并的列单独成为一个粗列。四周的壁面 / 出入口层
+ * 因此保持为一层、位置不变，粗单元不会同时含有边界与内部子单元，
+ * 各级网格求解的是同一个区域上的同一个问题。
+ * - 粗网格节点取各组首尾的细网格节点；fine_row0 / fine_col0 记录组的划分
+ * - bctype / zoneid 取自子单元（同组子单元完全相同）
+ * - zoneu / zonev、ordering / order_tile 原样继承
+ *
+ * 只用于未分割的全局网格（不含 bctype = -3 的 ghost 列）。返回的网格已完成
+ * createInterId / initializeBoundaryConditions / initGeometry。
+ */
+Mesh coarsenMesh(const Mesh& fine);
+
+/**
+ * @brief 将粗网格上的 u_star / v_star / p 插值到细网格（coarsenMesh 的逆操作）
+ *
+ * @details
+ * 对每个细网格内部点，以其单元中心坐标在父单元及相邻粗单元中心之间做双线性插值，
+ * 权重只在粗网格内部点上归一化（不跨越壁面外插）。写入 u / u_star、v / v_star、
+ * p / p_star；两侧均为内部点的面速度 u_face / v_face 取相邻单元的平均值。
+ * 细网格边界单元保持不变。
+ */
+void prolongFields(const Mesh& coarse, Mesh& fine);
+
+/**
+ * @brief 细网格单元场限制到粗网格（FAS 多重网格）
+ *
+ * @details
+ * 粗单元取其子单元（由 fine_row0 / fine_col0 给出，至多 2×2 个）之和
+ * （average = false，用于按体积积分的残差）或体积加权平均（average = true，用于 u / v / p）。fine_bc / coarse_bc 为两级网格
+ * 各列的真实边界类型（子网格的 ghost 列也给出原始类型），只写 coarse_bc == 0 的单元。
+ *
+ * 两级均可为子网格，但须按列对齐分割：粗网格真实列的子单元须落在细网格的
+ * 真实列或右侧 ghost 列内（ghost 列的值须已交换）。只写粗网格真实列。
+ */
+void restrictField(const Mesh& fine, const MatrixXi& fine_bc, const MatrixXd& f,
+                   const Mesh& coarse, const MatrixXi& coarse_bc, MatrixXd& c, bool average);
+
+/**
+ * @brief 粗网格修正量双线性插值后累加到细网格（ef += P·ec，FAS 多重网格）
+ *
+ * @details 插值模板与 prolongFields 相同，权重只在 coarse_bc == 0 的粗单元上归一化；
+ *          只写细网格内部点。ec 的 ghost 列须已交换。
+ */
+void prolongCorrection(const Mesh& coarse, const MatrixXi& coarse_bc, const MatrixXd& ec,
+                       const Mesh& fine, MatrixXd& ef);
+
 
 // ============================================================================
 // 文件 I/O 函数
@@ -418,6 +824,10 @@ vector<Mesh> splitMeshVertically(const Mesh& original, int n);
  * - xc_<rank>.dat : 单元中心 x 坐标
  * - yc_<rank>.dat : 单元中心 y 坐标
  *
+ * 紧凑布局下逐场展开为 ny×nx 矩阵再写出，文件格式与矩形布局相同：
+ * 未存储的实体单元 u / v / p 写 0（定常求解器初始化时置零、内核不再写入，
+ * 与矩形布局一致），单元中心由节点坐标计算。
+ *
  * @param mesh             网格对象（只读）
  * @param rank             当前 MPI 进程编号（用于文件命名）
  * @param timestep_folder  输出目录（默认为空，表示当前目录）
@@ -444,6 +854,131 @@ void saveMeshData(const Mesh& mesh, int rank,
 void saveforecastData(const Mesh& mesh, int rank, int timestep, double mu);
 
 
+// ============================================================================
+// 时间平均统计量
+// ============================================================================
+
+/**
+ * @class FlowStatistics
+ * @brief 非定常计算中在线累积的时间平均与二阶矩（Welford 算法）
+ *
+ * @details
+ * 每次 update() 以 u_star / v_star / p 为样本，逐单元更新：
+ * - 均值：ū += (u − ū_old) / n
+ * - 二阶中心矩：M_uu += (u − ū_old)(u − ū_new)，M_uv += (u − ū_old)(v − v̄_new)
+ *
+ * 与"逐步落盘 + 后处理求和"相比只需常数内存，且无大数相减的舍入损失。
+ * save() 输出（位于 folder/ 下，按进程编号分文件）：
+ * - u_mean / v_mean / p_mean ：时间平均场
+ * - uu / vv / uv / pp        ：方差与雷诺应力 M / n（总体方差）
+ * - xc / yc                  ：单元中心坐标（便于后处理）
+ */
+class FlowStatistics {
+public:
+    long samples = 0;  ///< 已累积的样本数
+
+    /** @brief 按网格尺寸分配并清零累积量 */
+    void reset(const Mesh& mesh);
+
+    /** @brief 以当前 u_star / v_star / p 为一个样本更新累积量 */
+    void update(const Mesh& mesh);
+
+    /**
+     * @brief 输出当前累积结果
+     * @param mesh    网格对象（提供单元中心坐标）
+     * @param rank    MPI 进程编号（用于文件命名）
+     * @param folder  输出目录
+     * @throws std::runtime_error 若文件无法创建
+     */
+    void save(const Mesh& mesh, int rank, const std::string& folder) const;
+
+    /// 累积量个数：均值 u / v / p 与二阶矩 uu / vv / uv / pp（检查点按此顺序读写）
+    static constexpr int NACC = 7;
+
+    /** @brief 第 k 个累积量（ny×nx，须先 reset），供检查点读写 */
+    MatrixXd&       accumulator(int k);
+    const MatrixXd& accumulator(int k) const;
+
+private:
+    MatrixXd mean_u, mean_v, mean_p;
+    MatrixXd m_uu, m_vv, m_uv, m_pp;
+};
+
+
+// ============================================================================
+// 运行选项
+// ============================================================================
+
+/**
+ * @class RunOptions
+ * @brief 位置参数之后的可选命令行参数（--key=value 或 --flag）
+ *
+ * @details
+ * 例：`./solver_simple_steady ldc_uni 500 0.01 --fixed-iters --save-interval=0`
+ * - `--flag`        等价于 `--flag=1`
+ * - 未识别的键不会报错，由各主程序按需读取
+ *
+ * 常用选项：
+ * | 选项               | 说明                                        |
+ * |--------------------|---------------------------------------------|
+ * | --fixed-iters      | 关闭收敛 / 停滞提前退出，固定迭代次数       |
+ * | --save-interval=N  | 每 N 步保存结果（0 表示仅最终保存）         |
+ * | --no-output        | 不写任何结果文件                            |
+ * | --quiet            | 关闭逐步残差与 PCG 日志                     |
+ * | --perf             | 结束时输出 PERF 性能记录行                  |
+ * | --counters         | 按内核输出硬件计数（IPC / 带宽 / 算术强度） |
+ * | --simple-iters=N   | 非定常：每个时间步的 SIMPLE 迭代次数        |
+ * | --partition=MODE   | uniform（默认）或 weighted（按负载划分）    |
+ * | --sequencing=L     | 定常：L 级粗网格序列求解作为初场            |
+ * | --fas=L            | 定常：L 级 FAS 非线性多重网格修正           |
+ * | --uv-solve=fused   | u、v 动量方程同步求解（共享通信）           |
+ */
+class RunOptions {
+public:
+    RunOptions() = default;
+
+    /**
+     * @brief 从 argv[first..argc-1] 解析选项
+     * @param argc   main 函数 argc
+     * @param argv   main 函数 argv
+     * @param first  第一个可选参数的下标（位置参数个数 + 1）
+     */
+    RunOptions(int argc, char* argv[], int first);
+
+    bool        has(const std::string& key) const;
+    int         getInt(const std::string& key, int def) const;
+    double      getDouble(const std::string& key, double def) const;
+    std::string getString(const std::string& key, const std::string& def) const;
+
+    /** @brief 布尔选项：出现即为真，值为 0 / false / off 时为假 */
+    bool        getBool(const std::string& key, bool def) const;
+
+    /** @brief 打印已设置的选项（rank 0 调用） */
+    void print() const;
+
+private:
+    std::map<std::string, std::string> values;
+};
+
+/**
+ * @brief 根据可选参数划分网格（主程序入口）
+ *
+ * @details
+ * | 选项                  | 说明                                          |
+ * |-----------------------|-----------------------------------------------|
+ * | --partition=weighted  | 按列负载划分（默认 uniform，均分列数）        |
+ * | --solid-cost=C        | 非流体单元的相对代价（默认 0）                |
+ * | --cost-file=FILE      | ny×nx 逐单元代价（文本），覆盖默认代价模型    |
+ *
+ * @param original  原始完整网格
+ * @param n         分割数
+ * @param opts      可选参数
+ * @param report    为 true 时打印负载均衡报告（rank 0）
+ */
+vector<Mesh> partitionMesh(const Mesh& original, int n, const RunOptions& opts,
+                           bool report);
+
+
 // ============================================================================
 // 稳态求解器辅助函数
 // ============================================================================
@@ -583,4 +1118,49 @@ void printSimulationSetup_unsteady(const std::vector<Mesh>& sub_meshes, int n_sp
                                    double dt, int timesteps);
 
 
+// ============================================================================
+// 集合模式（多算例并行）
+// ============================================================================
+
+/**
+ * @brief 集合模式中一个算例的参数（mu、dt 与可选的区域速度覆盖）
+ */
+struct EnsembleCase {
+    double mu = 0.0;              ///< 动力粘度
+    double dt = 0.0;              ///< 时间步长
+    std::vector<int>    zones;    ///< 需覆盖速度的区域编号（如入口 zone）
+    std::vector<double> zone_u;   ///< 对应区域的 x 方向速度
+    std::vector<double> zone_v;   ///< 对应区域的 y 方向速度
+};
+
+/**
+ * @brief 读取集合算例文件
+ *
+ * @details
+ * 每个非空、非 '#' 开头的行描述一个算例：
+ * @code
+ *   <mu> <dt> [<zone> <u> <v>]...
+ * @endcode
+ * 其后可跟任意组 (zone, u, v) 三元组，覆盖网格 zoneuv.txt 中对应区域的速度。
+ *
+ * @param path  算例文件路径
+ * @return 按文件顺序排列的算例列表
+ * @throws std::runtime_error 若文件无法打开或某行格式错误
+ */
+std::vector<EnsembleCase> readEnsembleCases(const std::string& path);
+
+/**
+ * @brief 将 rank 0 读取的算例列表广播到 MPI_COMM_WORLD 内所有进程
+ *
+ * @param cases  rank 0 上为输入，其他进程上为输出
+ * @param rank   当前进程在 MPI_COMM_WORLD 中的编号
+ */
+void broadcastEnsembleCases(std::vector<EnsembleCase>& cases, int rank);
+
+/**
+ * @brief 集合模式下算例的结果目录：ensemble/case_<index>_mu_<mu>
+ */
+std::string ensembleCaseFolder(int index, double mu);
+
+
 #endif // FLUID_H
\ No newline at end of file
@@ -1,4 +1,18 @@
 #include "parallel.h"
+#include <eigen3/Eigen/Eigenvalues>
+#include <filesystem>
+#include <sstream>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
 
 
 // 定义全局变量
@@ -6,12 +20,89 @@ double total_comm_time = 0.0; // 通信时间
 int total_comm_count = 0;     // 通信次数
 double start_time, end_time;
 int totalcount = 0;  
+SolverStats solver_stats;
+ReductionOverlap reduction_overlap;
+
+// 计时的 MPI_Allreduce（计入 total_comm_time）
+static inline void timedAllreduce(const void* sendbuf, void* recvbuf, int count,
+                                  MPI_Datatype type, MPI_Op op, MPI_Comm comm) {
+    double t0 = MPI_Wtime();
+    MPI_Allreduce(sendbuf, recvbuf, count, type, op, comm);
+    total_comm_time += MPI_Wtime() - t0;
+    total_comm_count++;
+}
+
+// 非阻塞求和 Allreduce：start() 与 finish() 之间安排与结果无关的本地计算。
+// MPI-4 起使用持久化集合通信（每次求解初始化一次，迭代中只 MPI_Start），
+// 否则每次发起 MPI_Iallreduce。缓冲区地址在对象生命周期内固定。
+class AsyncAllreduce {
+public:
+    AsyncAllreduce(const double* send, double* recv, int count, MPI_Comm comm)
+        : send_(send), recv_(recv), count_(count), comm_(comm)
+    {
+#if MPI_VERSION >= 4
+        MPI_Allreduce_init(send_, recv_, count_, MPI_DOUBLE, MPI_SUM, comm_,
+                           MPI_INFO_NULL, &req_);
+#endif
+    }
+    ~AsyncAllreduce()
+    {
+#if MPI_VERSION >= 4
+        MPI_Request_free(&req_);
+#endif
+    }
+    AsyncAllreduce(const AsyncAllreduce&) = delete;
+    AsyncAllreduce& operator=(const AsyncAllreduce&) = delete;
+
+    void start()
+    {
+#if MPI_VERSION >= 4
+        MPI_Start(&req_);
+#else
+        MPI_Iallreduce(send_, recv_, count_, MPI_DOUBLE, MPI_SUM, comm_, &req_);
+#endif
+        t_start_ = MPI_Wtime();
+    }
+
+    void finish()
+    {
+        const double t0 = MPI_Wtime();
+        int done = 0;
+        MPI_Test(&req_, &done, MPI_STATUS_IGNORE);
+        if (!done) MPI_Wait(&req_, MPI_STATUS_IGNORE);
+        const double t1 = MPI_Wtime();
+        reduction_overlap.reductions++;
+        reduction_overlap.completed += done;
+        reduction_overlap.window    += t0 - t_start_;
+        reduction_overlap.wait      += t1 - t0;
+        total_comm_time += t1 - t0;
+        total_comm_count++;
+    }
+
+private:
+    const double* send_;
+    double*       recv_;
+    int           count_;
+    MPI_Comm      comm_;
+    MPI_Request   req_ = MPI_REQUEST_NULL;
+    double        t_start_ = 0.0;
+};
+
+// 记录一次求解的统计信息
+static void recordSolve(int iter, int exit_status, double r_init, double r_final) {
+    solver_stats.iterations  = iter;
+    solver_stats.exit_status = exit_status;
+    solver_stats.r_initial   = r_init;
+    solver_stats.r_final     = r_final;
+    solver_stats.total_iterations += iter;
+    solver_stats.total_solves++;
+}
 
 
 
 
 //超高性能的列交换函数
-void exchangeColumns(MatrixXd& matrix, int rank, int num_procs) {
+void exchangeColumns(MatrixXd& matrix, int rank, int num_procs, MPI_Comm comm) {
     const int rows = matrix.rows();
     const int cols = matrix.cols();
     const int count = rows * 2; // 每次交换2列
@@ -25,16 +116,21 @@ void exchangeColumns(MatrixXd& matrix, int rank, int num_procs) {
     VectorXd send_right = Map<VectorXd>(matrix.block(0, cols - 4, rows, 2).data(), count);
     VectorXd recv_left(count), recv_right(count);
 
+    double t0 = MPI_Wtime();
+
     // 使用 Sendrecv 
     // 向左发，从左收
     MPI_Sendrecv(send_left.data(),  count, MPI_DOUBLE, left_rank,  0,
                  recv_left.data(),  count, MPI_DOUBLE, left_rank,  1, 
-                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                 comm, MPI_STATUS_IGNORE);
 
     // 向右发，从右收
     MPI_Sendrecv(send_right.data(), count, MPI_DOUBLE, right_rank, 1,
                  recv_right.data(), count, MPI_DOUBLE, right_rank, 0, 
-                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                 comm, MPI_STATUS_IGNORE);
+
+    total_comm_time += MPI_Wtime() - t0;
+    total_comm_count++;
 
     // 写回数据
     if (left_rank != MPI_PROC_NULL)
@@ -43,67 +139,128 @@ void exchangeColumns(MatrixXd& matrix, int rank, int num_procs) {
     if (right_rank != MPI_PROC_NULL)
         matrix.block(0, cols - 2, rows, 2) = Map<MatrixXd>(recv_right.data(), rows, 2);
 }
+
+// 按网格布局交换 ghost 列：矩形布局直接交换整列；紧凑布局经 cellid 打包，
+// 未存储的单元按 0 发送（矩形布局中这些位置同样为 0），报文与矩形布局逐位相同
+void exchangeColumns(MatrixXd& field, const Mesh& mesh, int rank, int num_procs, MPI_Comm comm) {
+    if (!mesh.compact) {
+        exchangeColumns(field, rank, num_procs, comm);
+        return;
+    }
+    const int ny = mesh.ny;
+    const int nx = mesh.nx;
+    const int count = ny * 2;
+
+    int left_rank  = (rank == 0) ? MPI_PROC_NULL : rank - 1;
+    int right_rank = (rank == num_procs - 1) ? MPI_PROC_NULL : rank + 1;
+
+    VectorXd send_left(count), send_right(count), recv_left(count), recv_right(count);
+    for (int c = 0; c < 2; ++c) {
+        for (int i = 0; i < ny; ++i) {
+            const int l = mesh.cellid(i, 2 + c);
+            const int r = mesh.cellid(i, nx - 4 + c);
+            send_left[i + c * ny]  = (l >= 0) ? field(l) : 0.0;
+            send_right[i + c * ny] = (r >= 0) ? field(r) : 0.0;
+        }
+    }
+
+    double t0 = MPI_Wtime();
+    MPI_Sendrecv(send_left.data(),  count, MPI_DOUBLE, left_rank,  0,
+                 recv_left.data(),  count, MPI_DOUBLE, left_rank,  1,
+                 comm, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(send_right.data(), count, MPI_DOUBLE, right_rank, 1,
+                 recv_right.data(), count, MPI_DOUBLE, right_rank, 0,
+                 comm, MPI_STATUS_IGNORE);
+    total_comm_time += MPI_Wtime() - t0;
+    total_comm_count++;
+
+    for (int c = 0; c < 2; ++c) {
+        for (int i = 0; i < ny; ++i) {
+            const int l = mesh.cellid(i, c);
+            const int r = mesh.cellid(i, nx - 2 + c);
+            if (left_rank != MPI_PROC_NULL && l >= 0)  field(l) = recv_left[i + c * ny];
+            if (right_rank != MPI_PROC_NULL && r >= 0) field(r) = recv_right[i + c * ny];
+        }
+    }
+}
+
+// 广播网格原始输入，非 root 进程本地重建派生量
+void broadcastMesh(Mesh& mesh, int root, MPI_Comm comm)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    int dims[3] = { mesh.nx, mesh.ny, static_cast<int>(mesh.zoneu.size()) };
+    MPI_Bcast(dims, 3, MPI_INT, root, comm);
+
+    if (rank != root) {
+        mesh = Mesh(dims[1], dims[0]);
+        mesh.initializeToZero();
+        mesh.zoneu.assign(dims[2], 0.0);
+        mesh.zonev.assign(dims[2], 0.0);
+    }
+
+    MPI_Bcast(mesh.x.data(),      static_cast<int>(mesh.x.size()),      MPI_DOUBLE, root, comm);
+    MPI_Bcast(mesh.y.data(),      static_cast<int>(mesh.y.size()),      MPI_DOUBLE, root, comm);
+    MPI_Bcast(mesh.bctype.data(), static_cast<int>(mesh.bctype.size()), MPI_INT,    root, comm);
+    MPI_Bcast(mesh.zoneid.data(), static_cast<int>(mesh.zoneid.size()), MPI_INT,    root, comm);
+    MPI_Bcast(mesh.zoneu.data(),  dims[2], MPI_DOUBLE, root, comm);
+    MPI_Bcast(mesh.zonev.data(),  dims[2], MPI_DOUBLE, root, comm);
+
+    if (rank != root) {
+        mesh.createInterId();
+        mesh.initializeBoundaryConditions();
+        mesh.initGeometry();
+    }
+}
 // 从解向量转换为场矩阵
 void vectorToMatrix(const VectorXd& x, MatrixXd& phi, const Mesh& mesh) {
-    for (int i = 0; i < mesh.ny ; i++) {
-        for (int j = 0; j < mesh.nx ; j++) {
-            if (mesh.bctype(i, j) == 0) { // 仅处理内部点
-                int n = mesh.interid(i, j) ; // 获取对应的解向量索引
-                phi(i, j) = x[n];
-            }
-        }
+    if (mesh.compact) {   // 紧凑布局下存储号即内部编号
+        phi.col(0).head(mesh.internumber) = x.head(mesh.internumber);
+        return;
+    }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        int n = mesh.interid(i, j) ; // 获取对应的解向量索引
+        phi(i, j) = x[n];
     }
 }
 // 从场矩阵转换为解向量
 void matrixToVector(const MatrixXd& phi, VectorXd& x, const Mesh& mesh) {
-    for (int i = 0; i < mesh.ny ; i++) {
-        for (int j = 0; j < mesh.nx ; j++) {
-            if (mesh.bctype(i, j) == 0) { // 仅处理内部点
-                int n = mesh.interid(i, j) ; // 获取对应的解向量索引
-                x[n] = phi(i, j);
-            }
-        }
+    if (mesh.compact) {
+        x.head(mesh.internumber) = phi.col(0).head(mesh.internumber);
+        return;
+    }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        int n = mesh.interid(i, j) ; // 获取对应的解向量索引
+        x[n] = phi(i, j);
     }
 }
 void Parallel_correction(Mesh& mesh,Equation& equ,MatrixXd &phi1,MatrixXd &phi2){
-for (int i = 0; i < mesh.ny ; i++) {
-        for (int j = 0; j < mesh.nx ; j++) {
-            if (mesh.bctype(i, j) == 0) { // 仅处理内部点
-                if (mesh.bctype(i, j+1) == -3)
-                {
-                     phi1(i, j)-=equ.A_e(i, j)*phi2(i, j+1);
-                }
-                 if (mesh.bctype(i, j-1) == -3)
-                {
-                     phi1(i, j)-=equ.A_w(i, j)*phi2(i, j-1);
-                }
-                
-               
-            }
-        }
+    // 只遍历与 ghost 列（bctype=-3）相邻的边界面
+    for (const BoundaryFace& f : mesh.bfaces) {
+        if (f.type != -3) continue;
+        const int c = mesh.cell(mesh.interi[f.cell], mesh.interj[f.cell]);
+        const int g = mesh.cell(f.i, f.j);
+        if (f.dir == FACE_E)      phi1(c) -= equ.A_e(c) * phi2(g);
+        else if (f.dir == FACE_W) phi1(c) -= equ.A_w(c) * phi2(g);
     }
 }
 void Parallel_correction2(Mesh& mesh,Equation& equ,MatrixXd &phi1,MatrixXd &phi2){
-for (int i = 0; i < mesh.ny ; i++) {
-        for (int j = 0; j < mesh.nx ; j++) {
-            if (mesh.bctype(i, j) == 0) { // 仅处理内部点
-                if (mesh.bctype(i, j+1) == -3)
-                {
-                     phi1(i, j)+=equ.A_e(i, j)*phi2(i, j+1);
-                }
-                 if (mesh.bctype(i, j-1) == -3)
-                {
-                     phi1(i, j)+=equ.A_w(i, j)*phi2(i, j-1);
-                }
-                
-               
-            }
-        }
+    for (const BoundaryFace& f : mesh.bfaces) {
+        if (f.type != -3) continue;
+        const int c = mesh.cell(mesh.interi[f.cell], mesh.interj[f.cell]);
+        const int g = mesh.cell(f.i, f.j);
+        if (f.dir == FACE_E)      phi1(c) += equ.A_e(c) * phi2(g);
+        else if (f.dir == FACE_W) phi1(c) += equ.A_w(c) * phi2(g);
     }
 }
 
 void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsilon,
-                 int max_iter, int rank, int num_procs, double& r0,
+                 int max_iter, int rank, int num_procs, MPI_Comm comm, double& r0,
                  int verbose) {
 
     int n = equ.A.rows();
@@ -113,11 +270,11 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
     // 注意：exchangeColumns + Parallel_correction2 是针对并行分区边界的
     // GHOST CELL列修正，必须保留，否则跨进程的 Ap 计算会有边界误差。
     VectorXd r = b - A * x;
-    MatrixXd r_field = MatrixXd::Zero(mesh.ny, mesh.nx);
-    MatrixXd x_field = MatrixXd::Zero(mesh.ny, mesh.nx);
+    MatrixXd r_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
+    MatrixXd x_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
     vectorToMatrix(r, r_field, mesh);
     vectorToMatrix(x, x_field, mesh);
-    exchangeColumns(x_field, rank, num_procs);
+    exchangeColumns(x_field, mesh, rank, num_procs, comm);
     Parallel_correction2(mesh, equ, r_field, x_field);
     matrixToVector(r_field, r, mesh);
 
@@ -128,7 +285,7 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
     // ===== 3. 计算全局初始状态（两个 Allreduce 合并为一次）=====
     double local_buf2[2]  = { r.squaredNorm(), b.squaredNorm() };
     double global_buf2[2] = { 0.0, 0.0 };
-    MPI_Allreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    timedAllreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, comm);
 
     double current_r_sq   = global_buf2[0];
     double initial_r_norm = std::sqrt(current_r_sq);  // 只写一次，全程不变
@@ -145,6 +302,7 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
         if (rank == 0 && verbose)
             std::cout << "  [CG] 初始残差已达标。" << std::endl;
         r0 = initial_r_norm;  // ★ FIX2：输出初始残差
+        recordSolve(0, 1, initial_r_norm, initial_r_norm);
         return;
     }
 
@@ -156,29 +314,30 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
     const int    min_iter_protect = 5;
 
     int exit_status = 0, iter = 0;
-    MatrixXd p_field  = MatrixXd::Zero(mesh.ny, mesh.nx);
-    MatrixXd Ap_field = MatrixXd::Zero(mesh.ny, mesh.nx);
+    MatrixXd p_field  = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
+    MatrixXd Ap_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
 
     // ===== 4. CG 迭代 =====
     while (iter < max_iter) {
 
         // ── Ap 计算 ──────────────────────────────────────────────
+        kernel_profiler.start(KERNEL_SPMV);
         Ap = A * p;
         vectorToMatrix(p,  p_field,  mesh);
         vectorToMatrix(Ap, Ap_field, mesh);
-        exchangeColumns(p_field, rank, num_procs);
+        exchangeColumns(p_field, mesh, rank, num_procs, comm);
         Parallel_correction(mesh, equ, Ap_field, p_field);
         matrixToVector(Ap_field, Ap, mesh);
+        kernel_profiler.stop(KERNEL_SPMV, n);
 
         // ── 检测 (p, Ap) ≈ 0 ──────────────────────────────────────
         double local_pAp  = p.dot(Ap);
         double global_pAp = 0.0;
-        MPI_Allreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        timedAllreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, comm);
 
-        // 检测到数学失效后立即广播并退出，不再绕行
+        // global_pAp 由 Allreduce 得到，各进程一致，检测到数学失效后直接退出
         if (std::abs(global_pAp) < 1e-35) {
             exit_status = 3;
-            MPI_Bcast(&exit_status, 1, MPI_INT, 0, MPI_COMM_WORLD);
             break;
         }
 
@@ -190,7 +349,7 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
         // ── Allreduce：新 ‖r‖² ───────────────────────────────────
         double local_new_r_sq  = r.squaredNorm();
         double global_new_r_sq = 0.0;
-        MPI_Allreduce(&local_new_r_sq, &global_new_r_sq, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        timedAllreduce(&local_new_r_sq, &global_new_r_sq, 1, MPI_DOUBLE, MPI_SUM, comm);
 
         // current_r_norm 由 Allreduce 结果赋值，所有进程同步持有
         current_r_norm = std::sqrt(global_new_r_sq);
@@ -201,28 +360,25 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
         current_r_sq = global_new_r_sq;
         iter++;
 
-        // ── 收敛 / 停滞判断（rank0 负责逻辑，结果广播）─────────────
-        //判断基于所有进程同步后的 current_r_norm，语义明确
-        if (rank == 0) {
-            double rel_res = current_r_norm / initial_r_norm;
-            if (rel_res < epsilon) {
-                exit_status = 1;
-            } else if (iter > min_iter_protect) {
-                double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
-                stagnation_count = (drop_rate < stagnation_tol)
-                                   ? stagnation_count + 1 : 0;
-                if (stagnation_count >= max_stagnation)
-                    exit_status = 2;
-            }
-            prev_r_norm = current_r_norm;
+        // ── 收敛 / 停滞判断（各进程本地判断，无需广播）─────────────
+        // current_r_norm 由 Allreduce 结果得到，各进程逐位一致，判断结果相同
+        double rel_res = current_r_norm / initial_r_norm;
+        if (rel_res < epsilon) {
+            exit_status = 1;
+        } else if (iter > min_iter_protect) {
+            double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
+            stagnation_count = (drop_rate < stagnation_tol)
+                               ? stagnation_count + 1 : 0;
+            if (stagnation_count >= max_stagnation)
+                exit_status = 2;
         }
-
-        MPI_Bcast(&exit_status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        prev_r_norm = current_r_norm;
         if (exit_status != 0) break;
     }
 
     //函数结束时统一写回输出参数（最终残差），只写这一次
     r0 = current_r_norm;
+    recordSolve(iter, exit_status, initial_r_norm, r0);
 
     // ===== 5. 日志打印 =====
     if (rank == 0 && verbose == 1) {
@@ -246,7 +402,7 @@ void CG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x, double epsi
 }
 
 void PCG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x,
-                 double epsilon, int max_iter, int rank, int num_procs,
+                 double epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
                  double& r0, int verbose) {
 
     int n = equ.A.rows();
@@ -254,37 +410,40 @@ void PCG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x,
 
     // 构建Jacobi预条件（仅一次，O(N)，无通信）
     VectorXd inv_diag(n);
-    for (int i = 0; i < mesh.ny; i++) {
-        for (int j = 0; j < mesh.nx; j++) {
-            if (mesh.bctype(i, j) == 0) {
-                int idx = mesh.interid(i, j);
-                double d = equ.A_p(i, j);
-                inv_diag[idx] = (std::abs(d) > 1e-14) ? 1.0/d : 1.0;
-            }
-        }
+    for(int k = 0; k < mesh.internumber; k++) {  // 仅遍历活动单元（按内部编号顺序）
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        int idx = mesh.interid(i, j);
+        double d = equ.A_p(mesh.cell(i, j));
+        inv_diag[idx] = (std::abs(d) > 1e-14) ? 1.0/d : 1.0;
     }
 
     // ===== 初始化残差 =====
     // 注意：exchangeColumns + Parallel_correction2 是针对并行分区边界的
     // GHOST CELL列修正，必须保留，否则跨进程的 Ap 计算会有边界误差。
     VectorXd r = b - A * x;
-    MatrixXd r_field = MatrixXd::Zero(mesh.ny, mesh.nx);
-    MatrixXd x_field = MatrixXd::Zero(mesh.ny, mesh.nx);
+    MatrixXd r_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
+    MatrixXd x_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
     vectorToMatrix(r, r_field, mesh);
     vectorToMatrix(x, x_field, mesh);
-    exchangeColumns(x_field, rank, num_procs);
+    exchangeColumns(x_field, mesh, rank, num_procs, comm);
     Parallel_correction2(mesh, equ, r_field, x_field);
     matrixToVector(r_field, r, mesh);
 
     // 初始化：p = z = M⁻¹r
     VectorXd z  = inv_diag.cwiseProduct(r);
     VectorXd p  = z;
-    VectorXd Ap = VectorXd::Zero(n);
+    VectorXd Ap;
 
-    // 初始内积（三个Allreduce合并为一次）
+    // 初始内积（三个Allreduce合并为一次，非阻塞）；等待期间分配迭代用的工作数组
     double local_buf3[3]  = { r.dot(z), r.squaredNorm(), b.squaredNorm() };
     double global_buf3[3] = { 0.0, 0.0, 0.0 };
-    MPI_Allreduce(local_buf3, global_buf3, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    {
+        AsyncAllreduce init_reduce(local_buf3, global_buf3, 3, comm);
+        init_reduce.start();
+        Ap = VectorXd::Zero(n);
+        init_reduce.finish();
+    }
 
     double current_rz    = global_buf3[0];
     double initial_r_norm = std::sqrt(global_buf3[1]);   // 只写这一次，不再修改
@@ -301,6 +460,7 @@ void PCG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x,
         if (rank == 0 && verbose)
             std::cout << "  [PCG] 初始残差已达标。" << std::endl;
         r0 = initial_r_norm;   // 输出初始残差
+        recordSolve(0, 1, initial_r_norm, initial_r_norm);
         return;
     }
 
@@ -312,42 +472,56 @@ void PCG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x,
     const int    min_iter_protect = 5;
     int exit_status = 0, iter = 0;
 
-    MatrixXd p_field  = MatrixXd::Zero(mesh.ny, mesh.nx);
-    MatrixXd Ap_field = MatrixXd::Zero(mesh.ny, mesh.nx);
+    MatrixXd p_field  = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
+    MatrixXd Ap_field = MatrixXd::Zero(mesh.fieldRows(), mesh.fieldCols());
+
+    // 每步的 r·z、‖r‖² 归约（MPI-4 下为持久化请求，整个求解只初始化一次）
+    double local_buf2[2]  = { 0.0, 0.0 };
+    double global_buf2[2] = { 0.0, 0.0 };
+    AsyncAllreduce rz_reduce(local_buf2, global_buf2, 2, comm);
 
     // ===== PCG 迭代 =====
     while (iter < max_iter) {
 
         // ── Ap 计算 ──────────────────────────────────────────────
+        kernel_profiler.start(KERNEL_SPMV);
         Ap = A * p;
         vectorToMatrix(p,  p_field,  mesh);
         vectorToMatrix(Ap, Ap_field, mesh);
-        exchangeColumns(p_field, rank, num_procs);
+        exchangeColumns(p_field, mesh, rank, num_procs, comm);
         Parallel_correction(mesh, equ, Ap_field, p_field);
         matrixToVector(Ap_field, Ap, mesh);
+        kernel_profiler.stop(KERNEL_SPMV, n);
 
         // ── 检测 (p, Ap) ≈ 0 ──────────────────────────────────────
+        // 其后所有本地计算都依赖 α，此归约保持阻塞
         double local_pAp = p.dot(Ap);
         double global_pAp = 0.0;
-        MPI_Allreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        timedAllreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, comm);
 
-        // 检测到数学失效后立即广播并退出，不再绕行
+        // global_pAp 由 Allreduce 得到，各进程一致，检测到数学失效后直接退出
         if (std::abs(global_pAp) < 1e-35) {
             exit_status = 3;
-            MPI_Bcast(&exit_status, 1, MPI_INT, 0, MPI_COMM_WORLD);
             break;
         }
 
-        // ── 更新 x, r, z ──────────────────────────────────────────
+        // ── 更新 r，同一遍循环得到本地 r·M⁻¹r 与 ‖r‖² ─────────────
         double alpha = current_rz / global_pAp;
-        x += alpha * p;
-        r -= alpha * Ap;
-        z  = inv_diag.cwiseProduct(r);   // 本地操作，无通信
+        double local_rz = 0.0, local_rr = 0.0;
+        for (int k = 0; k < n; ++k) {
+            const double rk = r[k] - alpha * Ap[k];
+            r[k] = rk;
+            local_rz += rk * inv_diag[k] * rk;
+            local_rr += rk * rk;
+        }
 
-        // ── 合并 Allreduce：新 r·z 和 ‖r‖² ──────────────────────
-        double local_buf2[2]  = { r.dot(z), r.squaredNorm() };
-        double global_buf2[2] = { 0.0, 0.0 };
-        MPI_Allreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        // ── 非阻塞 Allreduce：新 r·z 和 ‖r‖²，期间完成 Jacobi 预条件与 x 的更新 ──
+        local_buf2[0] = local_rz;
+        local_buf2[1] = local_rr;
+        rz_reduce.start();
+        z  = inv_diag.cwiseProduct(r);   // 本地操作，无通信
+        x += alpha * p;
+        rz_reduce.finish();
 
         double new_rz = global_buf2[0];
         //current_r_norm 由所有进程同步更新，rank0 不再独享
@@ -359,28 +533,25 @@ void PCG_parallel(Equation& equ, Mesh mesh, VectorXd& b, VectorXd& x,
         current_rz = new_rz;
         iter++;
 
-        // ── 收敛 / 停滞判断（rank0 负责逻辑，结果广播）─────────────
-        //判断基于所有进程同步后的 current_r_norm，语义明确
-        if (rank == 0) {
-            double rel_res = current_r_norm / initial_r_norm;
-            if (rel_res < epsilon) {
-                exit_status = 1;
-            } else if (iter > min_iter_protect) {
-                double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
-                stagnation_count = (drop_rate < stagnation_tol)
-                                   ? stagnation_count + 1 : 0;
-                if (stagnation_count >= max_stagnation)
-                    exit_status = 2;
-            }
-            prev_r_norm = current_r_norm;
+        // ── 收敛 / 停滞判断（各进程本地判断，无需广播）─────────────
+        // current_r_norm 由 Allreduce 结果得到，各进程逐位一致，判断结果相同
+        double rel_res = current_r_norm / initial_r_norm;
+        if (rel_res < epsilon) {
+            exit_status = 1;
+        } else if (iter > min_iter_protect) {
+            double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
+            stagnation_count = (drop_rate < stagnation_tol)
+                               ? stagnation_count + 1 : 0;
+            if (stagnation_count >= max_stagnation)
+                exit_status = 2;
         }
-
-        MPI_Bcast(&exit_status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        prev_r_norm = current_r_norm;
         if (exit_status != 0) break;
     }
 
     // 函数结束时统一写回输出参数，语义清晰（最终残差）
     r0 = current_r_norm;
+    recordSolve(iter, exit_status, initial_r_norm, r0);
 
     // ===== 日志打印 =====
     if (rank == 0 && verbose == 1) {
@@ -410,6 +581,7 @@ void solveFieldCG(
     int max_iter,
     int rank,
     int num_procs,
+    MPI_Comm comm,
     double& l2_norm,
     int verbose
 )
@@ -419,13 +591,13 @@ void solveFieldCG(
 
     CG_parallel(equ, mesh, equ.source, x,
                 tol, max_iter,
-                rank, num_procs,
+                rank, num_procs, comm,
                 l2_norm, verbose);
 
     vectorToMatrix(x, field, mesh);
 
 
-    exchangeColumns(field, rank, num_procs);
+    exchangeColumns(field, mesh, rank, num_procs, comm);
     
 }
 
@@ -438,6 +610,7 @@ void solveFieldPCG(
     int max_iter,
     int rank,
     int num_procs,
+    MPI_Comm comm,
     double& l2_norm,
     int verbose
 )
@@ -447,12 +620,2094 @@ void solveFieldPCG(
 
     PCG_parallel(equ, mesh, equ.source, x,
                 tol, max_iter,
-                rank, num_procs,
+                rank, num_procs, comm,
                 l2_norm, verbose);
 
     vectorToMatrix(x, field, mesh);
 
 
-    exchangeColumns(field, rank, num_procs);
+    exchangeColumns(field, mesh, rank, num_procs, comm);
     
-}
\ No newline at end of file
+}
+
+
+void reportPerfSummary(const std::string& tag, double elapsed, int iters,
+                       long cells, int rank, int num_procs, MPI_Comm comm,
+                       double res_u, double res_v, double res_p)
+{
+    double local_buf[2]  = { elapsed, total_comm_time / std::max(elapsed, 1e-30) };
+    double max_elapsed   = 0.0;
+    double sum_fraction  = 0.0;
+    MPI_Reduce(&local_buf[0], &max_elapsed,  1, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(&local_buf[1], &sum_fraction, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+
+    if (rank == 0) {
+        double time_per_iter = max_elapsed / std::max(iters, 1);
+        std::cout << std::scientific << std::setprecision(6)
+                  << "PERF," << tag << "," << num_procs << "," << cells << ","
+                  << iters << "," << time_per_iter << ","
+                  << sum_fraction / num_procs << ","
+                  << solver_stats.total_iterations << ","
+                  << solver_stats.total_solves << ","
+                  << res_u << "," << res_v << "," << res_p << std::endl;
+    }
+}
+
+
+// ============================================================================
+// 内核硬件计数器
+// ============================================================================
+
+KernelProfiler kernel_profiler;
+
+namespace {
+
+/// 每个内核的名称与每单元模型（字节、浮点运算），顺序与 KernelId 一致
+struct KernelModel { const char* name; double bytes; double flops; };
+const KernelModel KERNEL_MODELS[KERNEL_COUNT] = {
+    {"momentum",      bytes_momentum,    flops_momentum},
+    {"solve_u",       bytes_pcg_iter,    flops_pcg_iter},
+    {"solve_v",       bytes_pcg_iter,    flops_pcg_iter},
+    {"face_velocity", bytes_face_vel,    flops_face_vel},
+    {"pressure",      bytes_pressure,    flops_pressure},
+    {"solve_p",       bytes_pcg_iter,    flops_pcg_iter},
+    {"correct",       bytes_correct_vel, flops_correct},
+    {"  spmv",        bytes_spmv_row,    flops_spmv_row},
+};
+
+} // namespace
+
+void KernelProfiler::init(bool enable, int rank)
+{
+    enabled = enable;
+    if (!enable) return;
+
+#ifdef __linux__
+    const std::pair<uint32_t, uint64_t> events[3] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+    int err = 0;
+    for (int e = 0; e < 3; ++e) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = events[e].first;
+        attr.config         = events[e].second;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled       = (e == 0);  // 组长先关闭，全组打开后一并启用
+        fds[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                          e == 0 ? -1 : fds[0], 0));
+        if (fds[e] < 0) {
+            err = errno;
+            break;
+        }
+    }
+    if (fds[0] >= 0 && fds[1] >= 0 && fds[2] >= 0) {
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        hardware = true;
+    } else {
+        for (int& fd : fds) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+    }
+    if (!hardware && rank == 0) {
+        std::cout << "[counters] perf_event_open 不可用（" << std::strerror(err)
+                  << "），仅记录墙钟时间与模型数据量" << std::endl;
+    }
+#else
+    if (rank == 0) {
+        std::cout << "[counters] 非 Linux 平台，仅记录墙钟时间与模型数据量" << std::endl;
+    }
+#endif
+}
+
+KernelProfiler::~KernelProfiler()
+{
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+void KernelProfiler::sample(uint64_t out[5]) const
+{
+#ifdef __linux__
+    // PERF_FORMAT_GROUP 布局：nr, time_enabled, time_running, value[nr]
+    uint64_t buf[6] = {};
+    if (read(fds[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf))) {
+        for (int i = 0; i < 5; ++i) out[i] = buf[i + 1];
+        return;
+    }
+#endif
+    for (int i = 0; i < 5; ++i) out[i] = 0;
+}
+
+void KernelProfiler::begin(KernelId k)
+{
+    if (hardware) sample(snap[k]);
+    t_start[k] = MPI_Wtime();
+}
+
+void KernelProfiler::end(KernelId k, double units)
+{
+    KernelCounters& c = counters[k];
+    c.seconds += MPI_Wtime() - t_start[k];
+    c.units   += units;
+    c.calls++;
+    if (!hardware) return;
+
+    uint64_t now[5];
+    sample(now);
+    const double enabled_ns = static_cast<double>(now[0] - snap[k][0]);
+    const double running_ns = static_cast<double>(now[1] - snap[k][1]);
+    // 计数器被复用时只在部分时间内运行，按比例外推
+    const double scale = (running_ns > 0.0) ? enabled_ns / running_ns : 1.0;
+    c.cycles       += static_cast<uint64_t>((now[2] - snap[k][2]) * scale);
+    c.instructions += static_cast<uint64_t>((now[3] - snap[k][3]) * scale);
+    c.llc_misses   += static_cast<uint64_t>((now[4] - snap[k][4]) * scale);
+}
+
+void KernelProfiler::report(int rank, int num_procs, MPI_Comm comm) const
+{
+    if (!enabled) return;
+
+    // 计数与工作量求和，时间与调用次数取各进程最大值（聚合带宽 = 全部数据量 / 最慢进程耗时）
+    double local_sum[KERNEL_COUNT][4], global_sum[KERNEL_COUNT][4];
+    double local_max[KERNEL_COUNT][2], global_max[KERNEL_COUNT][2];
+    for (int k = 0; k < KERNEL_COUNT; ++k) {
+        local_sum[k][0] = counters[k].units;
+        local_sum[k][1] = static_cast<double>(counters[k].cycles);
+        local_sum[k][2] = static_cast<double>(counters[k].instructions);
+        local_sum[k][3] = static_cast<double>(counters[k].llc_misses);
+        local_max[k][0] = counters[k].seconds;
+        local_max[k][1] = static_cast<double>(counters[k].calls);
+    }
+    int hw_local = hardware ? 1 : 0, hw_all = 0;
+    MPI_Reduce(local_sum, global_sum, KERNEL_COUNT * 4, MPI_DOUBLE, MPI_SUM, 0, comm);
+    MPI_Reduce(local_max, global_max, KERNEL_COUNT * 2, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Reduce(&hw_local, &hw_all, 1, MPI_INT, MPI_MIN, 0, comm);
+    if (rank != 0) return;
+
+    const double line_bytes = 64.0;
+    const std::ios_base::fmtflags saved_flags = std::cout.flags();
+    const std::streamsize saved_prec = std::cout.precision();
+    std::cout << "\n==================== 内核计数器（" << num_procs << " 进程汇总）"
+              << " ====================" << std::endl;
+    std::cout << std::left << std::setw(16) << "kernel" << std::right
+              << std::setw(9) << "calls" << std::setw(10) << "time(s)"
+              << std::setw(7) << "IPC" << std::setw(10) << "LLC GB/s"
+              << std::setw(11) << "model GB/s" << std::setw(10) << "GFLOP/s"
+              << std::setw(9) << "AI" << std::endl;
+    std::cout << std::fixed;
+    for (int k = 0; k < KERNEL_COUNT; ++k) {
+        const double calls = global_max[k][1];
+        if (calls == 0.0) continue;
+        const double t     = std::max(global_max[k][0], 1e-30);
+        const double flops = global_sum[k][0] * KERNEL_MODELS[k].flops;
+        const double model = global_sum[k][0] * KERNEL_MODELS[k].bytes;
+        const double llc   = global_sum[k][3] * line_bytes;
+
+        std::cout << std::left << std::setw(16) << KERNEL_MODELS[k].name << std::right
+                  << std::setw(9) << static_cast<long>(calls)
+                  << std::setw(10) << std::setprecision(4) << global_max[k][0];
+        if (hw_all && global_sum[k][1] > 0.0) {
+            std::cout << std::setw(7) << std::setprecision(2) << global_sum[k][2] / global_sum[k][1]
+                      << std::setw(10) << std::setprecision(2) << llc / t / 1e9;
+        } else {
+            std::cout << std::setw(7) << "-" << std::setw(10) << "-";
+        }
+        const double bytes = (hw_all && llc > 0.0) ? llc : model;
+        std::cout << std::setw(11) << std::setprecision(2) << model / t / 1e9
+                  << std::setw(10) << std::setprecision(3) << flops / t / 1e9
+                  << std::setw(9) << std::setprecision(3) << flops / bytes << std::endl;
+    }
+    std::cout.flags(saved_flags);
+    std::cout.precision(saved_prec);
+    std::cout << "  工作量单位：离散内核为单元数，求解为 内部点 × Krylov 迭代；spmv 计入 solve_*；"
+              << (hw_all ? "AI 按 LLC 实测字节" : "AI 按模型字节") << std::endl;
+}
+
+
+// ============================================================================
+// 混合精度求解器
+// ============================================================================
+
+template <class T> static MPI_Datatype mpiTypeOf();
+template <> MPI_Datatype mpiTypeOf<float>()  { return MPI_FLOAT; }
+template <> MPI_Datatype mpiTypeOf<double>() { return MPI_DOUBLE; }
+
+void HaloPlan::build(const Mesh& mesh, const Equation& equ)
+{
+    ny = mesh.ny;
+    const int nx = mesh.nx;
+
+    send_left.assign(ny, -1);
+    send_right.assign(ny, -1);
+    west_idx.clear();  west_row.clear();  west_coef.clear();
+    east_idx.clear();  east_row.clear();  east_coef.clear();
+
+    // 发送列：左邻进程的右 ghost 对应本进程第 2 列，右邻进程的左 ghost 对应第 nx-3 列
+    if (nx >= 4) {
+        for (int i = 0; i < ny; ++i) {
+            if (mesh.bctype(i, 2) == 0)      send_left[i]  = mesh.interid(i, 2);
+            if (mesh.bctype(i, nx - 3) == 0) send_right[i] = mesh.interid(i, nx - 3);
+        }
+    }
+
+    // 与 ghost 列相邻的内部点（与 Parallel_correction 的判断一致）
+    for (const BoundaryFace& f : mesh.bfaces) {
+        if (f.type != -3) continue;
+        const int i = mesh.interi[f.cell];
+        const int c = mesh.cell(i, mesh.interj[f.cell]);
+        if (f.dir == FACE_E) {
+            east_idx.push_back(f.cell);
+            east_row.push_back(i);
+            east_coef.push_back(equ.A_e(c));
+        } else if (f.dir == FACE_W) {
+            west_idx.push_back(f.cell);
+            west_row.push_back(i);
+            west_coef.push_back(equ.A_w(c));
+        }
+    }
+}
+
+template <class T>
+void HaloPlan::apply(const Matrix<T, Dynamic, 1>& p, Matrix<T, Dynamic, 1>& Ap,
+                     int rank, int num_procs, MPI_Comm comm) const
+{
+    int left_rank  = (rank == 0) ? MPI_PROC_NULL : rank - 1;
+    int right_rank = (rank == num_procs - 1) ? MPI_PROC_NULL : rank + 1;
+    if (left_rank == MPI_PROC_NULL && right_rank == MPI_PROC_NULL) return;
+
+    std::vector<T> sl(ny), sr(ny), rl(ny, T(0)), rr(ny, T(0));
+    for (int i = 0; i < ny; ++i) {
+        sl[i] = (send_left[i]  >= 0) ? p[send_left[i]]  : T(0);
+        sr[i] = (send_right[i] >= 0) ? p[send_right[i]] : T(0);
+    }
+
+    double t0 = MPI_Wtime();
+    const MPI_Datatype type = mpiTypeOf<T>();
+    MPI_Sendrecv(sl.data(), ny, type, left_rank,  0,
+                 rl.data(), ny, type, left_rank,  1, comm, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(sr.data(), ny, type, right_rank, 1,
+                 rr.data(), ny, type, right_rank, 0, comm, MPI_STATUS_IGNORE);
+    total_comm_time += MPI_Wtime() - t0;
+    total_comm_count++;
+
+    for (size_t k = 0; k < west_idx.size(); ++k)
+        Ap[west_idx[k]] -= static_cast<T>(west_coef[k]) * rl[west_row[k]];
+    for (size_t k = 0; k < east_idx.size(); ++k)
+        Ap[east_idx[k]] -= static_cast<T>(east_coef[k]) * rr[east_row[k]];
+}
+
+template void HaloPlan::apply<float>(const VectorXf&, VectorXf&, int, int, MPI_Comm) const;
+template void HaloPlan::apply<double>(const VectorXd&, VectorXd&, int, int, MPI_Comm) const;
+
+/**
+ * @brief 内层 Jacobi-PCG（零初值），返回迭代次数
+ *
+ * 向量与矩阵精度为 T，内积以 double 做全局归约；
+ * 所有进程持有相同的归约结果，退出判断无需额外广播。
+ * 停滞判据与 PCG_parallel 相同（保护 5 步后连续 3 步下降率 < 1e-6），
+ * 触发时置 stagnated = true。
+ */
+template <class T>
+static int innerPCG(const SparseMatrix<T>& A, const HaloPlan& halo,
+                    const Matrix<T, Dynamic, 1>& inv_diag,
+                    const Matrix<T, Dynamic, 1>& b, Matrix<T, Dynamic, 1>& x,
+                    double tol, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                    bool& stagnated)
+{
+    typedef Matrix<T, Dynamic, 1> Vec;
+    const int n = A.rows();
+
+    x.setZero(n);
+    Vec r  = b;
+    Vec z  = inv_diag.cwiseProduct(r);
+    Vec p  = z;
+    Vec Ap(n);
+
+    double local_buf2[2]  = { static_cast<double>(r.dot(z)),
+                              static_cast<double>(r.squaredNorm()) };
+    double global_buf2[2] = { 0.0, 0.0 };
+    timedAllreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, comm);
+
+    double current_rz = global_buf2[0];
+    double r_init     = std::sqrt(global_buf2[1]);
+    stagnated = false;
+    if (r_init < 1e-30) return 0;
+
+    double prev_r_norm   = r_init;
+    int stagnation_count = 0;
+    const int    max_stagnation   = 3;
+    const double stagnation_tol   = 1e-6;
+    const int    min_iter_protect = 5;
+
+    int iter = 0;
+    while (iter < max_iter) {
+        Ap.noalias() = A * p;
+        halo.apply(p, Ap, rank, num_procs, comm);
+
+        double local_pAp  = static_cast<double>(p.dot(Ap));
+        double global_pAp = 0.0;
+        timedAllreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, comm);
+        if (std::abs(global_pAp) < 1e-35) break;
+
+        const T alpha = static_cast<T>(current_rz / global_pAp);
+        x += alpha * p;
+        r -= alpha * Ap;
+        z  = inv_diag.cwiseProduct(r);
+
+        local_buf2[0] = static_cast<double>(r.dot(z));
+        local_buf2[1] = static_cast<double>(r.squaredNorm());
+        timedAllreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, comm);
+        iter++;
+
+        double r_norm = std::sqrt(global_buf2[1]);
+        if (r_norm / r_init < tol) break;
+        if (iter > min_iter_protect) {
+            double drop_rate = (prev_r_norm - r_norm) / prev_r_norm;
+            stagnation_count = (drop_rate < stagnation_tol) ? stagnation_count + 1 : 0;
+            if (stagnation_count >= max_stagnation) { stagnated = true; break; }
+        }
+        prev_r_norm = r_norm;
+
+        const T beta = static_cast<T>(global_buf2[0] / current_rz);
+        p = z + beta * p;
+        current_rz = global_buf2[0];
+    }
+    return iter;
+}
+
+void PCG_parallel_mixed(Equation& equ, const Mesh& mesh, VectorXd& b, VectorXd& x,
+                        double epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                        double& r0, int verbose)
+{
+    const int n = equ.A.rows();
+    const SparseMatrix<double>& A = equ.A;
+
+    HaloPlan halo;
+    halo.build(mesh, equ);
+
+    // Jacobi 预条件（与 PCG_parallel 相同）
+    VectorXd inv_diag(n);
+    for (int k = 0; k < n; ++k) {
+        double d = equ.A_p(mesh.cell(mesh.interi[k], mesh.interj[k]));
+        inv_diag[k] = (std::abs(d) > 1e-14) ? 1.0 / d : 1.0;
+    }
+
+    // double 精度真实残差 r = b - Ax（含跨进程耦合）
+    VectorXd r(n), Ax(n);
+    auto residual = [&]() {
+        Ax.noalias() = A * x;
+        halo.apply(x, Ax, rank, num_procs, comm);
+        r = b - Ax;
+    };
+
+    residual();
+    double local_buf2[2]  = { r.squaredNorm(), b.squaredNorm() };
+    double global_buf2[2] = { 0.0, 0.0 };
+    timedAllreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, comm);
+
+    const double initial_r_norm = std::sqrt(global_buf2[0]);
+    const double b_norm         = std::sqrt(global_buf2[1]);
+    double current_r_norm       = initial_r_norm;
+
+    if (rank == 0 && verbose == 1)
+        std::cout << "  [MPCG] r0 = " << initial_r_norm << std::endl;
+
+    if (initial_r_norm < 1e-15 ||
+        initial_r_norm / (b_norm + 1e-16) < epsilon) {
+        if (rank == 0 && verbose)
+            std::cout << "  [MPCG] 初始残差已达标。" << std::endl;
+        r0 = initial_r_norm;
+        recordSolve(0, 1, initial_r_norm, initial_r_norm);
+        return;
+    }
+
+    // 单精度副本（每次求解转换一次，O(nnz)）
+    const SparseMatrix<float> A_f = A.cast<float>();
+    const VectorXf inv_diag_f     = inv_diag.cast<float>();
+    VectorXf r_f(n), d_f(n);
+
+    const int max_outer = 20;
+    int exit_status = 0, total_inner = 0, outer = 0;
+
+    // ===== 外层迭代精化 =====
+    while (total_inner < max_iter && outer < max_outer) {
+        double rel_res = current_r_norm / initial_r_norm;
+        if (rel_res < epsilon) { exit_status = 1; break; }
+
+        double inner_tol = std::min(0.1, std::max(epsilon / rel_res, 1e-4));
+
+        r_f = r.cast<float>();
+        bool inner_stagnated = false;
+        total_inner += innerPCG(A_f, halo, inv_diag_f, r_f, d_f, inner_tol,
+                                max_iter - total_inner, rank, num_procs, comm,
+                                inner_stagnated);
+        outer++;
+
+        x += d_f.cast<double>();
+        residual();
+
+        double local_r_sq  = r.squaredNorm();
+        double global_r_sq = 0.0;
+        timedAllreduce(&local_r_sq, &global_r_sq, 1, MPI_DOUBLE, MPI_SUM, comm);
+        double new_r_norm = std::sqrt(global_r_sq);
+
+        // 内层停滞，或外层残差不再下降（如非对称动量方程上 CG 失效）→ 停滞退出
+        if (inner_stagnated || new_r_norm > 0.999 * current_r_norm) {
+            current_r_norm = new_r_norm;
+            exit_status = 2;
+            break;
+        }
+        current_r_norm = new_r_norm;
+    }
+    if (exit_status == 0 && current_r_norm / initial_r_norm < epsilon)
+        exit_status = 1;
+
+    r0 = current_r_norm;
+    recordSolve(total_inner, exit_status, initial_r_norm, r0);
+
+    if (rank == 0 && verbose == 1) {
+        double rel_res = r0 / initial_r_norm;
+        const char* status =
+            (exit_status == 1) ? "收敛" :
+            (exit_status == 2) ? "停滞退出" : "达到最大迭代次数";
+        std::cout << "  [MPCG] " << status << ": 相对残差 " << std::scientific
+                  << std::setprecision(3) << rel_res
+                  << " (" << total_inner << " inner iterations, "
+                  << outer << " refinements)" << std::endl;
+    }
+}
+
+void solveFieldPCGMixed(
+    Equation& equ,
+    Mesh& mesh,
+    MatrixXd& field,
+    double tol,
+    int max_iter,
+    int rank,
+    int num_procs,
+    MPI_Comm comm,
+    double& l2_norm,
+    int verbose
+)
+{
+    VectorXd x(mesh.internumber);
+    x.setZero();
+
+    PCG_parallel_mixed(equ, mesh, equ.source, x,
+                       tol, max_iter,
+                       rank, num_procs, comm,
+                       l2_norm, verbose);
+
+    vectorToMatrix(x, field, mesh);
+
+    exchangeColumns(field, mesh, rank, num_procs, comm);
+}
+
+
+// ============================================================================
+// Deflated PCG（Krylov 子空间回收）
+// ============================================================================
+
+// 本地块的 Aᵀ·B 全局归约（k1×k2 小矩阵，一次 Allreduce）
+static MatrixXd globalInner(const MatrixXd& A, const MatrixXd& B, MPI_Comm comm)
+{
+    MatrixXd local  = A.transpose() * B;
+    MatrixXd global = MatrixXd::Zero(local.rows(), local.cols());
+    timedAllreduce(local.data(), global.data(), static_cast<int>(local.size()),
+                   MPI_DOUBLE, MPI_SUM, comm);
+    return global;
+}
+
+/**
+ * @brief 在 Z = [W, P] 上做 Rayleigh–Ritz，返回最小的 k 个 Ritz 向量
+ *
+ * 先对 Gram 矩阵 ZᵀZ 做特征分解并丢弃近似线性相关的方向，
+ * 再在正交化后的子空间上求 ZᵀAZ 的特征对；返回的列向量全局正交归一。
+ * n_global > 0 表示 A 以常向量为零空间（A·1 = 0，A 对称）：先去掉 Z 各列的均值，
+ * 否则接近常向量的 Ritz 向量带着近零的 Ritz 值进入回收空间，E = WᵀAW 近奇异。
+ * 由于 A·1 = 0，AZ 不变，ZᵀZ 只需减去 n·c cᵀ（c 为列均值），不增加归约次数。
+ */
+static MatrixXd ritzVectors(const MatrixXd& Z, const MatrixXd& AZ, int k, double n_global,
+                            MPI_Comm comm)
+{
+    const int q = static_cast<int>(Z.cols());
+    MatrixXd ZZ(q, 2 * q + 1);
+    ZZ << Z.transpose() * Z, Z.transpose() * AZ, Z.colwise().sum().transpose();
+    MatrixXd global = MatrixXd::Zero(q, 2 * q + 1);
+    timedAllreduce(ZZ.data(), global.data(), static_cast<int>(ZZ.size()),
+                   MPI_DOUBLE, MPI_SUM, comm);
+    VectorXd mean = VectorXd::Zero(q);
+    if (n_global > 0.0) mean = global.col(2 * q) / n_global;
+    const MatrixXd F = global.leftCols(q) - n_global * mean * mean.transpose();
+    const MatrixXd G = 0.5 * (global.middleCols(q, q) + global.middleCols(q, q).transpose());
+
+    SelfAdjointEigenSolver<MatrixXd> gram(F);
+    const VectorXd& d = gram.eigenvalues();
+    const double d_max = d.maxCoeff();
+    std::vector<int> keep;
+    for (int c = 0; c < q; ++c)
+        if (d[c] > 1e-10 * d_max) keep.push_back(c);
+    if (keep.empty()) return MatrixXd();
+
+    MatrixXd Q(q, keep.size());
+    for (size_t c = 0; c < keep.size(); ++c)
+        Q.col(c) = gram.eigenvectors().col(keep[c]) / std::sqrt(d[keep[c]]);
+
+    SelfAdjointEigenSolver<MatrixXd> ritz(Q.transpose() * G * Q);
+    const VectorXd& theta = ritz.eigenvalues();
+
+    // 特征值升序排列：取最小的 k 个正 Ritz 值（矩阵非正定时跳过负值方向）
+    std::vector<int> cols;
+    for (int c = 0; c < theta.size() && static_cast<int>(cols.size()) < k; ++c)
+        if (theta[c] > 1e-12 * std::abs(theta.maxCoeff())) cols.push_back(c);
+    if (cols.empty()) return MatrixXd();
+
+    MatrixXd Y(Q.cols(), cols.size());
+    for (size_t c = 0; c < cols.size(); ++c) Y.col(c) = ritz.eigenvectors().col(cols[c]);
+    const MatrixXd QY = Q * Y;
+    MatrixXd V = Z * QY;
+    if (n_global > 0.0) V.rowwise() -= (mean.transpose() * QY);
+    return V;
+}
+
+void PCG_parallel_deflated(Equation& equ, const Mesh& mesh, VectorXd& b, VectorXd& x,
+                           double epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                           double& r0, DeflationSpace& defl, int verbose)
+{
+    const int n = equ.A.rows();
+    const SparseMatrix<double>& A = equ.A;
+
+    HaloPlan halo;
+    halo.build(mesh, equ);
+
+    // 压力修正方程第 (i,j) 行乘了 vol(i,j)，A = diag(vol)·S，S 在非均匀网格上同样对称。
+    // CG、投影与 Ritz 提取都在 S = diag(vol)⁻¹A、右端项 b/vol 上进行，解不变
+    VectorXd vol(n), inv_vol(n), inv_diag(n);
+    for (int k = 0; k < n; ++k) {
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        const int c = mesh.cell(i, j);
+        vol[k]     = (mesh.vol(c) > 0.0) ? mesh.vol(c) : 1.0;
+        inv_vol[k] = 1.0 / vol[k];
+        double d = equ.A_p(c) * inv_vol[k];
+        inv_diag[k] = (std::abs(d) > 1e-14) ? 1.0 / d : 1.0;
+    }
+    auto applyS = [&](const VectorXd& v, VectorXd& Sv) {
+        Sv.noalias() = A * v;
+        halo.apply(v, Sv, rank, num_procs, comm);
+        Sv.array() *= inv_vol.array();
+    };
+
+    // ===== 回收空间：S·W 与 E = WᵀSW =====
+    if (defl.W.rows() != n || defl.k <= 0) defl.reset();
+    MatrixXd& W = defl.W;
+    int kk = static_cast<int>(W.cols());
+    MatrixXd SW(n, kk);
+    LDLT<MatrixXd> E_fact;
+    if (kk > 0) {
+        VectorXd Sw(n);
+        for (int c = 0; c < kk; ++c) {
+            applyS(W.col(c), Sw);
+            SW.col(c) = Sw;
+        }
+        defl.extra_spmv += kk;
+        MatrixXd E = globalInner(W, SW, comm);
+        E_fact.compute(0.5 * (E + E.transpose()));
+        // 矩阵变化导致 E 不再正定时放弃本次回收
+        if (E_fact.info() != Success || !E_fact.isPositive() ||
+            E_fact.vectorD().minCoeff() <= 1e-14 * E_fact.vectorD().maxCoeff()) {
+            defl.reset();
+            kk = 0;
+            SW.resize(n, 0);
+        }
+    }
+
+    // ===== 右端项 b/vol =====
+    // 全封闭区域（各行系数和为零）时 S 以常向量为零空间，而连续性残差只满足 Σb = 0，
+    // Σ b/vol 一般不为零：去掉 b/vol 的均值使缩放系统相容，否则 CG 残差停在零空间分量上
+    VectorXd bs = b.cwiseProduct(inv_vol);
+    double n_null = 0.0;   // > 0 表示 S 以常向量为零空间（值为全局单元数）
+    {
+        double local_sum[4] = { 0.0, 0.0, bs.sum(), static_cast<double>(n) };
+        for (int k = 0; k < n; ++k) {
+            const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+            local_sum[0] += std::abs(equ.A_p(c) - equ.A_e(c) - equ.A_w(c)
+                                     - equ.A_n(c) - equ.A_s(c));
+            local_sum[1] += std::abs(equ.A_p(c));
+        }
+        double global_sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+        timedAllreduce(local_sum, global_sum, 4, MPI_DOUBLE, MPI_SUM, comm);
+        if (global_sum[0] <= 1e-10 * global_sum[1] && global_sum[3] > 0.0) {
+            bs.array() -= global_sum[2] / global_sum[3];
+            n_null = global_sum[3];
+        }
+    }
+
+    // ===== 初始残差 =====
+    // r 为缩放系统的残差 b/vol − S·x。收敛判据按 CG 实际迭代的 ‖r‖ 计算
+    // （原系统残差 ‖vol ⊙ r‖ 在拉伸网格上随 CG 迭代先升后降）；
+    // 返回值与统计仍用原系统残差，与 PCG_parallel 一致
+    VectorXd r(n), Sp(n);
+    applyS(x, Sp);
+    r = bs - Sp;
+
+    double local_buf3[3]  = { r.squaredNorm(), bs.squaredNorm(), r.cwiseProduct(vol).squaredNorm() };
+    double global_buf3[3] = { 0.0, 0.0, 0.0 };
+    timedAllreduce(local_buf3, global_buf3, 3, MPI_DOUBLE, MPI_SUM, comm);
+    const double initial_r_norm = std::sqrt(global_buf3[0]);
+    const double b_norm         = std::sqrt(global_buf3[1]);
+    const double initial_res    = std::sqrt(global_buf3[2]);
+
+    if (rank == 0 && verbose == 1)
+        std::cout << "  [DPCG] r0 = " << initial_res
+                  << " (recycled vectors: " << kk << ")" << std::endl;
+
+    if (initial_r_norm < 1e-15 ||
+        initial_r_norm / (b_norm + 1e-16) < epsilon) {
+        if (rank == 0 && verbose)
+            std::cout << "  [DPCG] 初始残差已达标。" << std::endl;
+        r0 = initial_res;
+        recordSolve(0, 1, initial_res, initial_res);
+        return;
+    }
+
+    // 初值修正：x += W E⁻¹ Wᵀ r，r -= SW E⁻¹ Wᵀ r
+    if (kk > 0) {
+        VectorXd mu = E_fact.solve(globalInner(W, r, comm));
+        x.noalias() += W * mu;
+        r.noalias() -= SW * mu;
+    }
+
+    // z = M⁻¹r，p = z − W E⁻¹ (SW)ᵀ z；归约缓冲：[r·z, ‖r‖², ‖vol ⊙ r‖², (SW)ᵀz]
+    VectorXd z = inv_diag.cwiseProduct(r);
+    std::vector<double> local_buf(3 + kk), global_buf(3 + kk);
+    auto reduce_rz = [&]() {
+        local_buf[0] = r.dot(z);
+        local_buf[1] = r.squaredNorm();
+        local_buf[2] = r.cwiseProduct(vol).squaredNorm();
+        if (kk > 0) Map<VectorXd>(local_buf.data() + 3, kk) = SW.transpose() * z;
+        timedAllreduce(local_buf.data(), global_buf.data(), 3 + kk,
+                       MPI_DOUBLE, MPI_SUM, comm);
+    };
+    reduce_rz();
+
+    VectorXd p = z;
+    if (kk > 0) p.noalias() -= W * E_fact.solve(Map<VectorXd>(global_buf.data() + 3, kk));
+
+    double current_rz     = global_buf[0];
+    double current_r_norm = std::sqrt(global_buf[1]);
+    double current_res    = std::sqrt(global_buf[2]);
+
+    // 记录前 m 个搜索方向供 Ritz 提取
+    const int m = (defl.k > 0) ? defl.m : 0;
+    MatrixXd P(n, m), SP(n, m);
+    int stored = 0;
+
+    // 不做停滞退出：CG 残差本身不单调，逐步比较的停滞判据在前十几步就会触发，
+    // 而回收空间正是为了让每次求解真正达到 epsilon（上限仍为 max_iter）
+    int exit_status = 0, iter = 0;
+
+    // 修正后的初始残差可能已满足精度
+    if (current_r_norm / initial_r_norm < epsilon) exit_status = 1;
+
+    while (exit_status == 0 && iter < max_iter) {
+        applyS(p, Sp);
+        if (stored < m) {
+            P.col(stored)  = p;
+            SP.col(stored) = Sp;
+            stored++;
+        }
+
+        double local_pSp = p.dot(Sp), global_pSp = 0.0;
+        timedAllreduce(&local_pSp, &global_pSp, 1, MPI_DOUBLE, MPI_SUM, comm);
+        if (std::abs(global_pSp) < 1e-35) { exit_status = 3; break; }
+
+        const double alpha = current_rz / global_pSp;
+        x += alpha * p;
+        r -= alpha * Sp;
+        z  = inv_diag.cwiseProduct(r);
+
+        reduce_rz();
+        const double beta = global_buf[0] / current_rz;
+        p = z + beta * p;
+        if (kk > 0) p.noalias() -= W * E_fact.solve(Map<VectorXd>(global_buf.data() + 3, kk));
+        current_rz     = global_buf[0];
+        current_r_norm = std::sqrt(global_buf[1]);
+        current_res    = std::sqrt(global_buf[2]);
+        iter++;
+
+        // 归约结果各进程一致，直接本地判断，无需广播
+        if (current_r_norm / initial_r_norm < epsilon) exit_status = 1;
+    }
+
+    // ===== 更新回收空间：[W, P] 上的 Rayleigh–Ritz =====
+    // 残差未下降（矩阵不定等导致 CG 失效）时丢弃回收空间，避免错误方向累积
+    if (current_r_norm >= initial_r_norm || exit_status == 3) {
+        defl.reset();
+    } else if (defl.k > 0 && kk + stored > 0) {
+        MatrixXd Z(n, kk + stored), SZ(n, kk + stored);
+        if (kk > 0) {
+            Z.leftCols(kk)  = W;
+            SZ.leftCols(kk) = SW;
+        }
+        Z.rightCols(stored)  = P.leftCols(stored);
+        SZ.rightCols(stored) = SP.leftCols(stored);
+        W = ritzVectors(Z, SZ, defl.k, n_null, comm);
+    }
+
+    defl.solves++;
+    defl.iterations += iter;
+
+    r0 = current_res;
+    recordSolve(iter, exit_status, initial_res, r0);
+
+    if (rank == 0 && verbose == 1) {
+        double rel_res = current_r_norm / initial_r_norm;
+        const char* status =
+            (exit_status == 1) ? "收敛" :
+            (exit_status == 3) ? "数学失效 (p,Ap) ≈ 0" : "达到最大迭代次数";
+        std::cout << "  [DPCG] " << status << ": 相对残差 " << std::scientific
+                  << std::setprecision(3) << rel_res
+                  << " (" << iter << " iterations)" << std::endl;
+    }
+}
+
+void solveFieldPCGDeflated(
+    Equation& equ,
+    Mesh& mesh,
+    MatrixXd& field,
+    double tol,
+    int max_iter,
+    int rank,
+    int num_procs,
+    MPI_Comm comm,
+    double& l2_norm,
+    DeflationSpace& defl,
+    int verbose
+)
+{
+    VectorXd x(mesh.internumber);
+    x.setZero();
+
+    PCG_parallel_deflated(equ, mesh, equ.source, x,
+                          tol, max_iter,
+                          rank, num_procs, comm,
+                          l2_norm, defl, verbose);
+
+    vectorToMatrix(x, field, mesh);
+
+    exchangeColumns(field, mesh, rank, num_procs, comm);
+}
+
+
+// ============================================================================
+// Chebyshev 多项式预条件
+// ============================================================================
+
+void lanczosExtremeEigenvalues(const std::vector<double>& alpha, const std::vector<double>& beta,
+                               double& lmin, double& lmax)
+{
+    // PCG 系数 → Lanczos 三对角矩阵：
+    // T(j,j) = 1/α_j + β_{j-1}/α_{j-1}，T(j,j+1) = √β_j / α_j
+    const int m = static_cast<int>(std::min(alpha.size(), beta.size() + 1));
+    if (m == 0) {
+        lmin = 0.0;
+        lmax = 2.0;   // 对角占优矩阵 D⁻¹A 的 Gershgorin 上界
+        return;
+    }
+    MatrixXd T = MatrixXd::Zero(m, m);
+    for (int j = 0; j < m; ++j) {
+        T(j, j) = 1.0 / alpha[j] + (j > 0 ? beta[j - 1] / alpha[j - 1] : 0.0);
+        if (j + 1 < m) T(j, j + 1) = T(j + 1, j) = std::sqrt(beta[j]) / alpha[j];
+    }
+    SelfAdjointEigenSolver<MatrixXd> es(T, EigenvaluesOnly);
+    lmin = es.eigenvalues()(0);
+    lmax = es.eigenvalues()(m - 1);
+}
+
+void chebyshevSmooth(const SparseMatrix<double>& A, const HaloPlan& halo,
+                     const VectorXd& inv_diag, double lmin, double lmax, int degree,
+                     const VectorXd& b, VectorXd& x, bool zero_guess,
+                     int rank, int num_procs, MPI_Comm comm)
+{
+    const int n = static_cast<int>(b.size());
+    const double theta = 0.5 * (lmax + lmin);
+    const double delta = 0.5 * (lmax - lmin);
+    const double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+
+    VectorXd r(n), Ad(n);
+    if (zero_guess) {
+        r = b;
+        x.setZero(n);
+    } else {
+        Ad.noalias() = A * x;
+        halo.apply(x, Ad, rank, num_procs, comm);
+        r = b - Ad;
+    }
+
+    // 三项递推（Saad, Alg. 12.1），以 D⁻¹ 作内层缩放；全程无内积
+    VectorXd d = inv_diag.cwiseProduct(r) / theta;
+    x += d;
+    for (int k = 1; k < degree; ++k) {
+        Ad.noalias() = A * d;
+        halo.apply(d, Ad, rank, num_procs, comm);
+        r -= Ad;
+        const double rho_new = 1.0 / (2.0 * sigma - rho);
+        d = (rho_new * rho) * d + (2.0 * rho_new / delta) * inv_diag.cwiseProduct(r);
+        x += d;
+        rho = rho_new;
+    }
+}
+
+void PCG_parallel_cheb(Equation& equ, const Mesh& mesh, VectorXd& b, VectorXd& x,
+                       double epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                       double& r0, ChebyshevPrecond& cheb, int verbose)
+{
+    const int n = equ.A.rows();
+    const SparseMatrix<double>& A = equ.A;
+
+    HaloPlan halo;
+    halo.build(mesh, equ);
+    auto applyA = [&](const VectorXd& v, VectorXd& Av) {
+        Av.noalias() = A * v;
+        halo.apply(v, Av, rank, num_procs, comm);
+    };
+
+    // 固定步数时在对称化系统上迭代：压力修正方程 A = diag(vol)·S，内积取 1/vol 权重，
+    // CG 在对称的 S 上进行（同 PCG_parallel_deflated）。自适应求解保持不加权：拉伸网格上
+    // 对称化后压力修正解得过准，SIMPLE 外迭代发散（见 --recycle），原判据的提前停滞退出反而稳定
+    VectorXd inv_diag(n), inv_vol = VectorXd::Ones(n);
+    for (int k = 0; k < n; ++k) {
+        const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+        double d = equ.A_p(c);
+        inv_diag[k] = (std::abs(d) > 1e-14) ? 1.0 / d : 1.0;
+        if (cheb.fixed && mesh.vol(c) > 0.0) inv_vol[k] = 1.0 / mesh.vol(c);
+    }
+
+    // ===== 右端项相容化（仅固定步数）=====
+    // 各行系数和为零时 S 以常向量为零空间，去掉 b/vol 的均值，否则 CG 沿零空间分量发散
+    VectorXd bc = b;
+    if (cheb.fixed) {
+        double local_sum[4] = { 0.0, 0.0, b.cwiseProduct(inv_vol).sum(), static_cast<double>(n) };
+        for (int k = 0; k < n; ++k) {
+            const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+            local_sum[0] += std::abs(equ.A_p(c) - equ.A_e(c) - equ.A_w(c)
+                                     - equ.A_n(c) - equ.A_s(c));
+            local_sum[1] += std::abs(equ.A_p(c));
+        }
+        double global_sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+        timedAllreduce(local_sum, global_sum, 4, MPI_DOUBLE, MPI_SUM, comm);
+        if (global_sum[0] <= 1e-10 * global_sum[1] && global_sum[3] > 0.0)
+            bc -= (global_sum[2] / global_sum[3]) * inv_vol.cwiseInverse();
+    }
+
+    // ===== 初始残差 =====
+    // 判据按 CG 实际迭代的缩放残差 ‖r/vol‖ 计算；返回值与统计仍用原系统残差
+    VectorXd r(n), Ap(n);
+    applyA(x, Ap);
+    r = bc - Ap;
+
+    double local_buf3[3]  = { r.cwiseProduct(inv_vol).squaredNorm(),
+                              bc.cwiseProduct(inv_vol).squaredNorm(), r.squaredNorm() };
+    double global_buf3[3] = { 0.0, 0.0, 0.0 };
+    timedAllreduce(local_buf3, global_buf3, 3, MPI_DOUBLE, MPI_SUM, comm);
+    const double initial_r_norm = std::sqrt(global_buf3[0]);
+    const double b_norm         = std::sqrt(global_buf3[1]);
+    const double initial_res    = std::sqrt(global_buf3[2]);
+
+    if (initial_r_norm < 1e-15 ||
+        (!cheb.fixed && initial_r_norm / (b_norm + 1e-16) < epsilon)) {
+        if (rank == 0 && verbose)
+            std::cout << "  [ChebPCG] 初始残差已达标。" << std::endl;
+        r0 = initial_res;
+        recordSolve(0, 1, initial_res, initial_res);
+        return;
+    }
+
+    // ===== 谱估计：按 refresh 间隔，本次求解的前 lanczos_steps 步改用 Jacobi 预条件 =====
+    // 记录这几步的 PCG 系数 α / β 组成 Lanczos 三对角阵（矩阵随 SIMPLE 迭代缓慢变化），
+    // 估计完成后同一次求解切换为 Chebyshev 预条件并以 β = 0 重启方向，不另做归约
+    bool estimating = !cheb.valid || (!cheb.fixed && cheb.refresh > 0 && cheb.solves % cheb.refresh == 0);
+    bool restart    = false;
+    std::vector<double> lanczos_alpha, lanczos_beta;
+    auto finishEstimate = [&]() {
+        double lo = 0.0, hi = 0.0;
+        lanczosExtremeEigenvalues(lanczos_alpha, lanczos_beta, lo, hi);
+        // Lanczos 的 λmax 从下方逼近，需放大；λmin 偏大无妨（低端模态仍被放大而非反号）
+        cheb.lmax  = cheb.safety * hi;
+        cheb.lmin  = std::min(std::max(lo, 1e-6 * cheb.lmax), 0.5 * cheb.lmax);
+        cheb.valid = !lanczos_alpha.empty();
+        cheb.estimates++;
+        estimating = false;
+    };
+
+    if (rank == 0 && verbose == 1) {
+        std::cout << "  [ChebPCG] r0 = " << initial_res;
+        if (estimating) std::cout << " (前 " << cheb.lanczos_steps << " 步 Jacobi 预条件，估计谱区间)"
+                                  << std::endl;
+        else            std::cout << " (degree " << cheb.degree << ", λ ∈ [" << cheb.lmin
+                                  << ", " << cheb.lmax << "])" << std::endl;
+    }
+
+    auto precondition = [&](const VectorXd& res, VectorXd& z) {
+        if (estimating) z = inv_diag.cwiseProduct(res);
+        else chebyshevSmooth(A, halo, inv_diag, cheb.lmin, cheb.lmax, cheb.degree,
+                             res, z, true, rank, num_procs, comm);
+    };
+
+    VectorXd z(n);
+    precondition(r, z);
+    VectorXd p = z;
+
+    double local_rz = r.cwiseProduct(inv_vol).dot(z), current_rz = 0.0;
+    timedAllreduce(&local_rz, &current_rz, 1, MPI_DOUBLE, MPI_SUM, comm);
+    double current_r_norm = initial_r_norm, current_res = initial_res;
+
+    double prev_r_norm   = current_r_norm;
+    int stagnation_count = 0;
+    const int    max_stagnation   = 3;
+    const double stagnation_tol   = 1e-6;
+    const int    min_iter_protect = 5;
+    int exit_status = 0, iter = 0;
+
+    while (iter < max_iter) {
+        applyA(p, Ap);
+
+        double local_pAp = p.cwiseProduct(inv_vol).dot(Ap), global_pAp = 0.0;
+        timedAllreduce(&local_pAp, &global_pAp, 1, MPI_DOUBLE, MPI_SUM, comm);
+        if (std::abs(global_pAp) < 1e-35) { exit_status = 3; break; }
+
+        const double alpha = current_rz / global_pAp;
+        x += alpha * p;
+        r -= alpha * Ap;
+        if (estimating) {
+            // 非正定方向上 Lanczos 关系失效，以已有系数结束估计
+            if (global_pAp > 0.0) lanczos_alpha.push_back(alpha);
+            if (global_pAp <= 0.0 || static_cast<int>(lanczos_alpha.size()) >= cheb.lanczos_steps) {
+                finishEstimate();
+                restart = true;
+            }
+        }
+        precondition(r, z);
+
+        double local_buf[3]  = { r.cwiseProduct(inv_vol).dot(z),
+                                 r.cwiseProduct(inv_vol).squaredNorm(), r.squaredNorm() };
+        double global_buf[3] = { 0.0, 0.0, 0.0 };
+        timedAllreduce(local_buf, global_buf, 3, MPI_DOUBLE, MPI_SUM, comm);
+
+        // 预条件切换后前后方向不再共轭，以 β = 0 重启
+        const double beta = restart ? 0.0 : global_buf[0] / current_rz;
+        if (estimating) lanczos_beta.push_back(beta);
+        restart = false;
+        p = z + beta * p;
+        current_rz     = global_buf[0];
+        current_r_norm = std::sqrt(global_buf[1]);
+        current_res    = std::sqrt(global_buf[2]);
+        iter++;
+
+        // 归约结果各进程一致，直接本地判断，无需广播
+        if (cheb.fixed) {
+            // 固定步数：求解为右端项的确定映射（供 Anderson 混合）
+        } else if (current_r_norm / initial_r_norm < epsilon) {
+            exit_status = 1;
+            break;
+        } else if (iter > min_iter_protect) {
+            double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
+            stagnation_count = (drop_rate < stagnation_tol) ? stagnation_count + 1 : 0;
+            if (stagnation_count >= max_stagnation) { exit_status = 2; break; }
+        }
+        prev_r_norm = current_r_norm;
+    }
+
+    if (estimating) finishEstimate();   // 估计步数内已收敛
+    // 不定 / 非对称矩阵上谱估计可能失准：残差未下降时下次求解重新估计
+    if (exit_status == 3 || (!cheb.fixed && current_r_norm >= initial_r_norm)) cheb.valid = false;
+
+    cheb.solves++;
+    cheb.iterations += iter;
+
+    r0 = current_res;
+    recordSolve(iter, exit_status, initial_res, r0);
+
+    if (rank == 0 && verbose == 1) {
+        double rel_res = current_r_norm / initial_r_norm;
+        const char* status =
+            (exit_status == 1) ? "收敛" :
+            (exit_status == 2) ? "停滞退出" :
+            (exit_status == 3) ? "数学失效 (p,Ap) ≈ 0" : "达到最大迭代次数";
+        std::cout << "  [ChebPCG] " << status << ": 相对残差 " << std::scientific
+                  << std::setprecision(3) << rel_res
+                  << " (" << iter << " iterations)" << std::endl;
+    }
+}
+
+void solveFieldPCGCheb(
+    Equation& equ,
+    Mesh& mesh,
+    MatrixXd& field,
+    double tol,
+    int max_iter,
+    int rank,
+    int num_procs,
+    MPI_Comm comm,
+    double& l2_norm,
+    ChebyshevPrecond& cheb,
+    int verbose
+)
+{
+    VectorXd x(mesh.internumber);
+    x.setZero();
+
+    PCG_parallel_cheb(equ, mesh, equ.source, x,
+                      tol, max_iter,
+                      rank, num_procs, comm,
+                      l2_norm, cheb, verbose);
+
+    vectorToMatrix(x, field, mesh);
+
+    exchangeColumns(field, mesh, rank, num_procs, comm);
+}
+
+
+void smoothFieldCheb(Equation& equ, Mesh& mesh, MatrixXd& field,
+                     int sweeps, int degree, double ratio,
+                     int rank, int num_procs, MPI_Comm comm)
+{
+    const int n = mesh.internumber;
+    HaloPlan halo;
+    halo.build(mesh, equ);
+
+    VectorXd inv_diag(n);
+    for (int k = 0; k < n; ++k) {
+        double d = equ.A_p(mesh.cell(mesh.interi[k], mesh.interj[k]));
+        inv_diag[k] = (std::abs(d) > 1e-14) ? 1.0 / d : 1.0;
+    }
+
+    const double lmax = 2.0;
+    VectorXd x = VectorXd::Zero(n);
+    for (int s = 0; s < sweeps; ++s) {
+        chebyshevSmooth(equ.A, halo, inv_diag, lmax / ratio, lmax, degree,
+                        equ.source, x, s == 0, rank, num_procs, comm);
+    }
+
+    vectorToMatrix(x, field, mesh);
+    exchangeColumns(field, mesh, rank, num_procs, comm);
+}
+
+
+// ============================================================================
+// s-step（通信规避）PCG
+// ============================================================================
+
+void PCG_parallel_sstep(Equation& equ, const Mesh& mesh, VectorXd& b, VectorXd& x,
+                        double epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                        double& r0, SStepConfig& cfg, int verbose)
+{
+    const int n = equ.A.rows();
+    const int s = std::max(1, cfg.s);
+    const SparseMatrix<double>& A = equ.A;
+
+    HaloPlan halo;
+    halo.build(mesh, equ);
+    auto applyA = [&](const VectorXd& v, VectorXd& Av) {
+        Av.noalias() = A * v;
+        halo.apply(v, Av, rank, num_procs, comm);
+    };
+
+    // Jacobi 对角与 D⁻¹A 的 Gershgorin 区间（Chebyshev 基的参数，每次求解一次 MPI_MAX）
+    VectorXd inv_diag(n);
+    double local_g[2] = { 0.0, -1e300 };
+    for (int k = 0; k < n; ++k) {
+        const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+        double d = equ.A_p(c);
+        inv_diag[k] = (std::abs(d) > 1e-14) ? 1.0 / d : 1.0;
+        double rho = (std::abs(equ.A_e(c)) + std::abs(equ.A_w(c)) +
+                      std::abs(equ.A_n(c)) + std::abs(equ.A_s(c))) * std::abs(inv_diag[k]);
+        local_g[0] = std::max(local_g[0], 1.0 + rho);
+        local_g[1] = std::max(local_g[1], rho - 1.0);
+    }
+    double global_g[2] = { 0.0, 0.0 };
+    timedAllreduce(local_g, global_g, 2, MPI_DOUBLE, MPI_MAX, comm);
+    const double lmax  = global_g[0];
+    const double lmin  = std::max(0.0, -global_g[1]);
+    const double theta = 0.5 * (lmax + lmin);
+    const double delta = std::max(0.5 * (lmax - lmin), 1e-12);
+
+    // ===== 初始残差 =====
+    VectorXd r(n), pj(n), apj(n);
+    applyA(x, apj);
+    r = b - apj;
+
+    double local_buf2[2]  = { r.squaredNorm(), b.squaredNorm() };
+    double global_buf2[2] = { 0.0, 0.0 };
+    timedAllreduce(local_buf2, global_buf2, 2, MPI_DOUBLE, MPI_SUM, comm);
+    const double initial_r_norm = std::sqrt(global_buf2[0]);
+    const double b_norm         = std::sqrt(global_buf2[1]);
+
+    if (rank == 0 && verbose == 1)
+        std::cout << "  [sCG] r0 = " << initial_r_norm << " (s = " << s
+                  << (cfg.chebyshev_basis ? ", Chebyshev 基" : ", 单项式基") << ")" << std::endl;
+
+    if (initial_r_norm < 1e-15 ||
+        initial_r_norm / (b_norm + 1e-16) < epsilon) {
+        if (rank == 0 && verbose)
+            std::cout << "  [sCG] 初始残差已达标。" << std::endl;
+        r0 = initial_r_norm;
+        recordSolve(0, 1, initial_r_norm, initial_r_norm);
+        return;
+    }
+
+    // P：本轮 Krylov 基，W：上一轮的搜索方向块（A-正交化用），AP / AW 为对应的 A·块
+    MatrixXd P(n, s), AP(n, s), W(n, s), AW(n, s), Q(n, s), AQ(n, s);
+    LDLT<MatrixXd> D_prev;
+    bool have_prev = false;
+
+    // 归约缓冲：[PᵀAP (s²) | Pᵀr (s) | ‖r‖² | (AW)ᵀP (s²) | Wᵀr (s)]
+    const int nbuf = 2 * s * s + 2 * s + 1;
+    std::vector<double> local_buf(nbuf, 0.0), global_buf(nbuf, 0.0);
+
+    double current_r_norm = initial_r_norm;
+    double prev_r_norm    = current_r_norm;
+    int stagnation_count  = 0;
+    const int    max_stagnation   = 3;
+    const double stagnation_tol   = 1e-6;
+    const int    min_iter_protect = 5;
+    int exit_status = 0, iter = 0, rounds = 0;
+
+    while (iter < max_iter) {
+        // ── 基向量：s 次 SpMV，每次仅一次相邻进程间的接口交换 ──
+        // Chebyshev 基：p₁ = (D⁻¹A − θ)p₀/δ，p_{j+1} = 2(D⁻¹A − θ)p_j/δ − p_{j−1}
+        pj = inv_diag.cwiseProduct(r);
+        P.col(0) = pj;
+        for (int j = 0; j < s; ++j) {
+            applyA(pj, apj);
+            AP.col(j) = apj;
+            if (j + 1 == s) break;
+            VectorXd t = inv_diag.cwiseProduct(apj);
+            if (cfg.chebyshev_basis) {
+                t -= theta * pj;
+                pj = (j == 0) ? VectorXd(t / delta) : VectorXd(2.0 / delta * t - P.col(j - 1));
+            } else {
+                pj = t;
+            }
+            P.col(j + 1) = pj;
+        }
+
+        // ── 一次 Allreduce 得到全部 Gram 信息 ──
+        Map<MatrixXd>(local_buf.data(), s, s) = P.transpose() * AP;
+        Map<VectorXd>(local_buf.data() + s * s, s) = P.transpose() * r;
+        local_buf[s * s + s] = r.squaredNorm();
+        if (have_prev) {
+            Map<MatrixXd>(local_buf.data() + s * s + s + 1, s, s) = AW.transpose() * P;
+            Map<VectorXd>(local_buf.data() + 2 * s * s + s + 1, s) = W.transpose() * r;
+        }
+        timedAllreduce(local_buf.data(), global_buf.data(), nbuf,
+                       MPI_DOUBLE, MPI_SUM, comm);
+        rounds++;
+
+        current_r_norm = std::sqrt(global_buf[s * s + s]);
+        if (current_r_norm / initial_r_norm < epsilon) { exit_status = 1; break; }
+        if (iter > min_iter_protect) {
+            double drop_rate = (prev_r_norm - current_r_norm) / prev_r_norm;
+            stagnation_count = (drop_rate < stagnation_tol) ? stagnation_count + 1 : 0;
+            if (stagnation_count >= max_stagnation) { exit_status = 2; break; }
+        }
+        prev_r_norm = current_r_norm;
+
+        // ── 与上一块 A-正交：Q = P − W·B，B = (WᵀAW)⁻¹(AW)ᵀP ──
+        MatrixXd G = Map<MatrixXd>(global_buf.data(), s, s);
+        VectorXd c = Map<VectorXd>(global_buf.data() + s * s, s);
+        if (have_prev) {
+            Map<MatrixXd> G1(global_buf.data() + s * s + s + 1, s, s);
+            Map<VectorXd> Wr(global_buf.data() + 2 * s * s + s + 1, s);
+            MatrixXd B = D_prev.solve(G1);
+            Q.noalias()  = P - W * B;
+            AQ.noalias() = AP - AW * B;
+            G -= G1.transpose() * B;            // QᵀAQ = PᵀAP − (AW ᵀP)ᵀB（A 对称）
+            c -= B.transpose() * Wr;
+        } else {
+            Q  = P;
+            AQ = AP;
+        }
+
+        LDLT<MatrixXd> D(0.5 * (G + G.transpose()));
+        if (D.info() != Success || !D.isPositive() ||
+            D.vectorD().minCoeff() <= 1e-14 * D.vectorD().maxCoeff()) {
+            exit_status = 3;                     // 基向量线性相关（s 过大或已收敛到舍入水平）
+            break;
+        }
+
+        // ── 一次推进 s 步 ──
+        VectorXd a = D.solve(c);
+        x.noalias() += Q * a;
+        r.noalias() -= AQ * a;
+
+        W.swap(Q);
+        AW.swap(AQ);
+        D_prev = D;
+        have_prev = true;
+        iter += s;
+    }
+
+    cfg.solves++;
+    cfg.iterations += iter;
+    cfg.rounds     += rounds;
+
+    r0 = current_r_norm;
+    recordSolve(iter, exit_status, initial_r_norm, r0);
+
+    if (rank == 0 && verbose == 1) {
+        double rel_res = r0 / initial_r_norm;
+        const char* status =
+            (exit_status == 1) ? "收敛" :
+            (exit_status == 2) ? "停滞退出" :
+            (exit_status == 3) ? "Gram 矩阵奇异" : "达到最大迭代次数";
+        std::cout << "  [sCG] " << status << ": 相对残差 " << std::scientific
+                  << std::setprecision(3) << rel_res
+                  << " (" << iter << " iterations, " << rounds << " rounds)" << std::endl;
+    }
+}
+
+void solveFieldPCGSStep(
+    Equation& equ,
+    Mesh& mesh,
+    MatrixXd& field,
+    double tol,
+    int max_iter,
+    int rank,
+    int num_procs,
+    MPI_Comm comm,
+    double& l2_norm,
+    SStepConfig& cfg,
+    int verbose
+)
+{
+    VectorXd x(mesh.internumber);
+    x.setZero();
+
+    PCG_parallel_sstep(equ, mesh, equ.source, x,
+                       tol, max_iter,
+                       rank, num_procs, comm,
+                       l2_norm, cfg, verbose);
+
+    vectorToMatrix(x, field, mesh);
+
+    exchangeColumns(field, mesh, rank, num_procs, comm);
+}
+
+
+// ============================================================================
+// 非精确 SIMPLE：Eisenstat–Walker 线性求解精度
+// ============================================================================
+
+double InexactTolerance::begin(Equation& equ, const Mesh& mesh, const MatrixXd* start,
+                              int rank, int num_procs, MPI_Comm comm)
+{
+    warm = false;
+    if (!enabled) return tol_fixed;
+
+    // 外层残差 F = b − A·φ*（动量方程）或 b（压力修正方程，零初值）
+    const int n = mesh.internumber;
+    double local_sq = 0.0;
+    if (start) {
+        x_old.resize(n);
+        matrixToVector(*start, x_old, mesh);
+        HaloPlan halo;
+        halo.build(mesh, equ);
+        VectorXd Ax(n);
+        Ax.noalias() = equ.A * x_old;
+        halo.apply(x_old, Ax, rank, num_procs, comm);
+        saved_source = equ.source;
+        equ.source   = saved_source - Ax;       // 改解修正量 A·δ = F，零初值即从 φ 出发
+        warm = true;
+    }
+    local_sq = equ.source.squaredNorm();
+    double global_sq = 0.0;
+    timedAllreduce(&local_sq, &global_sq, 1, MPI_DOUBLE, MPI_SUM, comm);
+    const double res = std::sqrt(global_sq);
+
+    // η_k = γ (‖F_k‖/‖F_{k−1}‖)^α；γ η_{k−1}^α > 0.1 时取二者较大值，防止 η 骤降
+    double eta_k = eta_max;
+    if (prev_res > 0.0) {
+        eta_k = gamma * std::pow(res / prev_res, alpha);
+        const double safeguard = gamma * std::pow(eta, alpha);
+        if (safeguard > 0.1) eta_k = std::max(eta_k, safeguard);
+    }
+    eta      = std::min(std::max(eta_k, tol_min), eta_max);
+    prev_res = res;
+    return eta;
+}
+
+void InexactTolerance::end(Equation& equ, const Mesh& mesh, MatrixXd* field,
+                           int rank, int num_procs, MPI_Comm comm)
+{
+    solves++;
+    iterations += solver_stats.iterations;
+    if (!warm) return;
+
+    // φ = φ* + δ，恢复原右端项
+    VectorXd x(mesh.internumber);
+    matrixToVector(*field, x, mesh);
+    x += x_old;
+    vectorToMatrix(x, *field, mesh);
+    exchangeColumns(*field, mesh, rank, num_procs, comm);
+    equ.source.swap(saved_source);
+    warm = false;
+}
+
+
+// ============================================================================
+// Anderson 加速（SIMPLE 外迭代）
+// ============================================================================
+
+void AndersonMixer::build(const Mesh& mesh)
+{
+    entries.clear();
+    std::vector<double> w;
+    // 面场的东 / 南面与西 / 北侧单元同号（见 Mesh::xface / yface）
+    auto add = [&](MatrixXd Mesh::* field, int group, int i, int j, double wt) {
+        const int idx = (field == &Mesh::u_face) ? mesh.xface(i, j)
+                      : (field == &Mesh::v_face) ? mesh.yface(i, j) : mesh.cell(i, j);
+        entries.push_back({ field, group, idx });
+        w.push_back(wt);
+    };
+    for (int k = 0; k < mesh.internumber; ++k) {
+        const int i = mesh.interi[k];
+        const int j = mesh.interj[k];
+        add(&Mesh::u_star, 0, i, j, 1.0);
+        add(&Mesh::v_star, 1, i, j, 1.0);
+        add(&Mesh::p,      2, i, j, 1.0);
+        add(&Mesh::u_face, 3, i, j, 1.0);          // 东面
+        add(&Mesh::v_face, 4, i, j, 1.0);          // 南面
+        // 西 / 北邻不是内部单元时该面不会作为其他单元的东 / 南面出现，单独加入；
+        // 与左侧 ghost 相邻的西面属于左邻进程（其东面）：同样混合以保持两侧一致，但不计入内积
+        if (mesh.nb_w[k] < 0)
+            add(&Mesh::u_face, 3, i, j - 1, (mesh.bctype(i, j - 1) == -3) ? 0.0 : 1.0);
+        if (mesh.nb_n[k] < 0) add(&Mesh::v_face, 4, i - 1, j, 1.0);
+    }
+    weight = Map<VectorXd>(w.data(), w.size());
+    scaled = false;
+    reset();
+}
+
+void AndersonMixer::reset()
+{
+    const int n = static_cast<int>(entries.size());
+    dF.setZero(n, std::max(depth, 1));
+    dG.setZero(n, std::max(depth, 1));
+    cols = 0;
+    next = 0;
+    have_prev = false;
+    res_min = -1.0;
+}
+
+void AndersonMixer::gather(const Mesh& mesh, VectorXd& v) const
+{
+    v.resize(entries.size());
+    for (size_t e = 0; e < entries.size(); ++e)
+        v[e] = (mesh.*entries[e].field)(entries[e].idx);
+}
+
+void AndersonMixer::scatter(const VectorXd& v, Mesh& mesh) const
+{
+    for (size_t e = 0; e < entries.size(); ++e)
+        (mesh.*entries[e].field)(entries[e].idx) = v[e];
+}
+
+void AndersonMixer::capture(const Mesh& mesh)
+{
+    gather(mesh, x);
+}
+
+/// 按位判断有限值（-ffast-math 下 std::isfinite 可能被优化为常量 true）
+static bool finiteBits(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return ((bits >> 52) & 0x7ff) != 0x7ff;
+}
+
+double AndersonMixer::mix(Mesh& mesh, int rank, int num_procs, MPI_Comm comm)
+{
+    VectorXd g;
+    gather(mesh, g);
+    VectorXd f = g - x;
+
+    // 首次调用时按各分组（u*, v*, p, u_face, v_face）的均方残差归一化内积权重，
+    // 避免量级较大的压力主导最小二乘
+    if (!scaled) {
+        double local_ss[2 * NGROUP] = { 0.0 }, global_ss[2 * NGROUP] = { 0.0 };
+        for (size_t e = 0; e < entries.size(); ++e) {
+            local_ss[entries[e].group]          += weight[e] * f[e] * f[e];
+            local_ss[NGROUP + entries[e].group] += weight[e];
+        }
+        timedAllreduce(local_ss, global_ss, 2 * NGROUP, MPI_DOUBLE, MPI_SUM, comm);
+        for (size_t e = 0; e < entries.size(); ++e) {
+            const int grp = entries[e].group;
+            const double ms = global_ss[grp] / std::max(global_ss[NGROUP + grp], 1.0);
+            if (ms > 0.0) weight[e] /= ms;
+        }
+        scaled = true;
+    }
+
+    // 历史差分（环形缓冲，最小二乘与列顺序无关）
+    if (depth > 0 && have_prev) {
+        dF.col(next) = f - f_prev;
+        dG.col(next) = g - g_prev;
+        next = (next + 1) % depth;
+        cols = std::min(cols + 1, depth);
+    }
+    f_prev = f;
+    g_prev = g;
+    have_prev = true;
+
+    // 一次 Allreduce：[ΔFᵀWΔF (m²) | ΔFᵀWf (m) | fᵀWf]
+    const int m = cols;
+    std::vector<double> local_buf(m * m + m + 1), global_buf(m * m + m + 1);
+    const VectorXd wf = weight.cwiseProduct(f);
+    if (m > 0) {
+        const MatrixXd WdF = weight.asDiagonal() * dF.leftCols(m);
+        Map<MatrixXd>(local_buf.data(), m, m) = dF.leftCols(m).transpose() * WdF;
+        Map<VectorXd>(local_buf.data() + m * m, m) = dF.leftCols(m).transpose() * wf;
+    }
+    local_buf[m * m + m] = f.dot(wf);
+    timedAllreduce(local_buf.data(), global_buf.data(), m * m + m + 1,
+                   MPI_DOUBLE, MPI_SUM, comm);
+    const double res = std::sqrt(global_buf[m * m + m]);
+
+    if (depth == 0 || ++steps < start) return res;
+
+    // 残差相对历史最小值显著增大（或已非有限值）时清空历史（Anderson 的常用重启策略）
+    if (!finiteBits(res) || (res_min > 0.0 && res > restart * res_min)) {
+        reset();
+        f_prev = f;
+        g_prev = g;
+        have_prev = true;
+        restarts++;
+        return res;
+    }
+    res_min = (res_min < 0.0) ? res : std::min(res_min, res);
+
+    // x_{k+1} = x_k + βf_k − (ΔX + βΔF)γ，γ = argmin ‖f_k − ΔFγ‖_W，ΔX = ΔG − ΔF
+    VectorXd x_new = x + beta * f;
+    if (m > 0) {
+        MatrixXd H = Map<MatrixXd>(global_buf.data(), m, m);
+        H.diagonal().array() += 1e-12 * H.diagonal().maxCoeff();
+        VectorXd gamma = H.ldlt().solve(Map<VectorXd>(global_buf.data() + m * m, m));
+        if (!finiteBits(gamma.sum())) {   // 最小二乘失效：清空历史，本步保留 G(x)
+            reset();
+            f_prev = f;
+            g_prev = g;
+            have_prev = true;
+            restarts++;
+            return res;
+        }
+        x_new.noalias() -= (dG.leftCols(m) - (1.0 - beta) * dF.leftCols(m)) * gamma;
+    }
+    scatter(x_new, mesh);
+    mesh.p_star = mesh.p;
+    exchangeColumns(mesh.p, mesh, rank, num_procs, comm);
+    mixes++;
+    return res;
+}
+
+
+// ============================================================================
+// 监测点（探针）时间序列输出
+// ============================================================================
+
+void ProbeSet::load(const std::string& path, int rank, MPI_Comm comm)
+{
+    std::string text;
+    if (rank == 0) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("无法打开探针文件: " + path);
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') continue;
+            text += line + "\n";
+        }
+    }
+    int len = static_cast<int>(text.size());
+    MPI_Bcast(&len, 1, MPI_INT, 0, comm);
+    text.resize(len);
+    MPI_Bcast(&text[0], len, MPI_CHAR, 0, comm);
+
+    names.clear();  px.clear();  py.clear();
+    std::istringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line)) {
+        std::istringstream ls(line);
+        std::string name;
+        double x, y;
+        if (!(ls >> name >> x >> y)) {
+            throw std::runtime_error("探针文件格式错误（应为 <名称> <x> <y>）: " + line);
+        }
+        names.push_back(name);
+        px.push_back(x);
+        py.push_back(y);
+    }
+}
+
+void ProbeSet::resolve(const Mesh& mesh, int rank, int num_procs)
+{
+    terms.clear();
+    const int nx = mesh.nx, ny = mesh.ny;
+
+    // 沿一维坐标找包围区间 [k, k+1] 与权重 t（坐标可递增或递减）；越过端点时按需钳制
+    auto bracket = [](auto coord, int n, double v, bool clamp_first, bool clamp_last,
+                      int& k, double& t) -> bool {
+        const double dir = (coord(n - 1) >= coord(0)) ? 1.0 : -1.0;
+        if (dir * (v - coord(0)) < 0.0) {
+            k = 0;  t = 0.0;
+            return clamp_first;
+        }
+        if (dir * (v - coord(n - 1)) > 0.0) {
+            k = n - 2;  t = 1.0;
+            return clamp_last;
+        }
+        for (k = 0; k < n - 2; ++k) {
+            if (dir * (v - coord(k + 1)) <= 0.0) break;
+        }
+        const double d = coord(k + 1) - coord(k);
+        t = (std::abs(d) > 0.0) ? (v - coord(k)) / d : 0.0;
+        return true;
+    };
+
+    auto owned = [&](int j) { return mesh.bctype(0, j) != -3; };
+    auto xcol = [&](int j) { return mesh.x_c(0, j); };
+
+    for (size_t q = 0; q < names.size(); ++q) {
+        int j, i;
+        double tx, ty;
+        // 仅首 / 末进程在 x 方向钳制，中间进程的越界点由相邻进程负责
+        if (!bracket(xcol, nx, px[q], rank == 0, rank == num_procs - 1, j, tx)) continue;
+        auto yrow = [&](int r) { return mesh.y_c(r, j); };
+        if (!bracket(yrow, ny, py[q], true, true, i, ty)) continue;
+
+        const int    cj[2] = { j, j + 1 };
+        const int    ci[2] = { i, i + 1 };
+        const double wx[2] = { 1.0 - tx, tx };
+        const double wy[2] = { 1.0 - ty, ty };
+        for (int a = 0; a < 2; ++a)
+            for (int b = 0; b < 2; ++b)
+                if (owned(cj[b]) && wy[a] * wx[b] != 0.0)
+                    terms.push_back({ static_cast<int>(q), ci[a], cj[b], wy[a] * wx[b] });
+    }
+}
+
+void ProbeSet::open(const std::string& file, int rank, int restart_step)
+{
+    samples = 0;
+    if (rank != 0) return;
+    fs::path p(file);
+    if (p.has_parent_path()) fs::create_directories(p.parent_path());
+    const bool append = (restart_step >= 0 && fs::exists(p));
+    if (append) {
+        // 截掉检查点之后写出的行：这些步重启后会重新计算并写出
+        std::ifstream in(p);
+        std::string line, kept;
+        if (std::getline(in, line)) kept = line + '\n';
+        while (std::getline(in, line)) {
+            if (std::stol(line.substr(0, line.find(','))) <= restart_step) kept += line + '\n';
+        }
+        in.close();
+        std::ofstream(p, std::ios::trunc) << kept;
+    }
+    const bool header = !append;
+    out.open(p, header ? std::ios::out : std::ios::app);
+    if (!out) throw std::runtime_error("无法创建探针输出文件: " + file);
+    if (header) {
+        out << "step,time";
+        for (const std::string& name : names) out << ',' << name << ".u," << name << ".v," << name << ".p";
+        out << '\n';
+    }
+    out << std::scientific << std::setprecision(10);
+}
+
+void ProbeSet::sample(const Mesh& mesh, int step, double time, int rank, MPI_Comm comm)
+{
+    const int n = static_cast<int>(names.size());
+    std::vector<double> local(3 * n, 0.0), global(3 * n, 0.0);
+    for (const Term& t : terms) {
+        local[3 * t.probe]     += t.w * mesh.u_star(t.i, t.j);
+        local[3 * t.probe + 1] += t.w * mesh.v_star(t.i, t.j);
+        local[3 * t.probe + 2] += t.w * mesh.p(t.i, t.j);
+    }
+    double t0 = MPI_Wtime();
+    MPI_Reduce(local.data(), global.data(), 3 * n, MPI_DOUBLE, MPI_SUM, 0, comm);
+    total_comm_time += MPI_Wtime() - t0;
+    total_comm_count++;
+
+    samples++;
+    if (rank != 0) return;
+    out << step << ',' << time;
+    for (double v : global) out << ',' << v;
+    out << '\n';
+}
+
+// ============================================================================
+// 检查点 / 重启
+// ============================================================================
+
+namespace {
+
+struct CheckpointHeader {
+    char    magic[8];
+    int32_t nx, ny, step, nfields;
+    double  time;
+    int64_t samples;   // 时间平均统计的样本数（nstats > 0 时有效）
+    int32_t nstats;    // 场之后的统计累积量个数（0 = 无统计）
+    char    pad[20];
+};
+static_assert(sizeof(CheckpointHeader) == 64, "检查点文件头须为 64 字节");
+
+const char CHECKPOINT_MAGIC[8] = { 'T', 'A', 'I', 'H', 'O', 'C', 'K', '1' };
+
+// 全局布局中的一个场（列优先）：行 / 列数相对单元场 ny × nx 的差值
+struct CheckpointField {
+    MatrixXd Mesh::* field;
+    int row_trim;   // 全局行数 = ny − row_trim
+    int col_trim;   // 全局列数 = nx − col_trim
+};
+
+const CheckpointField CHECKPOINT_FIELDS[] = {
+    { &Mesh::u,      0, 0 }, { &Mesh::v,      0, 0 }, { &Mesh::p,  0, 0 },
+    { &Mesh::u_star, 0, 0 }, { &Mesh::v_star, 0, 0 },
+    { &Mesh::u0,     0, 0 }, { &Mesh::v0,     0, 0 },
+    { &Mesh::u_face, 0, 1 }, { &Mesh::v_face, 1, 0 },
+};
+const int CHECKPOINT_NFIELDS = sizeof(CHECKPOINT_FIELDS) / sizeof(CHECKPOINT_FIELDS[0]);
+
+volatile std::sig_atomic_t checkpoint_signal = 0;
+
+void onCheckpointSignal(int sig)
+{
+    checkpoint_signal = (sig == SIGTERM) ? 2 : (checkpoint_signal == 2 ? 2 : 1);
+}
+
+} // namespace
+
+void writeCheckpoint(const std::string& path, const Mesh& mesh, int global_nx,
+                     int step, double time, MPI_Comm comm, const FlowStatistics* stats)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    const int ny = mesh.ny;
+    const int lg = (mesh.bctype(0, 0) == -3) ? 2 : 0;
+    const int rg = (mesh.bctype(0, mesh.nx - 1) == -3) ? 2 : 0;
+    const int first = mesh.col_offset + lg;          // 本进程真实列的全局起始列
+    const int width = mesh.nx - lg - rg;
+    const int nstats = (stats && stats->samples > 0) ? FlowStatistics::NACC : 0;
+
+    const std::string tmp = path + ".tmp";
+    MPI_File fh;
+    if (MPI_File_open(comm, tmp.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                      MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+        throw std::runtime_error("无法创建检查点文件: " + tmp);
+    }
+
+    // 每次写入都检查返回值与实际写出的元素数（磁盘满时可能只写出一部分）
+    int ok = (MPI_File_set_size(fh, 0) == MPI_SUCCESS);
+    auto write = [&](MPI_Offset offset, const void* buf, int count, MPI_Datatype type) {
+        MPI_Status status;
+        int written = 0;
+        if (MPI_File_write_at_all(fh, offset, buf, count, type, &status) != MPI_SUCCESS) ok = 0;
+        else if (MPI_Get_count(&status, type, &written) != MPI_SUCCESS || written != count) ok = 0;
+    };
+
+    double t0 = MPI_Wtime();
+    CheckpointHeader head{};
+    std::memcpy(head.magic, CHECKPOINT_MAGIC, sizeof(head.magic));
+    head.nx = global_nx;  head.ny = ny;  head.step = step;
+    head.nfields = CHECKPOINT_NFIELDS;   head.time = time;
+    head.nstats  = nstats;
+    head.samples = nstats ? stats->samples : 0;
+    write(0, &head, rank == 0 ? static_cast<int>(sizeof(head)) : 0, MPI_BYTE);
+
+    // 一个场：全局 (ny − row_trim) × (global_nx − col_trim)，本进程写自己的真实列
+    MPI_Offset base = sizeof(CheckpointHeader);
+    auto writeField = [&](const MatrixXd& m, int row_trim, int col_trim) {
+        const int rows  = ny - row_trim;
+        const int gcols = global_nx - col_trim;
+        // 面场 u_face 的第 j 列是单元 j 的东面：末进程的最后一个真实单元没有东面
+        const int c0 = first;
+        const int c1 = std::min(first + width, gcols);
+        const int count = std::max(0, c1 - c0) * rows;
+        const double* src = m.data() + static_cast<size_t>(c0 - mesh.col_offset) * rows;
+        write(base + static_cast<MPI_Offset>(c0) * rows * sizeof(double), src, count, MPI_DOUBLE);
+        base += static_cast<MPI_Offset>(rows) * gcols * sizeof(double);
+    };
+    for (const CheckpointField& f : CHECKPOINT_FIELDS)
+        writeField(mesh.*(f.field), f.row_trim, f.col_trim);
+    for (int k = 0; k < nstats; ++k)
+        writeField(stats->accumulator(k), 0, 0);
+
+    if (MPI_File_close(&fh) != MPI_SUCCESS) ok = 0;
+    total_comm_time += MPI_Wtime() - t0;
+
+    // 所有进程都写成功后才改名；失败时保留上一个检查点，各进程一起抛出异常
+    int all_ok = 0;
+    MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+    int renamed = 0;
+    if (rank == 0) {
+        if (all_ok) renamed = (std::rename(tmp.c_str(), path.c_str()) == 0);
+        else        std::remove(tmp.c_str());
+    }
+    MPI_Bcast(&renamed, 1, MPI_INT, 0, comm);
+    if (!all_ok) throw std::runtime_error("检查点写入失败（保留上一个检查点）: " + tmp);
+    if (!renamed) throw std::runtime_error("无法重命名检查点文件: " + tmp);
+}
+
+void readCheckpoint(const std::string& path, Mesh& mesh, int global_nx,
+                    int& step, double& time, MPI_Comm comm, FlowStatistics* stats)
+{
+    const int ny = mesh.ny;
+    MPI_File fh;
+    if (MPI_File_open(comm, path.c_str(), MPI_MODE_RDONLY,
+                      MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+        throw std::runtime_error("无法打开检查点文件: " + path);
+    }
+
+    CheckpointHeader head{};
+    MPI_File_read_at_all(fh, 0, &head, sizeof(head), MPI_BYTE, MPI_STATUS_IGNORE);
+    if (std::memcmp(head.magic, CHECKPOINT_MAGIC, sizeof(head.magic)) != 0 ||
+        head.nfields != CHECKPOINT_NFIELDS ||
+        (head.nstats != 0 && head.nstats != FlowStatistics::NACC)) {
+        MPI_File_close(&fh);
+        throw std::runtime_error("检查点文件格式错误: " + path);
+    }
+    if (head.nx != global_nx || head.ny != ny) {
+        MPI_File_close(&fh);
+        throw std::runtime_error("检查点网格尺寸 (" + std::to_string(head.nx) + "×"
+                                 + std::to_string(head.ny) + ") 与当前网格不一致");
+    }
+
+    // 读取本进程真实列（u_face 含两侧接口面）；ghost 列与连续计算时一样由交换得到
+    const int lg = (mesh.bctype(0, 0) == -3) ? 2 : 0;
+    const int rg = (mesh.bctype(0, mesh.nx - 1) == -3) ? 2 : 0;
+    MPI_Offset base = sizeof(CheckpointHeader);
+    auto readField = [&](MatrixXd& m, int row_trim, int col_trim) {
+        const int rows  = ny - row_trim;
+        const int gcols = global_nx - col_trim;
+        const int c0 = col_trim ? std::max(lg - 1, 0) : lg;
+        const int c1 = std::min<int>(mesh.nx - rg, m.cols());
+        MPI_File_read_at_all(fh, base + static_cast<MPI_Offset>(mesh.col_offset + c0) * rows * sizeof(double),
+                             m.data() + static_cast<size_t>(c0) * rows, (c1 - c0) * rows,
+                             MPI_DOUBLE, MPI_STATUS_IGNORE);
+        base += static_cast<MPI_Offset>(rows) * gcols * sizeof(double);
+    };
+    for (const CheckpointField& f : CHECKPOINT_FIELDS)
+        readField(mesh.*(f.field), f.row_trim, f.col_trim);
+    if (stats) {
+        stats->reset(mesh);
+        for (int k = 0; k < head.nstats; ++k)
+            readField(stats->accumulator(k), 0, 0);
+        stats->samples = head.nstats ? head.samples : 0;
+    }
+    MPI_File_close(&fh);
+
+    int rank, num_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
+    exchangeColumns(mesh.p, rank, num_procs, comm);
+    mesh.p_star = mesh.p;
+    if (stats && head.nstats) {
+        // p 的 ghost 列每步都经交换，由其累积的 p 均值 / pp（第 2 / 6 个累积量）的 ghost 列同样取自邻居
+        exchangeColumns(stats->accumulator(2), rank, num_procs, comm);
+        exchangeColumns(stats->accumulator(6), rank, num_procs, comm);
+    }
+    step = head.step;
+    time = head.time;
+}
+
+void installCheckpointSignals()
+{
+    std::signal(SIGUSR1, onCheckpointSignal);
+    std::signal(SIGTERM, onCheckpointSignal);
+}
+
+int pollCheckpointSignal(MPI_Comm comm)
+{
+    int local = checkpoint_signal, global = 0;
+    timedAllreduce(&local, &global, 1, MPI_INT, MPI_MAX, comm);
+    if (global == 1) checkpoint_signal = 0;   // SIGUSR1 只触发一次
+    return global;
+}
+
+// ============================================================================
+// 跨算例批量求解（AoSoA，每个 SIMD 通道一个算例）
+// ============================================================================
+
+// 一个 AoSoA 块（至多 W 个算例）的 Jacobi-PCG，nl 为有效通道数，epsilon 逐通道
+template <int W>
+static void pcgBatchBlock(Equation* const* equs, MatrixXd* const* fields, int nl,
+                          const double* epsilon, int max_iter, int rank, int num_procs, MPI_Comm comm,
+                          double* l2_out, BatchStats& stats, int verbose)
+{
+    const Mesh& mesh = equs[0]->mesh;
+    const int n = mesh.internumber;
+    const size_t nw = static_cast<size_t>(n + 1) * W;   // 第 n 个单元为恒零的哑单元
+
+    // ===== 1. 打包系数与右端项（空通道取 A = I、b = 0） =====
+    std::vector<int> ie(n), iw(n), in(n), is(n);
+    for (int k = 0; k < n; ++k) {
+        ie[k] = (mesh.nb_e[k] >= 0) ? mesh.nb_e[k] : n;
+        iw[k] = (mesh.nb_w[k] >= 0) ? mesh.nb_w[k] : n;
+        in[k] = (mesh.nb_n[k] >= 0) ? mesh.nb_n[k] : n;
+        is[k] = (mesh.nb_s[k] >= 0) ? mesh.nb_s[k] : n;
+    }
+
+    std::vector<double> ap(nw, 1.0), ae(nw, 0.0), aw(nw, 0.0), an(nw, 0.0), as(nw, 0.0);
+    std::vector<double> inv(nw, 1.0), b(nw, 0.0);
+    for (int k = 0; k < n; ++k) {
+        const int c = mesh.cell(mesh.interi[k], mesh.interj[k]);
+        for (int w = 0; w < nl; ++w) {
+            const Equation& e = *equs[w];
+            const size_t q = static_cast<size_t>(k) * W + w;
+            ap[q] = e.A_p(c);
+            ae[q] = (ie[k] < n) ? e.A_e(c) : 0.0;
+            aw[q] = (iw[k] < n) ? e.A_w(c) : 0.0;
+            an[q] = (in[k] < n) ? e.A_n(c) : 0.0;
+            as[q] = (is[k] < n) ? e.A_s(c) : 0.0;
+            inv[q] = (std::abs(ap[q]) > 1e-14) ? 1.0 / ap[q] : 1.0;
+            b[q]   = e.source[k];
+        }
+    }
+
+    // 接口修正：拓扑取自 HaloPlan，耦合系数逐通道
+    HaloPlan halo;
+    halo.build(mesh, *equs[0]);
+    const int ny = halo.ny;
+    std::vector<double> west_coef(halo.west_idx.size() * W, 0.0);
+    std::vector<double> east_coef(halo.east_idx.size() * W, 0.0);
+    for (size_t m = 0; m < halo.west_idx.size(); ++m) {
+        const int k = halo.west_idx[m];
+        for (int w = 0; w < nl; ++w)
+            west_coef[m * W + w] = equs[w]->A_w(mesh.cell(mesh.interi[k], mesh.interj[k]));
+    }
+    for (size_t m = 0; m < halo.east_idx.size(); ++m) {
+        const int k = halo.east_idx[m];
+        for (int w = 0; w < nl; ++w)
+            east_coef[m * W + w] = equs[w]->A_e(mesh.cell(mesh.interi[k], mesh.interj[k]));
+    }
+    const int left_rank  = (rank == 0) ? MPI_PROC_NULL : rank - 1;
+    const int right_rank = (rank == num_procs - 1) ? MPI_PROC_NULL : rank + 1;
+    std::vector<double> sl(ny * W), sr(ny * W), rl(ny * W), rr(ny * W);
+
+    // q = A·v（五点格式 + 接口耦合），最内层沿算例方向
+    auto spmv = [&](const std::vector<double>& v, std::vector<double>& y) {
+        for (int k = 0; k < n; ++k) {
+            const double* vc = &v[static_cast<size_t>(k) * W];
+            const double* ve = &v[static_cast<size_t>(ie[k]) * W];
+            const double* vw = &v[static_cast<size_t>(iw[k]) * W];
+            const double* vn = &v[static_cast<size_t>(in[k]) * W];
+            const double* vs = &v[static_cast<size_t>(is[k]) * W];
+            const size_t q = static_cast<size_t>(k) * W;
+            for (int w = 0; w < W; ++w)
+                y[q + w] = ap[q + w] * vc[w] - ae[q + w] * ve[w] - aw[q + w] * vw[w]
+                         - an[q + w] * vn[w] - as[q + w] * vs[w];
+        }
+        if (left_rank == MPI_PROC_NULL && right_rank == MPI_PROC_NULL) return;
+
+        for (int i = 0; i < ny; ++i) {
+            for (int w = 0; w < W; ++w) {
+                sl[i * W + w] = (halo.send_left[i]  >= 0) ? v[static_cast<size_t>(halo.send_left[i])  * W + w] : 0.0;
+                sr[i * W + w] = (halo.send_right[i] >= 0) ? v[static_cast<size_t>(halo.send_right[i]) * W + w] : 0.0;
+            }
+        }
+        std::fill(rl.begin(), rl.end(), 0.0);
+        std::fill(rr.begin(), rr.end(), 0.0);
+        double t0 = MPI_Wtime();
+        MPI_Sendrecv(sl.data(), ny * W, MPI_DOUBLE, left_rank,  0,
+                     rl.data(), ny * W, MPI_DOUBLE, left_rank,  1, comm, MPI_STATUS_IGNORE);
+        MPI_Sendrecv(sr.data(), ny * W, MPI_DOUBLE, right_rank, 1,
+                     rr.data(), ny * W, MPI_DOUBLE, right_rank, 0, comm, MPI_STATUS_IGNORE);
+        total_comm_time += MPI_Wtime() - t0;
+        total_comm_count++;
+
+        for (size_t m = 0; m < halo.west_idx.size(); ++m) {
+            const size_t q = static_cast<size_t>(halo.west_idx[m]) * W;
+            for (int w = 0; w < W; ++w)
+                y[q + w] -= west_coef[m * W + w] * rl[halo.west_row[m] * W + w];
+        }
+        for (size_t m = 0; m < halo.east_idx.size(); ++m) {
+            const size_t q = static_cast<size_t>(halo.east_idx[m]) * W;
+            for (int w = 0; w < W; ++w)
+                y[q + w] -= east_coef[m * W + w] * rr[halo.east_row[m] * W + w];
+        }
+    };
+
+    // 各通道的内积 a·b，按块累加（一次归约携带全部通道）
+    auto dots = [&](const std::vector<double>& u, const std::vector<double>& v, double* out) {
+        double acc[W] = {};
+        for (int k = 0; k < n; ++k) {
+            const size_t q = static_cast<size_t>(k) * W;
+            for (int w = 0; w < W; ++w) acc[w] += u[q + w] * v[q + w];
+        }
+        for (int w = 0; w < W; ++w) out[w] = acc[w];
+    };
+
+    // ===== 2. 初始化（零初值：r = b） =====
+    std::vector<double> x(nw, 0.0), r = b, z(nw, 0.0), p(nw, 0.0), Ap(nw, 0.0);
+    for (size_t q = 0; q < static_cast<size_t>(n) * W; ++q) z[q] = inv[q] * r[q];
+    p = z;
+
+    double local_buf[3 * W], global_buf[3 * W];
+    dots(r, z, local_buf);
+    dots(r, r, local_buf + W);
+    dots(b, b, local_buf + 2 * W);
+    timedAllreduce(local_buf, global_buf, 3 * W, MPI_DOUBLE, MPI_SUM, comm);
+
+    const int    max_stagnation   = 3;
+    const double stagnation_tol   = 1e-6;
+    const int    min_iter_protect = 5;
+
+    double rz[W], r_init[W], r_norm[W], r_prev[W], alpha[W], cz[W], cp[W];
+    int    status[W], iters[W], stag[W];
+    bool   active[W];
+    int    n_active = 0;
+    for (int w = 0; w < W; ++w) {
+        rz[w]     = global_buf[w];
+        r_init[w] = std::sqrt(global_buf[W + w]);
+        r_norm[w] = r_prev[w] = r_init[w];
+        const double b_norm = std::sqrt(global_buf[2 * W + w]);
+        iters[w] = stag[w] = 0;
+        status[w] = 1;
+        active[w] = (w < nl) && !(r_init[w] < 1e-15 || r_init[w] / (b_norm + 1e-16) < epsilon[w]);
+        if (active[w]) { status[w] = 0; n_active++; }
+    }
+
+    // ===== 3. 迭代：已退出通道 α = 0、p 保持不变 =====
+    int iter = 0;
+    while (n_active > 0 && iter < max_iter) {
+        spmv(p, Ap);
+        double local_pAp[W], global_pAp[W];
+        dots(p, Ap, local_pAp);
+        timedAllreduce(local_pAp, global_pAp, W, MPI_DOUBLE, MPI_SUM, comm);
+
+        for (int w = 0; w < W; ++w) {
+            if (active[w] && std::abs(global_pAp[w]) < 1e-35) {
+                active[w] = false;
+                status[w] = 3;
+                n_active--;
+            }
+            alpha[w] = active[w] ? rz[w] / global_pAp[w] : 0.0;
+        }
+        if (n_active == 0) break;
+
+        for (int k = 0; k < n; ++k) {
+            const size_t q = static_cast<size_t>(k) * W;
+            for (int w = 0; w < W; ++w) {
+                x[q + w] += alpha[w] * p[q + w];
+                r[q + w] -= alpha[w] * Ap[q + w];
+                z[q + w]  = inv[q + w] * r[q + w];
+            }
+        }
+
+        dots(r, z, local_buf);
+        dots(r, r, local_buf + W);
+        timedAllreduce(local_buf, global_buf, 2 * W, MPI_DOUBLE, MPI_SUM, comm);
+
+        for (int w = 0; w < W; ++w) {
+            cz[w] = active[w] ? 1.0 : 0.0;
+            cp[w] = active[w] ? global_buf[w] / rz[w] : 1.0;
+            if (!active[w]) continue;
+            rz[w]     = global_buf[w];
+            r_norm[w] = std::sqrt(global_buf[W + w]);
+            iters[w]++;
+        }
+        for (int k = 0; k < n; ++k) {
+            const size_t q = static_cast<size_t>(k) * W;
+            for (int w = 0; w < W; ++w)
+                p[q + w] = cz[w] * z[q + w] + cp[w] * p[q + w];
+        }
+        iter++;
+
+        // 收敛 / 停滞判据逐通道独立（所有进程持有相同的归约结果，无需广播）
+        for (int w = 0; w < W; ++w) {
+            if (!active[w]) continue;
+            if (r_norm[w] / r_init[w] < epsilon[w]) {
+                status[w] = 1;
+            } else if (iters[w] > min_iter_protect) {
+                const double drop_rate = (r_prev[w] - r_norm[w]) / r_prev[w];
+                stag[w] = (drop_rate < stagnation_tol) ? stag[w] + 1 : 0;
+                if (stag[w] >= max_stagnation) status[w] = 2;
+            }
+            r_prev[w] = r_norm[w];
+            if (status[w] != 0) { active[w] = false; n_active--; }
+        }
+    }
+
+    // ===== 4. 写回各算例的场变量 =====
+    for (int w = 0; w < nl; ++w) {
+        MatrixXd& field = *fields[w];
+        for (int k = 0; k < n; ++k)
+            field(mesh.cell(mesh.interi[k], mesh.interj[k])) = x[static_cast<size_t>(k) * W + w];
+        exchangeColumns(field, mesh, rank, num_procs, comm);
+        l2_out[w] = r_norm[w];
+        recordSolve(iters[w], status[w], r_init[w], r_norm[w]);
+        stats.lane_iterations += iters[w];
+    }
+    stats.block_iterations += iter;
+    stats.solves++;
+
+    if (rank == 0 && verbose == 1) {
+        int converged = 0, max_it = 0;
+        for (int w = 0; w < nl; ++w) {
+            converged += (status[w] == 1);
+            max_it = std::max(max_it, iters[w]);
+        }
+        std::cout << "  [BatchPCG] " << nl << " 个算例: 收敛 " << converged
+                  << ", 块迭代 " << iter << ", 最慢算例 " << max_it << " 次" << std::endl;
+    }
+}
+
+void solveFieldPCGBatched(const std::vector<Equation*>& equs,
+                          const std::vector<MatrixXd*>& fields,
+                          double tol, int max_iter,
+                          int rank, int num_procs, MPI_Comm comm,
+                          std::vector<double>& l2_norm,
+                          BatchStats& stats, int verbose)
+{
+    const int n_cases = static_cast<int>(equs.size());
+    l2_norm.assign(n_cases, 0.0);
+    double eps[BATCH_W];
+    std::fill(eps, eps + BATCH_W, tol);
+    for (int c0 = 0; c0 < n_cases; c0 += BATCH_W) {
+        const int nl = std::min(BATCH_W, n_cases - c0);
+        pcgBatchBlock<BATCH_W>(equs.data() + c0, fields.data() + c0, nl,
+                               eps, max_iter, rank, num_procs, comm,
+                               l2_norm.data() + c0, stats, verbose);
+    }
+}
+
+void solveFieldPCGPair(Equation& equ_u, Equation& equ_v, MatrixXd& u, MatrixXd& v,
+                       double tol_u, double tol_v, int max_iter,
+                       int rank, int num_procs, MPI_Comm comm,
+                       double& l2_u, double& l2_v, int verbose)
+{
+    Equation* equs[2]   = {&equ_u, &equ_v};
+    MatrixXd* fields[2] = {&u, &v};
+    const double eps[2] = {tol_u, tol_v};
+    double l2[2];
+    BatchStats stats;
+    pcgBatchBlock<2>(equs, fields, 2, eps, max_iter, rank, num_procs, comm, l2, stats, verbose);
+    solver_stats.iterations = static_cast<int>(stats.block_iterations);   // 同步迭代步数
+    l2_u = l2[0];
+    l2_v = l2[1];
+}
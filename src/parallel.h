@@ -16,12 +16,20 @@
  * 3. **并行线性求解器层**
  *    - CG_parallel  ：无预条件共轭梯度法（MPI 并行）
  *    - PCG_parallel ：Jacobi 预条件共轭梯度法（MPI 并行，推荐使用）
- *    - solveFieldCG / solveFieldPCG：场变量级封装，直接输出到 MatrixXd
+ *    - PCG_parallel_mixed：float 内层 PCG + double 外层残差修正（混合精度迭代精化）
+ *    - PCG_parallel_deflated：跨求解回收 Ritz 向量的 deflated PCG（压力修正方程）
+ *    - PCG_parallel_cheb：Chebyshev 多项式预条件 PCG（预条件本身无内积）
+ *    - PCG_parallel_sstep：s-step PCG，每 s 步一次 Gram Allreduce
+ *    - solveFieldPCGBatched：多算例 AoSoA 批量 PCG（每个 SIMD 通道一个算例）
+ *    - solveFieldPCGPair：u、v 动量方程共享通信的同步求解（两通道批量 PCG）
+ *    - solveFieldCG / solveFieldPCG / solveFieldPCGMixed：场变量级封装，直接输出到 MatrixXd
  *
  * 并行通信约定：
  * - 每个子网格左右两侧各有 2 列 ghost 层（bctype = -3）
  * - ghost 列 [0,1] 存储来自左邻进程的数据，[nx-2,nx-1] 存储来自右邻进程的数据
  * - 真实计算列范围为 [2, nx-3]（中间子网格）
+ * - 通信函数显式接收通信域 comm，ghost 列交换、接口修正与 Allreduce/Bcast 均在其中进行，
+ *   参数 rank / num_procs 为该通信域内的编号与大小（集合模式下为 MPI_Comm_split 得到的组通信域）
  *
  * 停滞检测约定：
  * - 连续 3 步相对残差下降率 < 1e-6 时判定为停滞，提前退出
@@ -40,8 +48,197 @@
 #include "fluid.h"
 #include <mpi.h>
 #include <omp.h>
+#include <cstdint>
 
 
+// ============================================================================
+// 求解统计
+// ============================================================================
+
+/**
+ * @brief 线性求解器统计信息（由 CG_parallel / PCG_parallel 在返回前更新）
+ *
+ * @details
+ * 所有进程持有相同的值（残差均来自 MPI_Allreduce 的全局结果），
+ * 供基准测试、日志与外层控制逻辑读取，无需修改求解器函数签名。
+ */
+struct SolverStats {
+    int    iterations       = 0;    ///< 最近一次求解的迭代次数
+    int    exit_status      = 0;    ///< 0=达到最大迭代 1=收敛 2=停滞 3=数学失效
+    double r_initial        = 0.0;  ///< 最近一次求解的初始残差范数
+    double r_final          = 0.0;  ///< 最近一次求解的最终残差范数
+    long   total_iterations = 0;    ///< 累计迭代次数
+    long   total_solves     = 0;    ///< 累计求解次数
+};
+
+/// 全局求解统计（定义于 parallel.cpp）
+extern SolverStats solver_stats;
+
+/**
+ * @struct ReductionOverlap
+ * @brief PCG_parallel 非阻塞归约的重叠统计
+ *
+ * @details
+ * 每次归约记录从发起到等待之间的本地计算时间（重叠窗口）与 MPI_Wait 的阻塞时间，
+ * 进入等待前用 MPI_Test 检查是否已完成（已完成者延迟被完全隐藏）。
+ * 真实延迟不可直接测得：未提前完成的归约被隐藏的部分恰为窗口，提前完成的不超过窗口，
+ * 故 hiddenFraction() = 窗口 / (窗口 + 等待) 为被隐藏延迟比例的上界估计。
+ * 等待时间计入 total_comm_time，窗口时间不计入。
+ */
+struct ReductionOverlap {
+    long   reductions = 0;     ///< 非阻塞归约次数
+    long   completed  = 0;     ///< 进入等待前已完成的次数
+    double window     = 0.0;   ///< 发起到等待之间的本地计算时间（秒）
+    double wait       = 0.0;   ///< 等待阻塞时间（秒）
+
+    double hiddenFraction() const {
+        return (window + wait > 0.0) ? window / (window + wait) : 0.0;
+    }
+};
+
+/// 全局非阻塞归约统计（定义于 parallel.cpp，各进程各自累计）
+extern ReductionOverlap reduction_overlap;
+
+/// 累计通信耗时（秒）：exchangeColumns 与求解器内的 Allreduce/Bcast
+extern double total_comm_time;
+
+/// 累计通信次数
+extern int total_comm_count;
+
+/**
+ * @brief 汇总各进程计时并由 rank 0 输出一行机器可读的性能记录
+ *
+ * @details
+ * 输出格式（CSV，以 "PERF," 开头，便于脚本 grep）：
+ * @code
+ *   PERF,<tag>,<ranks>,<cells>,<iters>,<time_per_iter>,<comm_fraction>,<krylov_iters>,
+ *        <krylov_solves>,<res_u>,<res_v>,<res_p>
+ * @endcode
+ * - time_per_iter ：各进程墙钟时间的最大值 / SIMPLE 迭代次数
+ * - comm_fraction ：各进程 total_comm_time / 墙钟时间 的平均值
+ * - krylov_iters  ：各进程 solver_stats.total_iterations（所有进程相同）
+ * - krylov_solves ：solver_stats.total_solves，krylov_iters / krylov_solves 即每次求解的平均迭代数
+ * - res_u/v/p     ：最后一次 SIMPLE 迭代的全局残差（由调用方传入）
+ *
+ * @param tag        求解器标识（如 "steady" / "unsteady"）
+ * @param elapsed    本进程计时区间的墙钟时间（秒）
+ * @param iters      计时区间内的 SIMPLE 迭代总次数
+ * @param cells      全局网格单元数（nx×ny）
+ * @param rank       当前进程编号
+ * @param num_procs  总进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
+ * @param res_u, res_v, res_p  最终残差（可省略，输出 0）
+ */
+void reportPerfSummary(const std::string& tag, double elapsed, int iters,
+                       long cells, int rank, int num_procs, MPI_Comm comm,
+                       double res_u = 0.0, double res_v = 0.0, double res_p = 0.0);
+
+
+// ============================================================================
+// 内核硬件计数器（--counters）
+// ============================================================================
+
+// ==================== 每单元数据量 / 浮点运算量估算 ====================
+// 计数规则：每个被读或写的 ny×nx 数组计一次（double 8B，int 4B），
+// 邻居访问视为缓存命中；稀疏矩阵按 CSR 每非零元 12B（值 + 列号）计。
+// 按一般几何路径估算，均匀网格快速路径实际读取的数据量更少。
+// 浮点运算量为一般几何路径的粗略估计（加、乘、除、比较各计 1），仅用于 roofline 定位。
+const double bytes_csr_row      = 5 * 12.0;                 // 五点格式 CSR 输出
+const double bytes_build_matrix = 2 * 4 + 5 * 8 + bytes_csr_row;
+const double bytes_momentum     = 2 * 4 + 12 * 8            // bctype/zoneid + 12 个几何/场数组
+                                + 14 * 8                    // u/v 清零 + 两组系数 + 两个源项
+                                + 2 * bytes_csr_row;        // equ_u / equ_v 组装
+const double bytes_face_vel     = 1 * 4 + 7 * 8 + 2 * 8;
+const double bytes_pressure     = 2 * 4 + 10 * 8 + 7 * 8 + bytes_csr_row;
+const double bytes_correct_vel  = 1 * 4 + 10 * 8 + 4 * 8;
+const double bytes_spmv_row     = bytes_csr_row + 2 * 8;    // A 一行 + x / y
+const double bytes_pcg_iter     = bytes_spmv_row + 16 * 8;  // SpMV + 2 次内积 + 3 次 axpy + Jacobi
+
+const double flops_momentum     = 4 * 12 + 2 * 6;           // 4 个面的扩散 + 对流 + 源项，u / v 共用
+const double flops_face_vel     = 2 * 15;                   // 东、北两个面的 Rhie-Chow 插值
+const double flops_pressure     = 4 * 4 + 8;                // 4 个面系数 + 质量不平衡
+const double flops_correct      = 2 * 4 + 2 * 4;            // 单元速度 + 面速度修正
+const double flops_spmv_row     = 9;                        // 5 乘 4 加
+const double flops_pcg_iter     = flops_spmv_row + 11;      // + 内积 4、axpy 6、Jacobi 1
+
+/// 被计数的求解阶段（SPMV 嵌套在 PCG_parallel 内部，其余为主循环中的顺序阶段）
+enum KernelId {
+    KERNEL_MOMENTUM,       ///< momentum_function(_unsteady)
+    KERNEL_SOLVE_U,        ///< u 方程线性求解
+    KERNEL_SOLVE_V,        ///< v 方程线性求解
+    KERNEL_FACE_VELOCITY,  ///< face_velocity
+    KERNEL_PRESSURE,       ///< pressure_function
+    KERNEL_SOLVE_P,        ///< 压力修正方程线性求解
+    KERNEL_CORRECT,        ///< correct_pressure + correct_velocity
+    KERNEL_SPMV,           ///< PCG_parallel 中的 A·p（含 ghost 交换与接口修正）
+    KERNEL_COUNT
+};
+
+/**
+ * @brief 按内核累积的墙钟时间、工作量与硬件计数
+ *
+ * @details
+ * 工作量以"单元"计：离散内核为本进程单元数，线性求解为 内部点数 × Krylov 迭代次数，
+ * SpMV 为内部点数。乘以上面的每单元估算即得模型数据量与浮点运算量。
+ */
+struct KernelCounters {
+    long     calls        = 0;
+    double   seconds      = 0.0;
+    double   units        = 0.0;  ///< 累计工作量（单元）
+    uint64_t cycles       = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses   = 0;
+};
+
+/**
+ * @class KernelProfiler
+ * @brief 以 Linux perf_event_open 计数 cycles / instructions / LLC misses 的阶段计数器
+ *
+ * @details
+ * init() 打开一个计数组（仅用户态，随进程持续计数），start() / stop() 各读取一次计数组，
+ * 差值累加到对应内核；计数器被复用（multiplexing）时按 time_enabled / time_running 缩放。
+ * 同一内核的 start / stop 必须成对，不同内核可以嵌套（SPMV 位于 SOLVE_* 之内）。
+ *
+ * 不可用时（非 Linux、perf_event_paranoid 限制、虚拟机无 PMU）自动退化为
+ * 仅记录墙钟时间与模型数据量，report() 中硬件计数列显示 "-"。
+ *
+ * report() 汇总所有进程（计数与工作量求和，时间取最大值）并由 rank 0 输出：
+ * - IPC      = instructions / cycles
+ * - LLC GB/s = LLC misses × 64 B / 时间（实测 DRAM 流量估计）
+ * - 模型 GB/s = 工作量 × 每单元字节 / 时间
+ * - GFLOP/s  = 工作量 × 每单元浮点运算 / 时间
+ * - AI       = 浮点运算 / 字节（有 LLC 计数时用实测字节，否则用模型字节），用于 roofline 定位
+ */
+class KernelProfiler {
+public:
+    bool enabled = false;  ///< 由 init(true) 开启；关闭时 start / stop 为空操作
+    bool hardware = false; ///< 硬件计数组是否成功打开
+
+    /** @brief 开启计数；rank 0 在硬件计数不可用时打印原因 */
+    void init(bool enable, int rank);
+
+    void start(KernelId k) { if (enabled) begin(k); }
+    void stop(KernelId k, double units) { if (enabled) end(k, units); }
+
+    /** @brief 汇总所有进程并输出每个内核的一行统计（集体调用） */
+    void report(int rank, int num_procs, MPI_Comm comm) const;
+
+    ~KernelProfiler();
+
+private:
+    void begin(KernelId k);
+    void end(KernelId k, double units);
+    void sample(uint64_t out[5]) const;
+
+    int fds[3] = {-1, -1, -1};  ///< cycles（组长）/ instructions / LLC misses
+    KernelCounters counters[KERNEL_COUNT];
+    uint64_t snap[KERNEL_COUNT][5] = {};   ///< start() 时的 enabled / running / 3 个计数
+    double   t_start[KERNEL_COUNT] = {};
+};
+
+/// 全局内核计数器（定义于 parallel.cpp）
+extern KernelProfiler kernel_profiler;
+
 
 // ============================================================================
 // 数据通信函数
@@ -60,11 +257,40 @@
  * @param matrix     待交换的场变量矩阵（行优先，ny×nx），原地更新 ghost 列
  * @param rank       当前进程编号
  * @param num_procs  总进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
  *
  * @note 矩阵须为 Eigen ColMajor 格式（默认），列内数据连续，可直接映射为发送缓冲区
  * @note 使用固定 tag（0 和 1），多字段并发通信时需注意 tag 冲突
  */
-void exchangeColumns(MatrixXd& matrix, int rank, int num_procs);
+void exchangeColumns(MatrixXd& matrix, int rank, int num_procs, MPI_Comm comm);
+
+/**
+ * @brief 按网格的场布局交换 ghost 列
+ *
+ * 矩形布局下等同于 exchangeColumns(matrix, rank, num_procs, comm)。紧凑布局
+ * （Mesh::useCompactLayout）下按 cellid 逐单元打包第 [2,3] / [nx-4,nx-3] 列，
+ * 未存储的单元发送 0，接收值只写入已存储的 ghost 单元；报文内容与矩形布局相同。
+ * 求解器内部统一使用此重载。
+ *
+ * @param field      单元场（矩形 ny×nx 或紧凑 nstored×1）
+ * @param mesh       提供布局与 cellid
+ */
+void exchangeColumns(MatrixXd& field, const Mesh& mesh, int rank, int num_procs, MPI_Comm comm);
+
+/**
+ * @brief 将 root 进程上加载的完整网格广播到通信域内所有进程
+ *
+ * @details
+ * 仅广播网格的原始输入（nx/ny、节点坐标 x/y、bctype、zoneid、zoneu/zonev），
+ * 非 root 进程收到后重新执行 createInterId / initializeBoundaryConditions / initGeometry，
+ * 结果与各自调用 loadMesh 等价，但只读取一次网格文件。
+ * 编号策略（ordering）等运行选项不随网格广播，由调用方在广播后设置。
+ *
+ * @param mesh  root 上为已加载的网格；其他进程上为输出
+ * @param root  持有网格的进程编号（comm 内）
+ * @param comm  广播所用通信域
+ */
+void broadcastMesh(Mesh& mesh, int root, MPI_Comm comm);
 
 /**
  * @brief 将线性方程组解向量写回场变量矩阵（仅更新内部点）
@@ -74,7 +300,7 @@ void exchangeColumns(MatrixXd& matrix, int rank, int num_procs);
  * 边界点和 ghost 列保持原值不变。
  *
  * @param x    输入：长度为 internumber 的解向量
- * @param phi  输出：ny×nx 场变量矩阵（仅内部点被修改）
+ * @param phi  输出：场变量矩阵（仅内部点被修改；紧凑布局下即前 internumber 个分量）
  * @param mesh 网格对象（提供 bctype 和 interid）
  */
 void vectorToMatrix(const VectorXd& x, MatrixXd& phi, const Mesh& mesh);
@@ -163,13 +389,14 @@ void Parallel_correction2(Mesh& mesh, Equation& equ, MatrixXd& phi1, MatrixXd& p
  * @param max_iter   最大迭代次数
  * @param rank       当前 MPI 进程编号
  * @param num_procs  总 MPI 进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
  * @param r0         输出：最终残差范数（所有进程返回相同值）
  * @param verbose    日志级别（0=静默，1=打印收敛信息），默认为 0
  */
 void CG_parallel(Equation& equ, Mesh mesh,
                  VectorXd& b, VectorXd& x,
                  double epsilon, int max_iter,
-                 int rank, int num_procs,
+                 int rank, int num_procs, MPI_Comm comm,
                  double& r0, int verbose = 0);
 
 /**
@@ -187,6 +414,9 @@ void CG_parallel(Equation& equ, Mesh mesh,
  * - 对于对流主导问题效果有限，可考虑换用 ILU 预条件
  *
  * 每次迭代的 MPI 通信量与 CG_parallel 相同（预条件操作为纯本地运算）。
+ * (r,z) 与 ‖r‖² 的合并归约为非阻塞（MPI-4 起为持久化集合通信），
+ * 等待期间完成 z = M⁻¹r 与 x += α·p；重叠效果累计于 reduction_overlap。
+ * 收敛 / 停滞判断只依赖归约结果，各进程本地得出相同结论，不再广播退出状态。
  *
  * @param equ        方程对象（提供稀疏矩阵 A 和 A_p 对角系数）
  * @param mesh       网格对象（值传递）
@@ -196,13 +426,14 @@ void CG_parallel(Equation& equ, Mesh mesh,
  * @param max_iter   最大迭代次数
  * @param rank       当前 MPI 进程编号
  * @param num_procs  总 MPI 进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
  * @param r0         输出：最终残差范数
  * @param verbose    日志级别（0=静默，1=打印收敛信息），默认为 0
  */
 void PCG_parallel(Equation& equ, Mesh mesh,
                   VectorXd& b, VectorXd& x,
                   double epsilon, int max_iter,
-                  int rank, int num_procs,
+                  int rank, int num_procs, MPI_Comm comm,
                   double& r0, int verbose = 0);
 
 
@@ -227,12 +458,13 @@ void PCG_parallel(Equation& equ, Mesh mesh,
  * @param max_iter   最大迭代次数
  * @param rank       当前 MPI 进程编号
  * @param num_procs  总 MPI 进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
  * @param l2_norm    输出：求解完成后的残差范数
  * @param verbose    日志级别（0=静默，1=打印收敛信息）
  */
 void solveFieldCG(Equation& equ, Mesh& mesh, MatrixXd& field,
                   double tol, int max_iter,
-                  int rank, int num_procs,
+                  int rank, int num_procs, MPI_Comm comm,
                   double& l2_norm, int verbose);
 
 /**
@@ -249,13 +481,605 @@ void solveFieldCG(Equation& equ, Mesh& mesh, MatrixXd& field,
  * @param max_iter   最大迭代次数
  * @param rank       当前 MPI 进程编号
  * @param num_procs  总 MPI 进程数
+ * @param comm       通信域（rank / num_procs 为其中的编号与大小）
  * @param l2_norm    输出：求解完成后的残差范数
  * @param verbose    日志级别（0=静默，1=打印收敛信息）
  */
 void solveFieldPCG(Equation& equ, Mesh& mesh, MatrixXd& field,
                    double tol, int max_iter,
-                   int rank, int num_procs,
+                   int rank, int num_procs, MPI_Comm comm,
                    double& l2_norm, int verbose);
 
 
+// ============================================================================
+// 混合精度求解器
+// ============================================================================
+
+/**
+ * @struct HaloPlan
+ * @brief 向量级的并行接口修正计划（替代 vectorToMatrix + exchangeColumns + Parallel_correction）
+ *
+ * @details
+ * 矩阵-向量乘法 Ap 只依赖与 ghost 列（bctype=-3）直接相邻的一列内部点，
+ * 因此只需交换每侧 1 列（而非 2 列整场），且可直接在解向量上打包/解包：
+ * - send_left[i] / send_right[i]：第 2 列 / 第 nx-3 列第 i 行对应的向量下标（-1 表示非内部点，发送 0）
+ * - west_* / east_*：与 ghost 列相邻的内部点（向量下标、ghost 行号、耦合系数 A_w / A_e）
+ *
+ * apply() 的结果与 Parallel_correction 完全一致：Ap(k) -= coef · ghost(row)。
+ * 模板参数 T 决定通信与计算精度（float 时消息体积减半）。
+ */
+struct HaloPlan {
+    int ny = 0;
+    std::vector<int>    send_left, send_right;
+    std::vector<int>    west_idx, west_row;
+    std::vector<double> west_coef;
+    std::vector<int>    east_idx, east_row;
+    std::vector<double> east_coef;
+
+    /** @brief 由网格与方程系数（A_e / A_w）构建修正计划 */
+    void build(const Mesh& mesh, const Equation& equ);
+
+    /**
+     * @brief 交换接口列并修正 Ap（Ap -= A_nb · p_ghost）
+     * @param p    当前进程的向量（长度 internumber）
+     * @param Ap   输入/输出：本地 SpMV 结果，原地加入跨进程耦合项
+     */
+    template <class T>
+    void apply(const Matrix<T, Dynamic, 1>& p, Matrix<T, Dynamic, 1>& Ap,
+               int rank, int num_procs, MPI_Comm comm) const;
+};
+
+/**
+ * @brief 混合精度迭代精化 PCG（float 内层求解 + double 外层残差修正）
+ *
+ * @details
+ * 外层（double）：
+ * 1. r = b - Ax（double SpMV + HaloPlan 修正），检查 ‖r‖/‖r₀‖ < epsilon
+ * 2. 将 A、r、Jacobi 对角转为 float，内层 Jacobi-PCG 求解 A·d = r
+ * 3. x += d（double 累加）
+ *
+ * 内层（float）：系数矩阵、Krylov 向量与 ghost 列通信均为单精度，
+ * 内积结果以 double 做 MPI_Allreduce。内层容差取
+ * max(epsilon·‖r₀‖/‖r‖, 1e-4)（不超过 0.1），避免 float 舍入导致停滞。
+ *
+ * 与 PCG_parallel 相比：SpMV 每非零元 8B（原 12B），向量运算与接口消息体积减半，
+ * 最终精度由 double 外层残差保证。max_iter 计为内层迭代总数。
+ *
+ * 参数含义与 PCG_parallel 相同；solver_stats.iterations 为内层迭代总数。
+ */
+void PCG_parallel_mixed(Equation& equ, const Mesh& mesh,
+                        VectorXd& b, VectorXd& x,
+                        double epsilon, int max_iter,
+                        int rank, int num_procs, MPI_Comm comm,
+                        double& r0, int verbose = 0);
+
+/**
+ * @brief 用 PCG_parallel_mixed 求解线性方程组，结果直接写回场变量矩阵
+ *
+ * @details 封装流程与 solveFieldPCG 相同，参数含义一致，可直接互换。
+ */
+void solveFieldPCGMixed(Equation& equ, Mesh& mesh, MatrixXd& field,
+                        double tol, int max_iter,
+                        int rank, int num_procs, MPI_Comm comm,
+                        double& l2_norm, int verbose);
+
+
+// ============================================================================
+// Krylov 子空间回收（压力修正方程的 deflated PCG）
+// ============================================================================
+
+/**
+ * @struct DeflationSpace
+ * @brief 跨求解保留的近似低特征值向量（回收空间）
+ *
+ * @details
+ * W 为 n×k 的本地行块（n = internumber，各进程持有自己的行），
+ * 由上一次求解的 Ritz 向量更新。压力修正矩阵每次 SIMPLE 迭代只缓慢变化，
+ * 其低端特征向量（光滑模态）基本不变，因此可以跨求解重复使用。
+ */
+struct DeflationSpace {
+    int      k = 8;         ///< 保留的 Ritz 向量数（0 表示关闭回收）
+    int      m = 16;        ///< 每次求解记录的搜索方向数（用于 Ritz 提取）
+    MatrixXd W;             ///< 回收空间（列向量全局正交归一），空表示尚未建立
+
+    long solves       = 0;  ///< 累计求解次数
+    long iterations   = 0;  ///< 累计 Krylov 迭代次数
+    long extra_spmv   = 0;  ///< 计算 S·W 额外付出的 SpMV 次数
+
+    /** @brief 网格或编号改变后清空回收空间 */
+    void reset() { W.resize(0, 0); }
+};
+
+/**
+ * @brief 带子空间回收的 Jacobi-PCG（Deflated PCG，Saad 等 2000）
+ *
+ * @details
+ * 压力修正方程第 (i,j) 行乘了单元体积，A = diag(vol)·S，其中 S 对称
+ * （非均匀网格上 A 本身不对称）。整个迭代在 S = diag(vol)⁻¹A、右端项 b/vol 上进行，
+ * Jacobi 预条件取 S 的对角线。设回收空间 W，E = Wᵀ S W：
+ * 1. 初值修正：x ← x + W E⁻¹ Wᵀ r₀，使残差与 W 正交
+ * 2. 搜索方向：p ← z + β p − W E⁻¹ (SW)ᵀ z，使 p 与 W 保持 S-正交
+ * 3. 求解结束后对 [W, P] 做 Rayleigh–Ritz，取最小的 k 个 Ritz 向量作为新的 W
+ *    （P 为本次求解的前 m 个搜索方向，SP 已在迭代中得到，无需额外 SpMV）
+ *
+ * 每次迭代额外代价：k 个长度 n 的内积（与 r·z、‖r‖² 合并为一次 Allreduce）
+ * 以及一次 n×k 的向量更新；每次求解额外 k 次 SpMV（S·W）。
+ * 全封闭区域中 S 以常向量为零空间：去掉 b/vol 的均值使系统相容，Ritz 提取前
+ * 去掉候选方向的均值，避免近零 Ritz 值的方向进入 W。
+ *
+ * 收敛判据取缩放系统的相对残差，返回值与统计仍为原系统残差 ‖b − A x‖。
+ * 不做停滞退出（CG 残差不单调），求解以 epsilon 或 max_iter 结束。
+ * 接口耦合由 HaloPlan 完成。E 不正定或残差未下降时清空回收空间。
+ *
+ * @param defl  回收空间（输入 / 输出），defl.k == 0 时退化为普通 PCG
+ * 其余参数含义与 PCG_parallel 相同。
+ */
+void PCG_parallel_deflated(Equation& equ, const Mesh& mesh,
+                           VectorXd& b, VectorXd& x,
+                           double epsilon, int max_iter,
+                           int rank, int num_procs, MPI_Comm comm,
+                           double& r0, DeflationSpace& defl, int verbose = 0);
+
+/**
+ * @brief 用 PCG_parallel_deflated 求解并写回场变量（封装流程同 solveFieldPCG）
+ */
+void solveFieldPCGDeflated(Equation& equ, Mesh& mesh, MatrixXd& field,
+                           double tol, int max_iter,
+                           int rank, int num_procs, MPI_Comm comm,
+                           double& l2_norm, DeflationSpace& defl, int verbose);
+
+
+// ============================================================================
+// Chebyshev 多项式预条件（无内积，仅 SpMV + 接口交换）
+// ============================================================================
+
+/**
+ * @struct ChebyshevPrecond
+ * @brief Chebyshev 预条件的参数、谱区间缓存与统计
+ *
+ * @details
+ * 谱区间 [lmin, lmax] 针对 Jacobi 缩放后的算子 D⁻¹A。每 refresh 次求解中有一次
+ * 以 Jacobi 预条件开始，记录前 lanczos_steps 步的 PCG 系数 α / β，由
+ * lanczosExtremeEigenvalues 得到极端特征值后在同一次求解内切换为 Chebyshev 预条件
+ * （压力修正矩阵随 SIMPLE 迭代缓慢变化）；系数取自求解本身的归约，谱估计不引入额外的全局通信。
+ */
+struct ChebyshevPrecond {
+    int    degree        = 4;     ///< 多项式阶数（每次应用 degree-1 次 SpMV）
+    int    lanczos_steps = 10;    ///< 谱估计使用的 Jacobi-PCG 步数（刷新求解的前若干步）
+    int    refresh       = 20;    ///< 每隔多少次求解重新估计谱区间（0 = 只估计一次）
+    double safety        = 1.1;   ///< λmax 放大系数（Lanczos 从下方逼近 λmax）
+    bool   fixed         = false; ///< 每次求解恰好 max_iter 步（无收敛 / 停滞退出，谱区间只估计一次）
+
+    double lmin  = 0.0;           ///< 当前使用的谱下界
+    double lmax  = 0.0;           ///< 当前使用的谱上界（已乘 safety）
+    bool   valid = false;         ///< 谱区间是否可用
+
+    long solves     = 0;          ///< 累计求解次数
+    long iterations = 0;          ///< 累计外层 PCG 迭代次数
+    long estimates  = 0;          ///< 谱估计次数
+};
+
+/**
+ * @brief 由 Jacobi-PCG 系数构造 Lanczos 三对角阵，求 D⁻¹A 的极端特征值估计
+ *
+ * @details
+ * T(j,j) = 1/α_j + β_{j-1}/α_{j-1}，T(j,j+1) = √β_j/α_j，其最小 / 最大特征值
+ * 分别逼近 λmin / λmax（λmax 从下方逼近）。m 个 α 需要前 m−1 个 β。
+ * 纯本地计算；系数为空时返回 [0, 2]。
+ */
+void lanczosExtremeEigenvalues(const std::vector<double>& alpha, const std::vector<double>& beta,
+                               double& lmin, double& lmax);
+
+/**
+ * @brief Jacobi 缩放的 Chebyshev 迭代（degree 步），可作预条件或光滑器
+ *
+ * @details
+ * x ← x + p(D⁻¹A)·D⁻¹(b − A·x)，在 [lmin, lmax] 上以 Chebyshev 三项递推逼近 A⁻¹b。
+ * 每步一次 SpMV 与一次 HaloPlan 接口交换，全程不做内积，进程数增加时不引入全局归约。
+ * - 作 PCG 预条件：zero_guess = true，区间取估计的谱区间，得到固定的对称正定多项式算子
+ *   （PCG_parallel_cheb）
+ * - 作光滑器：zero_guess = false，区间取 [lmax/ratio, lmax]，只衰减高频分量
+ *   （smoothFieldCheb，FAS 粗网格级的压力修正方程）
+ *
+ * @param x   输入 / 输出：zero_guess 为 false 时作为初值
+ */
+void chebyshevSmooth(const SparseMatrix<double>& A, const HaloPlan& halo,
+                     const VectorXd& inv_diag, double lmin, double lmax, int degree,
+                     const VectorXd& b, VectorXd& x, bool zero_guess,
+                     int rank, int num_procs, MPI_Comm comm);
+
+/**
+ * @brief Chebyshev 多项式预条件 PCG
+ *
+ * @details
+ * 预条件 M⁻¹ = p(D⁻¹A)·D⁻¹ 由 chebyshevSmooth 以零初值应用，每次外层迭代
+ * degree 次 SpMV、仍只有 2 次 Allreduce；外层迭代次数约降为 Jacobi-PCG 的 1/degree 量级，
+ * 全局归约总数随之减少。谱区间见 ChebyshevPrecond。停滞判据与 PCG_parallel 相同；
+ * cheb.fixed 时恰好 max_iter 步，且在对称化系统上迭代：内积按 1/vol 加权，即在对称的
+ * S = diag(vol)⁻¹A 上做 CG（M⁻¹ 不变），常向量零空间时去掉 b/vol 的均值使系统相容；
+ * 求解是右端项的确定线性映射（供 Anderson 混合）。自适应求解的行为不变。
+ *
+ * @param cheb  预条件参数与谱区间缓存（输入 / 输出）
+ * 其余参数含义与 PCG_parallel 相同。
+ */
+void PCG_parallel_cheb(Equation& equ, const Mesh& mesh,
+                       VectorXd& b, VectorXd& x,
+                       double epsilon, int max_iter,
+                       int rank, int num_procs, MPI_Comm comm,
+                       double& r0, ChebyshevPrecond& cheb, int verbose = 0);
+
+/**
+ * @brief 用 PCG_parallel_cheb 求解并写回场变量（封装流程同 solveFieldPCG）
+ */
+void solveFieldPCGCheb(Equation& equ, Mesh& mesh, MatrixXd& field,
+                       double tol, int max_iter,
+                       int rank, int num_procs, MPI_Comm comm,
+                       double& l2_norm, ChebyshevPrecond& cheb, int verbose);
+
+/**
+ * @brief 以 Chebyshev 光滑代替求解：field 由零初值经 sweeps 次 chebyshevSmooth 得到
+ *
+ * @details
+ * 第一次以零初值应用，其后以当前值为初值（光滑器形式）。区间取 [lmax/ratio, lmax]，
+ * lmax = 2 为 D⁻¹A 的 Gershgorin 上界（压力修正方程 A_p ≥ Σ A_nb，弱对角占优），
+ * 不需谱估计；只衰减高频误差，低频由更粗的网格级处理。全程无全局归约。
+ *
+ * @param sweeps  光滑次数（每次 degree−1 次 SpMV）
+ * @param degree  多项式阶数
+ * @param ratio   光滑区间的 λmax / λmin
+ */
+void smoothFieldCheb(Equation& equ, Mesh& mesh, MatrixXd& field,
+                     int sweeps, int degree, double ratio,
+                     int rank, int num_procs, MPI_Comm comm);
+
+
+// ============================================================================
+// s-step（通信规避）PCG
+// ============================================================================
+
+/**
+ * @struct SStepConfig
+ * @brief s-step PCG 的参数与统计
+ */
+struct SStepConfig {
+    int  s               = 4;     ///< 每轮推进的迭代步数（建议 ≤ 5）
+    bool chebyshev_basis = true;  ///< Chebyshev 基（false 为单项式基，s ≥ 3 时易失稳）
+
+    long solves     = 0;          ///< 累计求解次数
+    long iterations = 0;          ///< 累计等效 CG 迭代次数
+    long rounds     = 0;          ///< 累计通信轮数（每轮一次 Gram Allreduce）
+};
+
+/**
+ * @brief s-step Jacobi-PCG（Chronopoulos–Gear 块形式）
+ *
+ * @details
+ * 每轮：
+ * 1. 由 z = D⁻¹r 生成 s 个基向量 P（Chebyshev 基，区间取 D⁻¹A 的 Gershgorin 界）
+ *    及 AP，共 s 次 SpMV，每次只做一次相邻进程间的接口列交换
+ * 2. 一次 Allreduce 得到 PᵀAP、Pᵀr、‖r‖²、(AW)ᵀP、Wᵀr
+ * 3. 与上一轮方向块 W 做 A-正交化 Q = P − W(WᵀAW)⁻¹(AW)ᵀP，
+ *    解 s×s 系统 (QᵀAQ)a = Qᵀr，x += Qa、r −= AQa，相当于推进 s 步 CG
+ *
+ * 与 PCG_parallel 每步 2 次全局归约相比，每 s 步只有 1 次；
+ * 接口列交换仍为每次 SpMV 一次（当前分区只有 2 列 ghost，无法一次交换 2s 列），
+ * 但点对点交换的延迟不随进程数增长。
+ * 收敛判据基于每轮开始时的 ‖r‖，因此最多多做 s 次 SpMV；QᵀAQ 不再正定
+ * （基向量线性相关）时以 exit_status = 3 退出。要求 A 对称。
+ *
+ * @param cfg  参数与统计（输入 / 输出）
+ * 其余参数含义与 PCG_parallel 相同。
+ */
+void PCG_parallel_sstep(Equation& equ, const Mesh& mesh,
+                        VectorXd& b, VectorXd& x,
+                        double epsilon, int max_iter,
+                        int rank, int num_procs, MPI_Comm comm,
+                        double& r0, SStepConfig& cfg, int verbose = 0);
+
+/**
+ * @brief 用 PCG_parallel_sstep 求解并写回场变量（封装流程同 solveFieldPCG）
+ */
+void solveFieldPCGSStep(Equation& equ, Mesh& mesh, MatrixXd& field,
+                        double tol, int max_iter,
+                        int rank, int num_procs, MPI_Comm comm,
+                        double& l2_norm, SStepConfig& cfg, int verbose);
+
+
+// ============================================================================
+// 非精确 SIMPLE：Eisenstat–Walker 线性求解精度
+// ============================================================================
+
+/**
+ * @struct InexactTolerance
+ * @brief 单个方程的非精确求解控制器（Eisenstat–Walker 第二类准则）
+ *
+ * @details
+ * 外层残差 ‖F_k‖ 取本次 SIMPLE 迭代离散后的 ‖b − A·φ‖（动量方程）或 ‖b‖
+ * （压力修正方程，即质量不平衡），强迫项
+ *   η_k = min(η_max, γ (‖F_k‖/‖F_{k−1}‖)^α)，
+ * 并在 γ η_{k−1}^α > 0.1 时取 max(η_k, γ η_{k−1}^α)，下限 tol_min。
+ *
+ * 动量方程改解修正量 A·δ = F（零初值即从当前外层迭代值 φ* 出发，结果写回
+ * φ = φ* + δ），线性求解的相对精度即为 η_k；求解器本身不变。外层远未收敛时放宽求解，接近收敛时随 ‖F‖ 的下降率收紧，
+ * 不动点与固定精度求解相同。enabled 为 false 时 begin() 直接返回 tol_fixed，
+ * 右端项与场变量均不改动。
+ *
+ * 用法：
+ * @code
+ *   double tol = ew.begin(equ_u, mesh, &mesh.u_star, rank, num_procs);
+ *   solveField(equ_u, mesh, mesh.u, tol, ...);
+ *   ew.end(equ_u, mesh, &mesh.u, rank, num_procs);
+ * @endcode
+ */
+struct InexactTolerance {
+    bool   enabled   = false;
+    double gamma     = 0.9;      ///< EW 系数 γ
+    double alpha     = 2.0;      ///< EW 指数 α
+    double eta_max   = 0.1;      ///< 强迫项上限
+    double tol_min   = 1e-10;    ///< 强迫项下限
+    double tol_fixed = 1e-5;     ///< 关闭时使用的固定精度
+
+    double prev_res = -1.0;      ///< 上一次外层残差（< 0 表示尚无记录）
+    double eta      = 0.0;       ///< 上一次强迫项
+
+    long solves     = 0;         ///< 累计求解次数
+    long iterations = 0;         ///< 累计 Krylov 迭代次数
+
+    /** @brief 新时间步开始时清除残差历史 */
+    void reset() { prev_res = -1.0; }
+
+    /**
+     * @brief 计算外层残差并返回本次线性求解的相对精度
+     * @param start  当前外层迭代值 φ*；非空时将 equ.source 替换为 F = b − A·φ*（一次 SpMV）
+     */
+    double begin(Equation& equ, const Mesh& mesh, const MatrixXd* start,
+                 int rank, int num_procs, MPI_Comm comm);
+
+    /** @brief field = φ* + δ、恢复右端项，并记录迭代次数（solver_stats.iterations） */
+    void end(Equation& equ, const Mesh& mesh, MatrixXd* field, int rank, int num_procs, MPI_Comm comm);
+
+private:
+    bool     warm = false;       ///< 本次求解是否为修正量形式
+    VectorXd x_old;              ///< 外层迭代值 φ*（内部点向量）
+    VectorXd saved_source;       ///< 原右端项
+};
+
+// ============================================================================
+// Anderson 加速（SIMPLE 外迭代）
+// ============================================================================
+
+/**
+ * @struct AndersonMixer
+ * @brief 对一次 SIMPLE 扫描 x → G(x) 做 Anderson（DIIS）混合
+ *
+ * @details
+ * 状态 x 为本进程内部单元的 (u*, v*, p) 与其四周的面速度 (u_face, v_face)（每个面只计一次），
+ * 与左侧 ghost 相邻的西面亦参与混合（权重 0，不计入内积，保证两侧进程数值一致）。
+ * 内积按分组（u*, v*, p, u_face, v_face）以首次扫描的均方残差归一化，使各量贡献相当。
+ * 记 f_k = G(x_k) − x_k，保留最近 depth 个差分 ΔF、ΔG，
+ *   γ = argmin ‖f_k − ΔF γ‖，x_{k+1} = x_k + βf_k − (ΔX + βΔF)γ，
+ * 法方程 ΔFᵀΔF γ = ΔFᵀf 的全部内积与 ‖f_k‖ 合并为一次 Allreduce（m² + m + 1 个 double）。
+ * ‖f_k‖（加权范数）超过历史最小值的 restart 倍、出现非有限值或最小二乘系数非有限时清空历史。
+ * depth = 0 时只计算 ‖f_k‖，不改动场变量。
+ *
+ * 用法：每次扫描前 capture(mesh)，扫描（含压力交换）后 mix(mesh, ...)。
+ */
+struct AndersonMixer {
+    int    depth   = 0;      ///< 历史深度 m（0 = 关闭混合）
+    double beta    = 1.0;    ///< 混合参数 β（1 = 不额外阻尼）
+    int    start   = 1;      ///< 第几次扫描起开始混合
+    double restart = 1e2;    ///< 残差放大倍数超过该值时重启
+
+    long mixes    = 0;       ///< 已执行的混合次数
+    long restarts = 0;       ///< 重启次数
+
+    /** @brief 由网格建立状态向量的索引（网格改变后须重新调用） */
+    void build(const Mesh& mesh);
+
+    /** @brief 清空历史 */
+    void reset();
+
+    /** @brief 记录扫描前状态 x_k */
+    void capture(const Mesh& mesh);
+
+    /**
+     * @brief 由扫描后状态 G(x_k) 计算 x_{k+1} 并写回网格（u*, v*, p, p_star, 面速度）
+     * @return 全局不动点残差 ‖G(x_k) − x_k‖
+     */
+    double mix(Mesh& mesh, int rank, int num_procs, MPI_Comm comm);
+
+private:
+    static const int NGROUP = 5;  ///< 分组：u*, v*, p, u_face, v_face
+    struct Entry {
+        MatrixXd Mesh::* field;
+        int group;
+        int idx;                  ///< 场数组中的线性下标
+    };
+    std::vector<Entry> entries;   ///< 状态向量各分量在网格中的位置
+    VectorXd weight;              ///< 内积权重（0 表示由相邻进程计入）
+    VectorXd x, f_prev, g_prev;
+    MatrixXd dF, dG;              ///< 差分历史（环形缓冲）
+    int  cols = 0, next = 0, steps = 0;
+    bool have_prev = false;
+    bool scaled    = false;       ///< 分组权重是否已归一化
+    double res_min = -1.0;
+
+    void gather(const Mesh& mesh, VectorXd& v) const;
+    void scatter(const VectorXd& v, Mesh& mesh) const;
+};
+
+
+
+// ============================================================================
+// 监测点（探针）时间序列输出
+// ============================================================================
+
+/**
+ * @struct ProbeSet
+ * @brief 物理坐标给定的监测点：一次定位、逐步采样、单进程写出 CSV
+ *
+ * @details
+ * 探针文件每行 `<名称> <x> <y>`，'#' 开头为注释。resolve() 在各进程的子网格上
+ * 按 x_c / y_c 找到包围该点的 2×2 单元中心并计算双线性权重（网格须为张量积，
+ * 与 gen.ipynb / cavity: 生成的网格一致；越出首末单元中心的点钳制到边界单元），
+ * 只保留落在本进程真实列（非 ghost 列）上的项。跨进程接口处的点由两侧进程各贡献
+ * 一部分，sample() 用一次 MPI_Reduce 求和到 rank 0，因此无需同步 ghost 列。
+ *
+ * 采样量为 u_star、v_star、p；rank 0 输出一行
+ * `step,time,<名称>.u,<名称>.v,<名称>.p,...`。
+ */
+struct ProbeSet {
+    std::vector<std::string> names;   ///< 探针名称
+    std::vector<double> px, py;       ///< 探针物理坐标
+    long samples = 0;                 ///< 已写出的采样次数
+
+    /** @brief rank 0 读取探针文件并在 comm 内广播 */
+    void load(const std::string& path, int rank, MPI_Comm comm);
+
+    /** @brief 在本进程子网格上定位探针并计算双线性权重（网格不变时只需一次） */
+    void resolve(const Mesh& mesh, int rank, int num_procs);
+
+    /**
+     * @brief rank 0 创建输出文件并写表头
+     * @param restart_step  ≥ 0 时为重启：保留已有文件中 step ≤ restart_step 的行并追加
+     */
+    void open(const std::string& file, int rank, int restart_step = -1);
+
+    /** @brief 采样当前场并由 rank 0 追加一行 */
+    void sample(const Mesh& mesh, int step, double time, int rank, MPI_Comm comm);
+
+private:
+    struct Term {
+        int probe;
+        int i, j;
+        double w;
+    };
+    std::vector<Term> terms;          ///< 本进程负责的插值项
+    std::ofstream out;
+};
+
+// ============================================================================
+// 检查点 / 重启
+// ============================================================================
+
+/**
+ * @brief 以 MPI-IO 集体写出检查点（全局布局，与进程数无关）
+ *
+ * @details
+ * 文件由 64 字节头（"TAIHOCK1"、全局 nx / ny、步数、时间、统计样本数）和按全局列优先
+ * 排列的场组成：u, v, p, u_star, v_star, u0, v0（ny×nx）、u_face（ny×(nx−1)）、
+ * v_face（(ny−1)×nx），stats 非空且已有样本时其后为 FlowStatistics 的 7 个累积量（ny×nx）。
+ * 各进程只写自己的真实列（列优先存储下为连续块），经 MPI_File_write_at_all 一次写入；
+ * 先写 path.tmp，检查每次写入的返回值与写出数量并在各进程间取一致结果，
+ * 全部成功后才由 rank 0 改名，写入失败或中途被终止都不会破坏上一个检查点。
+ * 失败时所有进程同时抛出 std::runtime_error。
+ *
+ * @param path       检查点文件路径
+ * @param mesh       当前进程的子网格（col_offset 给出其在全局网格中的位置）
+ * @param global_nx  原始网格的 nx
+ * @param step       已完成的迭代步 / 时间步编号
+ * @param time       已推进的物理时间（定常求解为 0）
+ * @param comm       求解器通信域（集体调用）
+ * @param stats      时间平均统计（可为空）
+ * @throws std::runtime_error 若任一进程写入失败或改名失败（所有进程一致抛出）
+ */
+void writeCheckpoint(const std::string& path, const Mesh& mesh, int global_nx,
+                     int step, double time, MPI_Comm comm,
+                     const FlowStatistics* stats = nullptr);
+
+/**
+ * @brief 集体读取检查点并恢复本进程子网格的场（含 ghost 列）
+ *
+ * @details
+ * 由于文件为全局布局，每个进程直接读取自己真实列对应的全局列区间，
+ * 因此可在不同进程数 / 不同划分下重启（重分布即读取不同的列区间）。
+ * ghost 列与连续计算时一致：p 经 exchangeColumns 同步，其余场不读取。
+ * 读入后 p_star = p。
+ *
+ * @param step   输出：检查点中的步数
+ * @param time   输出：检查点中的物理时间
+ * @param comm   求解器通信域（集体调用）
+ * @param stats  非空时重置并恢复时间平均统计（检查点不含统计时 samples = 0）
+ * @throws std::runtime_error 若文件无法打开或网格尺寸不一致
+ */
+void readCheckpoint(const std::string& path, Mesh& mesh, int global_nx,
+                    int& step, double& time, MPI_Comm comm,
+                    FlowStatistics* stats = nullptr);
+
+/**
+ * @brief 安装检查点信号处理：SIGUSR1 写检查点后继续，SIGTERM 写检查点后停止
+ */
+void installCheckpointSignals();
+
+/**
+ * @brief 汇总各进程收到的检查点信号（comm 内一次 Allreduce）
+ * @return 0 = 无，1 = SIGUSR1（写检查点并继续），2 = SIGTERM（写检查点并停止）
+ */
+int pollCheckpointSignal(MPI_Comm comm);
+
+// ============================================================================
+// 跨算例批量求解（AoSoA，每个 SIMD 通道一个算例）
+// ============================================================================
+
+/// 批量求解的 SIMD 宽度：每个 AoSoA 块内交错存放的算例数（8 个 double = 一条 AVX-512 向量）
+constexpr int BATCH_W = 8;
+
+/**
+ * @struct BatchStats
+ * @brief 批量 PCG 的累计统计
+ *
+ * @details lane_iterations / (block_iterations · BATCH_W) 即 SIMD 通道利用率，
+ *          提前收敛的算例被屏蔽后仍占用通道，利用率随之下降。
+ */
+struct BatchStats {
+    long solves           = 0;   ///< 累计块求解次数
+    long lane_iterations  = 0;   ///< 各算例迭代次数之和
+    long block_iterations = 0;   ///< 各块迭代次数之和（每次处理 BATCH_W 个通道）
+};
+
+/**
+ * @brief 批量 Jacobi-PCG：同一网格上多个算例的方程同步迭代
+ *
+ * @details
+ * 算例按 BATCH_W 个一块，系数与 Krylov 向量以 AoSoA 交错存储（单元 k 的 W 个算例连续），
+ * 五点 SpMV、AXPY 与内积的最内层循环沿算例方向，编译器可直接向量化为整条 SIMD 指令；
+ * 每次全局归约一次性携带 W 个算例的内积，接口列交换一次携带 W 个算例的 ghost 值。
+ *
+ * 每个通道独立维护 α、β、收敛与停滞判据（与 PCG_parallel 相同，零初值、
+ * 容差相对初始残差），已退出的通道以 α = 0、p 不变的方式屏蔽，不引入分支；
+ * 块内全部通道退出或达到 max_iter 时结束。
+ * 各方程须关联同一划分下的同构网格（仅系数与右端项不同）。
+ *
+ * @param equs     各算例的方程（已完成离散）
+ * @param fields   输出：各算例的场变量矩阵（内部点被解更新，ghost 列被同步）
+ * @param l2_norm  输出：各算例求解完成后的残差范数
+ * @param stats    累计统计（输入 / 输出）
+ * 其余参数含义与 solveFieldPCG 相同。
+ */
+void solveFieldPCGBatched(const std::vector<Equation*>& equs,
+                          const std::vector<MatrixXd*>& fields,
+                          double tol, int max_iter,
+                          int rank, int num_procs, MPI_Comm comm,
+                          std::vector<double>& l2_norm,
+                          BatchStats& stats, int verbose);
+
+/**
+ * @brief u、v 动量方程同步求解：两通道的批量 PCG（--uv-solve=fused）
+ *
+ * @details
+ * 两个方程逐步同步迭代：一次遍历五点系数同时作用于两个 Krylov 向量，
+ * 每步的接口列交换与 Allreduce 各只有一次、同时携带两个方程的数据，
+ * 两次独立求解的通信延迟由相加变为共享。每个方程的 α、β、收敛与停滞判据
+ * 独立（与 PCG_parallel 相同，零初值），先收敛者被屏蔽，直至两者都退出。
+ * solver_stats 依次记录 u、v 两次求解，结束后 iterations 为同步迭代步数（两者中较多者），
+ * 即每个方程实际占用的迭代次数。
+ *
+ * @param tol_u, tol_v  两个方程各自的相对容差
+ * 其余参数含义与 solveFieldPCG 相同。
+ */
+void solveFieldPCGPair(Equation& equ_u, Equation& equ_v, MatrixXd& u, MatrixXd& v,
+                       double tol_u, double tol_v, int max_iter,
+                       int rank, int num_procs, MPI_Comm comm,
+                       double& l2_u, double& l2_v, int verbose);
+
 #endif // PARALLEL_H
\ No newline at end of file
@@ -0,0 +1,618 @@
+#include "session.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+
+// ==================== 构造 / 分割 ====================
+
+SolverSession::SolverSession(const Mesh& local_mesh, MPI_Comm comm, const SessionConfig& cfg)
+    : mesh_(local_mesh), equ_u_(mesh_), equ_v_(mesh_), equ_p_(mesh_), cfg_(cfg), comm_(comm)
+{
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &nprocs_);
+    reset();
+}
+
+Mesh SolverSession::partition(const Mesh& global, MPI_Comm comm)
+{
+    int rank, np;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &np);
+    std::vector<Mesh> parts = splitMeshVertically(global, np);
+    return parts[rank];
+}
+
+void SolverSession::reset()
+{
+    for (MatrixXd* f : {&mesh_.u0, &mesh_.v0, &mesh_.u_star, &mesh_.v_star,
+                        &mesh_.u_face, &mesh_.v_face, &mesh_.u, &mesh_.v,
+                        &mesh_.p, &mesh_.p_prime, &mesh_.p_star}) {
+        f->setZero();
+    }
+    time_  = 0.0;
+    steps_ = 0;
+}
+
+void SolverSession::save(const std::string& folder) const
+{
+    saveMeshData(mesh_, rank_, folder);
+}
+
+
+// ==================== SIMPLE 迭代 ====================
+
+void SolverSession::simpleIteration(bool unsteady, SessionResult& r, bool smoothing)
+{
+    auto solve = cfg_.mixed_precision ? solveFieldPCGMixed : solveFieldPCG;
+
+    // 步骤1: 动量方程
+    if (unsteady) {
+        momentum_function_unsteady(mesh_, equ_u_, equ_v_, cfg_.mu, cfg_.dt);
+    } else {
+        momentum_function(mesh_, equ_u_, equ_v_, cfg_.mu, cfg_.alpha_uv);
+    }
+    const bool forced = !unsteady && forcing_.u.size() > 0;
+    if (forced) {
+        // FAS 强迫项：动量方程已乘松弛因子
+        for (int k = 0; k < mesh_.internumber; k++) {
+            const int i = mesh_.interi[k], j = mesh_.interj[k];
+            const int n = mesh_.interid(i, j);
+            equ_u_.source[n] += cfg_.alpha_uv * forcing_.u(i, j);
+            equ_v_.source[n] += cfg_.alpha_uv * forcing_.v(i, j);
+        }
+    }
+    // 强迫时动量方程改解修正量（固定精度）：动量矩阵非对称，零初值求解不能精确
+    // 复现 u*，修正量形式保证 τ = −r_c(x0) 时 x0 为不动点
+    InexactTolerance ew_u, ew_v;
+    for (InexactTolerance* ew : {&ew_u, &ew_v}) {
+        ew->enabled = forced;
+        ew->eta_max = ew->tol_min = ew->tol_fixed = cfg_.tol_uv;
+    }
+    solve(equ_u_, mesh_, mesh_.u, ew_u.begin(equ_u_, mesh_, &mesh_.u_star, rank_, nprocs_, comm_),
+          cfg_.max_iter_uv, rank_, nprocs_, comm_, r.res_u, cfg_.verbose);
+    ew_u.end(equ_u_, mesh_, &mesh_.u, rank_, nprocs_, comm_);
+    solve(equ_v_, mesh_, mesh_.v, ew_v.begin(equ_v_, mesh_, &mesh_.v_star, rank_, nprocs_, comm_),
+          cfg_.max_iter_uv, rank_, nprocs_, comm_, r.res_v, cfg_.verbose);
+    ew_v.end(equ_v_, mesh_, &mesh_.v, rank_, nprocs_, comm_);
+    exchangeColumns(equ_u_.A_p, rank_, nprocs_, comm_);
+
+    // 步骤2: 面速度插值
+    face_velocity(mesh_, equ_u_);
+    if (forced) {
+        mesh_.u_face += forcing_.u_face;
+        mesh_.v_face += forcing_.v_face;
+    }
+
+    // 步骤3: 压力修正方程
+    pressure_function(mesh_, equ_p_, equ_u_);
+    if (forced) {
+        for (int k = 0; k < mesh_.internumber; k++) {
+            const int i = mesh_.interi[k], j = mesh_.interj[k];
+            equ_p_.source[mesh_.interid(i, j)] += forcing_.m(i, j);
+        }
+    }
+    if (smoothing && cfg_.p_cheb_sweeps > 0) {
+        smoothFieldCheb(equ_p_, mesh_, mesh_.p_prime, cfg_.p_cheb_sweeps, cfg_.p_cheb_degree,
+                        cfg_.p_cheb_ratio, rank_, nprocs_, comm_);
+        r.res_p = 0.0;
+    } else {
+        solve(equ_p_, mesh_, mesh_.p_prime, cfg_.tol_p, cfg_.max_iter_p,
+              rank_, nprocs_, comm_, r.res_p, cfg_.verbose);
+    }
+
+    // 步骤4: 修正压力与速度
+    correct_pressure(mesh_, cfg_.alpha_p);
+    correct_velocity(mesh_, equ_u_);
+    mesh_.p = mesh_.p_star;
+    exchangeColumns(mesh_.p, rank_, nprocs_, comm_);
+
+    r.iterations++;
+}
+
+bool SolverSession::checkStop(int n, SessionResult& r, double prev[3])
+{
+    int local_stagnated = 0;
+    if (n > 1) {
+        const double du = std::abs(r.res_u - prev[0]) / (prev[0] + 1e-20);
+        const double dv = std::abs(r.res_v - prev[1]) / (prev[1] + 1e-20);
+        const double dp = std::abs(r.res_p - prev[2]) / (prev[2] + 1e-20);
+        if (std::max({du, dv, dp}) < cfg_.stagnation_tol) local_stagnated = 1;
+    }
+    prev[0] = r.res_u;
+    prev[1] = r.res_v;
+    prev[2] = r.res_p;
+
+    int global_stagnated = 0;
+    MPI_Allreduce(&local_stagnated, &global_stagnated, 1, MPI_INT, MPI_MAX, comm_);
+    if (global_stagnated) {
+        r.stagnated = true;
+        return true;
+    }
+
+    int local_converged = checkConvergence(r.res_u, r.res_v, r.res_p);
+    int global_converged = 0;
+    MPI_Allreduce(&local_converged, &global_converged, 1, MPI_INT, MPI_MIN, comm_);
+    r.converged = (global_converged != 0);
+    return r.converged;
+}
+
+SessionResult SolverSession::step()
+{
+    if (cfg_.dt <= 0.0) {
+        throw std::runtime_error("SolverSession::step: 需要 config().dt > 0");
+    }
+    SessionResult r;
+    double prev[3] = {-1.0, -1.0, -1.0};
+    for (int n = 1; n <= cfg_.max_simple_iter; n++) {
+        simpleIteration(true, r);
+        if (checkStop(n, r, prev)) break;
+    }
+
+    // 时间推进
+    mesh_.u0 = mesh_.u_star;
+    mesh_.v0 = mesh_.v_star;
+    time_ += cfg_.dt;
+    steps_++;
+    return r;
+}
+
+SessionResult SolverSession::solveSteady(int max_iters)
+{
+    SessionResult r;
+    double prev[3] = {-1.0, -1.0, -1.0};
+    double first[3] = {0.0, 0.0, 0.0};
+    for (int n = 1; n <= max_iters; n++) {
+        simpleIteration(false, r);
+        if (n == 1) {
+            first[0] = r.res_u;
+            first[1] = r.res_v;
+            first[2] = r.res_p;
+        }
+        if (checkStop(n, r, prev)) break;
+        // 宽松收敛（网格序列的粗网格级别）；残差为全局值，各进程判断一致
+        if (cfg_.outer_rtol > 0.0 && r.res_u <= cfg_.outer_rtol * first[0]
+            && r.res_v <= cfg_.outer_rtol * first[1] && r.res_p <= cfg_.outer_rtol * first[2]) {
+            r.converged = true;
+            break;
+        }
+    }
+    return r;
+}
+
+SessionResult SolverSession::smooth(int sweeps)
+{
+    SessionResult r;
+    for (int n = 1; n <= sweeps; n++) simpleIteration(false, r, true);
+    return r;
+}
+
+void SolverSession::residual(FasFields& r)
+{
+    simpleResidual(mesh_, equ_u_, equ_v_, equ_p_, cfg_.mu, r, comm_);
+    if (forcing_.u.size() > 0) {
+        r.u      += forcing_.u;
+        r.v      += forcing_.v;
+        r.m      += forcing_.m;
+        r.u_face += forcing_.u_face;
+        r.v_face += forcing_.v_face;
+    }
+}
+
+
+// ==================== 网格序列 ====================
+
+namespace {
+
+/// 子网格真实列范围 [lg, nx-rg)：两侧 ghost 各 2 列
+void realColumns(const Mesh& m, int& lg, int& rg)
+{
+    lg = (m.bctype(0, 0) == -3) ? 2 : 0;
+    rg = (m.bctype(0, m.nx - 1) == -3) ? 2 : 0;
+}
+
+/// 按位判断有限值（-ffast-math 下 std::isfinite 可能被优化为常量 true）
+bool finiteBits(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return ((bits >> 52) & 0x7ff) != 0x7ff;
+}
+
+/// 各进程的真实列收集为全局单元场，所有进程得到相同结果
+void gatherField(const Mesh& local, const MatrixXd& f, MatrixXd& g, MPI_Comm comm)
+{
+    int lg, rg;
+    realColumns(local, lg, rg);
+    const int rows = static_cast<int>(f.rows());
+    const int c0 = local.col_offset + lg;
+    const int count = (local.nx - lg - rg) * rows;
+
+    int np;
+    MPI_Comm_size(comm, &np);
+    std::vector<int> counts(np), displs(np);
+    int disp = c0 * rows;
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+    MPI_Allgather(&disp, 1, MPI_INT, displs.data(), 1, MPI_INT, comm);
+    MPI_Allgatherv(f.data() + static_cast<size_t>(lg) * rows, count, MPI_DOUBLE,
+                   g.data(), counts.data(), displs.data(), MPI_DOUBLE, comm);
+}
+
+/// 全局场 → 子网格真实列（u_face 含左侧接口面，与 readCheckpoint 一致）
+void scatterField(const MatrixXd& g, Mesh& local, MatrixXd& f, int col_trim)
+{
+    int lg, rg;
+    realColumns(local, lg, rg);
+    const int c0 = col_trim ? std::max(lg - 1, 0) : lg;
+    const int c1 = std::min<int>(local.nx - rg, static_cast<int>(f.cols()));
+    if (c1 > c0) f.middleCols(c0, c1 - c0) = g.middleCols(local.col_offset + c0, c1 - c0);
+}
+
+} // namespace
+
+int sequenceInitialGuess(const Mesh& global, Mesh& local, int levels, int max_iters,
+                         double rtol, SessionConfig cfg, MPI_Comm comm, bool verbose)
+{
+    int rank, np;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &np);
+
+    // ===== 1. 网格层级：hierarchy[0] 为原始网格 =====
+    std::vector<Mesh> hierarchy;
+    hierarchy.push_back(global);
+    while (static_cast<int>(hierarchy.size()) <= levels) {
+        const Mesh& f = hierarchy.back();
+        Mesh c = coarsenMesh(f);
+        if (c.nx < 8 || c.ny < 8 || c.nx < 4 * np || 2 * c.internumber > f.internumber) break;
+        hierarchy.push_back(std::move(c));
+    }
+    const int n_levels = static_cast<int>(hierarchy.size()) - 1;
+    if (n_levels == 0) {
+        if (rank == 0 && verbose) std::cout << "[网格序列] 网格过小，未进行粗化" << std::endl;
+        return 0;
+    }
+
+    cfg.outer_rtol = rtol;
+    int total_iters = 0;
+    bool have_guess = false;   // hierarchy[k] 是否持有上一级插值得到的初值
+
+    // ===== 2. 由粗到细：求解 → 收集 → 插值 =====
+    for (int k = n_levels; k >= 1; --k) {
+        Mesh& level = hierarchy[k];
+        SolverSession s(SolverSession::partition(level, comm), comm, cfg);
+        Mesh& m = s.mesh();
+        if (have_guess) {
+            // 上一级插值得到的初值
+            scatterField(level.u_star, m, m.u_star, 0);
+            scatterField(level.v_star, m, m.v_star, 0);
+            scatterField(level.p, m, m.p, 0);
+            scatterField(level.u_face, m, m.u_face, 1);
+            scatterField(level.v_face, m, m.v_face, 0);
+            m.u = m.u_star;
+            m.v = m.v_star;
+            exchangeColumns(m.p, rank, np, comm);
+            m.p_star = m.p;
+        }
+
+        const SessionResult r = s.solveSteady(max_iters);
+        total_iters += r.iterations;
+        if (rank == 0 && verbose) {
+            const std::ios::fmtflags flags = std::cout.flags();
+            const std::streamsize prec = std::cout.precision();
+            std::cout << std::scientific << std::setprecision(3)
+                      << "[网格序列] 第 " << k << " 级 " << level.nx << "×" << level.ny
+                      << ": " << r.iterations << " 次迭代, 残差 u " << r.res_u
+                      << " v " << r.res_v << " p " << r.res_p << std::endl;
+            std::cout.flags(flags);
+            std::cout.precision(prec);
+        }
+
+        // 粗网格分辨率不足时可能发散：丢弃本级结果，上一级从零场开始
+        Mesh& finer = hierarchy[k - 1];
+        for (MatrixXd* f : {&finer.u, &finer.u_star, &finer.v, &finer.v_star,
+                            &finer.p, &finer.p_star, &finer.u_face, &finer.v_face}) {
+            f->setZero();
+        }
+        int local_bad = !(finiteBits(r.res_u) && finiteBits(r.res_v) && finiteBits(r.res_p));
+        int bad = 0;
+        MPI_Allreduce(&local_bad, &bad, 1, MPI_INT, MPI_MAX, comm);
+        if (bad) {
+            if (rank == 0 && verbose) {
+                std::cout << "[网格序列] 第 " << k << " 级发散，舍弃该级结果" << std::endl;
+            }
+            have_guess = false;
+            continue;
+        }
+
+        level.u_star.setZero();
+        level.v_star.setZero();
+        level.p.setZero();
+        gatherField(m, m.u_star, level.u_star, comm);
+        gatherField(m, m.v_star, level.v_star, comm);
+        gatherField(m, m.p, level.p, comm);
+        prolongFields(level, finer);
+        have_guess = true;
+    }
+
+    // ===== 3. 细网格初值写入本进程子网格 =====
+    const Mesh& fine = hierarchy[0];
+    scatterField(fine.u_star, local, local.u_star, 0);
+    scatterField(fine.v_star, local, local.v_star, 0);
+    scatterField(fine.p, local, local.p, 0);
+    scatterField(fine.u_face, local, local.u_face, 1);
+    scatterField(fine.v_face, local, local.v_face, 0);
+    local.u = local.u_star;
+    local.v = local.v_star;
+    exchangeColumns(local.p, rank, np, comm);
+    local.p_star = local.p;
+    return total_iters;
+}
+
+
+// ==================== FAS 非线性多重网格 ====================
+
+void simpleResidual(Mesh& mesh, Equation& equ_u, Equation& equ_v, Equation& equ_p,
+                    double mu, FasFields& r, MPI_Comm comm)
+{
+    int rank, np;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &np);
+
+    // ghost 列的 u* / v* 不随迭代更新，这里按相邻进程的值补齐
+    MatrixXd us = mesh.u_star, vs = mesh.v_star;
+    exchangeColumns(us, rank, np, comm);
+    exchangeColumns(vs, rank, np, comm);
+
+    // 动量：以现有面速度为对流通量组装不松弛的方程，残差 b − A·u*
+    momentum_function(mesh, equ_u, equ_v, mu, 1.0);
+    r.u.setZero(mesh.ny, mesh.nx);
+    r.v.setZero(mesh.ny, mesh.nx);
+    const MatrixXd& A_p = equ_u.A_p;
+    const MatrixXd& A_e = equ_u.A_e;
+    const MatrixXd& A_w = equ_u.A_w;
+    const MatrixXd& A_n = equ_u.A_n;
+    const MatrixXd& A_s = equ_u.A_s;
+    for (int k = 0; k < mesh.internumber; k++) {
+        const int i = mesh.interi[k], j = mesh.interj[k];
+        const int n = mesh.interid(i, j);
+        r.u(i, j) = equ_u.source[n] - (A_p(i, j) * us(i, j) - A_e(i, j) * us(i, j + 1)
+                    - A_w(i, j) * us(i, j - 1) - A_n(i, j) * us(i - 1, j) - A_s(i, j) * us(i + 1, j));
+        r.v(i, j) = equ_v.source[n] - (A_p(i, j) * vs(i, j) - A_e(i, j) * vs(i, j + 1)
+                    - A_w(i, j) * vs(i, j - 1) - A_n(i, j) * vs(i - 1, j) - A_s(i, j) * vs(i + 1, j));
+    }
+
+    // 连续性：现有面速度的质量不平衡
+    pressure_function(mesh, equ_p, equ_u);
+    r.m.setZero(mesh.ny, mesh.nx);
+    for (int k = 0; k < mesh.internumber; k++) {
+        const int i = mesh.interi[k], j = mesh.interj[k];
+        r.m(i, j) = equ_p.source[mesh.interid(i, j)];
+    }
+
+    // 面速度：由 (u*, v*, p) 重新插值，与现有面速度之差
+    const MatrixXd u_face = mesh.u_face, v_face = mesh.v_face;
+    mesh.u = us;
+    mesh.v = vs;
+    exchangeColumns(equ_u.A_p, rank, np, comm);
+    face_velocity(mesh, equ_u);
+    r.u_face = mesh.u_face - u_face;
+    r.v_face = mesh.v_face - v_face;
+    mesh.u_face = u_face;
+    mesh.v_face = v_face;
+}
+
+namespace {
+
+/**
+ * 面速度的通量平均限制：粗网格东面 = 组内最后一列细单元的东面（至多两个子面）
+ * 按面积加权平均，南面同理。
+ * 子面可能属于右侧进程，先把各列东面 / 南面补成 ny×nx 的场做 ghost 交换；
+ * 结果再交换一次，使进程接口面两侧一致。
+ */
+void restrictFaces(const Mesh& mf, const MatrixXd& fu, const MatrixXd& fv,
+                   const Mesh& mc, MatrixXd& cu, MatrixXd& cv, int rank, int np,
+                   MPI_Comm comm)
+{
+    MatrixXd east = MatrixXd::Zero(mf.ny, mf.nx), south = MatrixXd::Zero(mf.ny, mf.nx);
+    east.leftCols(mf.nx - 1) = fu;
+    south.topRows(mf.ny - 1) = fv;
+    exchangeColumns(east, rank, np, comm);
+    exchangeColumns(south, rank, np, comm);
+
+    int lg, rg;
+    realColumns(mc, lg, rg);
+    MatrixXd ce = MatrixXd::Zero(mc.ny, mc.nx), cs = MatrixXd::Zero(mc.ny, mc.nx);
+    for (int J = lg; J < mc.nx - rg; ++J) {
+        const int j0 = mc.fine_col0[J] - mf.col_offset;
+        const int j1 = mc.fine_col0[J + 1] - mf.col_offset - 1;   // 组内最后一列，其东面即粗单元东面
+        for (int I = 0; I < mc.ny; ++I) {
+            const int i0 = mc.fine_row0[I], i1 = mc.fine_row0[I + 1] - 1;
+            double flux = 0.0, area = 0.0;
+            if (j1 < mf.nx - 1) {
+                for (int i = i0; i <= i1; ++i) {
+                    flux += east(i, j1) * mf.area_e(i, j1);
+                    area += mf.area_e(i, j1);
+                }
+                if (area > 0.0) ce(I, J) = flux / area;
+            }
+            if (I < mc.ny - 1) {
+                flux = area = 0.0;
+                for (int j = j0; j <= std::min(j1, mf.nx - 1); ++j) {
+                    flux += south(i1, j) * mf.area_s(i1, j);
+                    area += mf.area_s(i1, j);
+                }
+                if (area > 0.0) cs(I, J) = flux / area;
+            }
+        }
+    }
+    exchangeColumns(ce, rank, np, comm);
+    exchangeColumns(cs, rank, np, comm);
+    cu = ce.leftCols(mc.nx - 1);
+    cv = cs.topRows(mc.ny - 1);
+}
+
+double fieldsNorm(const FasFields& r, MPI_Comm comm)
+{
+    double local_sq[5] = {r.u.squaredNorm(), r.v.squaredNorm(), r.m.squaredNorm(),
+                          r.u_face.squaredNorm(), r.v_face.squaredNorm()};
+    double global_sq[5];
+    MPI_Allreduce(local_sq, global_sq, 5, MPI_DOUBLE, MPI_SUM, comm);
+    return std::sqrt(*std::max_element(global_sq, global_sq + 5));
+}
+
+} // namespace
+
+FasMultigrid::FasMultigrid(const Mesh& global, Mesh& fine, int levels, const SessionConfig& cfg,
+                           MPI_Comm comm)
+    : fine_(fine), equ_u_(fine), equ_v_(fine), equ_p_(fine), cfg_(cfg), comm_(comm)
+{
+    int rank, np;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &np);
+
+    fine_bc_ = global.bctype.middleCols(fine.col_offset, fine.nx);
+    cfg_.outer_rtol = 0.0;
+
+    // 本级真实列 [c0, c1)（全局列号）
+    int lg, rg;
+    realColumns(fine, lg, rg);
+    int c0 = fine.col_offset + lg;
+    int c1 = fine.col_offset + fine.nx - rg;
+
+    Mesh g = global;
+    for (int k = 0; k < levels; ++k) {
+        Mesh gc = coarsenMesh(g);
+        if (gc.nx < 8 || gc.ny < 8 || 2 * gc.internumber > g.internumber) break;
+
+        // 粗网格列范围与细网格对齐：本进程取子单元组起点落在真实列 [c0, c1) 的粗列，
+        // 组内第二列至多落在右侧 ghost 列内
+        const auto& cols = gc.fine_col0;
+        const int d0 = static_cast<int>(std::lower_bound(cols.begin(), cols.end(), c0) - cols.begin());
+        const int d1 = static_cast<int>(std::lower_bound(cols.begin(), cols.end(), c1) - cols.begin());
+        int width = d1 - d0;
+        std::vector<int> widths(np);
+        MPI_Allgather(&width, 1, MPI_INT, widths.data(), 1, MPI_INT, comm_);
+        if (np > 1 && *std::min_element(widths.begin(), widths.end()) < 2) break;
+
+        Mesh local = splitMeshVertically(gc, widths)[rank];
+        Level level;
+        level.bc = gc.bctype.middleCols(local.col_offset, local.nx);
+        level.session = std::make_unique<SolverSession>(local, comm_, cfg_);
+        coarse_.push_back(std::move(level));
+
+        g = std::move(gc);
+        c0 = d0;
+        c1 = d1;
+    }
+    // 最粗一级没有更粗的网格处理低频压力误差，压力修正方程仍以 PCG 求解
+    if (!coarse_.empty()) coarse_.back().session->config().p_cheb_sweeps = 0;
+}
+
+double FasMultigrid::cycle()
+{
+    FasFields r;
+    simpleResidual(fine_, equ_u_, equ_v_, equ_p_, cfg_.mu, r, comm_);
+    const double res = fieldsNorm(r, comm_);
+
+    if (!coarse_.empty() && !correct(0, r)) rejected++;
+    cycles++;
+    return res;
+}
+
+bool FasMultigrid::correct(int l, const FasFields& r)
+{
+    int rank, np;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &np);
+
+    Mesh& mf = (l == 0) ? fine_ : coarse_[l - 1].session->mesh();
+    const MatrixXi& bc_f = (l == 0) ? fine_bc_ : coarse_[l - 1].bc;
+    Level& level = coarse_[l];
+    SolverSession& s = *level.session;
+    Mesh& mc = s.mesh();
+
+    // ===== 1. 限制：x_c⁰ = R·x_f（子单元可能位于右侧 ghost 列，先交换） =====
+    MatrixXd fu = mf.u_star, fv = mf.v_star;
+    MatrixXd ru = r.u, rv = r.v, rm = r.m;
+    for (MatrixXd* f : {&fu, &fv, &ru, &rv, &rm}) exchangeColumns(*f, rank, np, comm_);
+
+    restrictField(mf, bc_f, fu, mc, level.bc, mc.u_star, true);
+    restrictField(mf, bc_f, fv, mc, level.bc, mc.v_star, true);
+    restrictField(mf, bc_f, mf.p, mc, level.bc, mc.p, true);
+    for (MatrixXd* f : {&mc.u_star, &mc.v_star, &mc.p}) exchangeColumns(*f, rank, np, comm_);
+    mc.p_star = mc.p;
+    restrictFaces(mf, mf.u_face, mf.v_face, mc, mc.u_face, mc.v_face, rank, np, comm_);
+    const MatrixXd u0 = mc.u_star, v0 = mc.v_star, p0 = mc.p;
+
+    // ===== 2. 强迫项 τ = R·r_f − r_c(x_c⁰) =====
+    FasFields tau;
+    s.forcing() = FasFields();
+    s.residual(tau);
+    MatrixXd R = MatrixXd::Zero(mc.ny, mc.nx);
+    restrictField(mf, bc_f, ru, mc, level.bc, R, false);
+    tau.u = R - tau.u;
+    R.setZero();
+    restrictField(mf, bc_f, rv, mc, level.bc, R, false);
+    tau.v = R - tau.v;
+    R.setZero();
+    restrictField(mf, bc_f, rm, mc, level.bc, R, false);
+    tau.m = R - tau.m;
+    MatrixXd Ru, Rv;
+    restrictFaces(mf, r.u_face, r.v_face, mc, Ru, Rv, rank, np, comm_);
+    tau.u_face = Ru - tau.u_face;
+    tau.v_face = Rv - tau.v_face;
+    s.forcing() = std::move(tau);
+
+    // ===== 3. 粗网格光滑，递归到更粗一级 =====
+    FasFields rc;
+    s.residual(rc);
+    const double res0 = fieldsNorm(rc, comm_);
+    s.smooth(pre_sweeps);
+    sweeps += pre_sweeps;
+    if (l + 1 < levels()) {
+        s.residual(rc);
+        if (!correct(l + 1, rc)) rejected++;
+    }
+    s.smooth(post_sweeps);
+    sweeps += post_sweeps;
+    // 粗网格方程的残差增长一个量级以上（强拉伸网格的粗网格上 SIMPLE 可能发散）时舍弃修正
+    s.residual(rc);
+    const double res1 = fieldsNorm(rc, comm_);
+    if (!finiteBits(res1) || res1 > 10.0 * res0) return false;
+
+    // ===== 4. 插值修正：x_f += ω·P·(x_c − x_c⁰)，x = (u*, v*, p) =====
+    MatrixXd eu = mc.u_star - u0, ev = mc.v_star - v0, ep = mc.p - p0;
+    for (MatrixXd* f : {&eu, &ev, &ep}) exchangeColumns(*f, rank, np, comm_);
+
+    int local_bad = !(finiteBits(eu.sum()) && finiteBits(ev.sum()) && finiteBits(ep.sum()));
+    int bad = 0;
+    MPI_Allreduce(&local_bad, &bad, 1, MPI_INT, MPI_MAX, comm_);
+    if (bad) return false;
+
+    eu *= damping;
+    ev *= damping;
+    ep *= damping;
+    MatrixXd du = MatrixXd::Zero(mf.ny, mf.nx), dv = du, dp = du;
+    prolongCorrection(mc, level.bc, eu, mf, du);
+    prolongCorrection(mc, level.bc, ev, mf, dv);
+    prolongCorrection(mc, level.bc, ep, mf, dp);
+    for (MatrixXd* f : {&du, &dv, &dp}) exchangeColumns(*f, rank, np, comm_);
+    mf.u_star += du;
+    mf.v_star += dv;
+    mf.p      += dp;
+    mf.p_star  = mf.p;
+
+    // 面速度：相邻单元修正量的平均（只改与本进程内部点相邻的流体面）
+    for (int i = 0; i < mf.ny; ++i)
+        for (int j = 0; j < mf.nx - 1; ++j)
+            if (bc_f(i, j) == 0 && bc_f(i, j + 1) == 0
+                && (mf.bctype(i, j) == 0 || mf.bctype(i, j + 1) == 0))
+                mf.u_face(i, j) += 0.5 * (du(i, j) + du(i, j + 1));
+    for (int i = 0; i < mf.ny - 1; ++i)
+        for (int j = 0; j < mf.nx; ++j)
+            if (mf.bctype(i, j) == 0 && mf.bctype(i + 1, j) == 0)
+                mf.v_face(i, j) += 0.5 * (dv(i, j) + dv(i + 1, j));
+    return true;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file    session.h
+ * @brief   可嵌入的求解器会话 —— 在进程内反复调用 SIMPLE 求解（libtaiho 的入口）
+ *
+ * @details
+ * solver_simple_steady / solver_simple_unsteady 的 main() 负责命令行解析、网格读取、
+ * 分割与文本输出；SolverSession 只保留其中的求解部分，供外部程序（例如优化循环）
+ * 在同一进程内成千上万次地调用，无需重新启动 MPI 作业、重读网格或落盘：
+ *
+ * @code
+ *   Mesh global = loadMesh("cavity:128x128");
+ *   SolverSession s(SolverSession::partition(global, comm), comm, cfg);
+ *   for (double mu : candidates) {
+ *       s.reset();
+ *       s.config().mu = mu;
+ *       s.solveSteady(500);
+ *       double obj = evaluate(s.u(), s.v(), s.p());   // 直接读取场变量，无拷贝
+ *   }
+ * @endcode
+ *
+ * 通信器约定：
+ * - 会话的进程号 / 进程数取自构造时传入的通信器，所有通信都显式传入该通信器，
+ *   因此同一进程内的多个会话可以各自使用不同的通信器（依次调用，不可并发）。
+ *
+ * @note solver_stats / total_comm_time 等统计量仍为全局变量，由最近一次求解更新。
+ *
+ * @author  midway
+ * @version 2.0
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "fluid.h"
+#include "parallel.h"
+#include <memory>
+
+
+// ============================================================================
+// 会话配置与结果
+// ============================================================================
+
+/**
+ * @brief 会话的物理与数值参数（默认值与两个求解器程序一致）
+ *
+ * 可在两次求解之间通过 SolverSession::config() 修改。
+ */
+struct SessionConfig {
+    double mu  = 0.01;              ///< 动力黏度
+    double dt  = 0.0;               ///< 时间步长（仅 step() 使用）
+
+    double alpha_p  = 0.3;          ///< 压力松弛因子
+    double alpha_uv = 0.5;          ///< 动量松弛因子（仅定常）
+    double tol_uv   = 1e-5;         ///< 速度求解精度
+    double tol_p    = 1e-5;         ///< 压力求解精度
+    int    max_iter_uv = 10;        ///< 速度最大 PCG 迭代次数
+    int    max_iter_p  = 200;       ///< 压力最大 PCG 迭代次数
+    int    max_simple_iter = 20;    ///< step() 中每个时间步的 SIMPLE 最大迭代次数
+    double stagnation_tol  = 1e-3;  ///< 残差相对变化低于该值时判定为停滞
+    double outer_rtol      = 0.0;   ///< >0 时 solveSteady 在 u/v/p 残差均降至首次迭代的该倍数时返回
+
+    bool mixed_precision = false;   ///< 使用混合精度 PCG（solveFieldPCGMixed）
+    int  verbose = 0;               ///< 线性求解器输出级别（0 = 静默）
+
+    // smooth() 中压力修正方程的 Chebyshev 光滑（FAS 粗网格级，见 smoothFieldCheb）
+    int    p_cheb_sweeps = 0;       ///< >0 时压力修正方程不求解，改做该次数的 Chebyshev 光滑
+    int    p_cheb_degree = 4;       ///< 光滑多项式阶数
+    double p_cheb_ratio  = 30.0;    ///< 光滑区间 [2/ratio, 2]（D⁻¹A 的高频端）
+};
+
+/**
+ * @brief FAS 的残差 / 强迫项：与 SIMPLE 状态 (u*, v*, p, 面速度) 同布局的五组场
+ *
+ * 作为强迫项时（为空矩阵表示不加），定常 SIMPLE 迭代中 u / v 动量方程源项加 u / v，
+ * 面速度插值结果加 u_face / v_face，压力修正方程源项加 m。
+ */
+struct FasFields {
+    MatrixXd u;        ///< x 动量方程（按单元体积积分），ny×nx
+    MatrixXd v;        ///< y 动量方程，ny×nx
+    MatrixXd m;        ///< 连续性方程（质量不平衡），ny×nx
+    MatrixXd u_face;   ///< 东面速度方程，ny×(nx-1)
+    MatrixXd v_face;   ///< 南面速度方程，(ny-1)×nx
+};
+
+/** @brief 一次 step() / solveSteady() 的结果（所有进程一致） */
+struct SessionResult {
+    double res_u = 0.0;      ///< 最后一次 SIMPLE 迭代的 u 全局残差
+    double res_v = 0.0;      ///< 最后一次 SIMPLE 迭代的 v 全局残差
+    double res_p = 0.0;      ///< 最后一次 SIMPLE 迭代的 p 全局残差
+    int  iterations = 0;     ///< 本次调用执行的 SIMPLE 迭代次数
+    bool converged  = false; ///< 是否满足 checkConvergence
+    bool stagnated  = false; ///< 是否因残差停滞提前退出
+};
+
+
+// ============================================================================
+// 求解器会话
+// ============================================================================
+
+/**
+ * @class SolverSession
+ * @brief 持有一个子网格、三组方程及通信器的 SIMPLE 求解器
+ *
+ * @details
+ * - step()：推进一个时间步（非定常 SIMPLE，步末 u0 / v0 ← u* / v*）
+ * - solveSteady(n)：至多 n 次定常 SIMPLE 迭代，收敛或停滞时提前返回
+ * - u() / v() / p() / mesh()：直接返回内部场变量的引用（零拷贝，可读可写）
+ *
+ * Equation 持有 Mesh 的引用，因此会话不可拷贝、不可移动。
+ */
+class SolverSession {
+public:
+    /**
+     * @brief 由本进程的子网格构造会话
+     * @param local_mesh  本进程的子网格（通常来自 partition()），会被复制进会话
+     * @param comm        求解使用的通信器（进程数须与子网格划分一致）
+     * @param cfg         物理与数值参数
+     */
+    SolverSession(const Mesh& local_mesh, MPI_Comm comm,
+                  const SessionConfig& cfg = SessionConfig());
+
+    SolverSession(const SolverSession&) = delete;
+    SolverSession& operator=(const SolverSession&) = delete;
+
+    /**
+     * @brief 按通信器的进程数均匀分割全局网格，返回本进程的子网格
+     *
+     * 各进程都需持有完整的全局网格（例如各自调用 loadMesh，或用 broadcastMesh 分发）。
+     */
+    static Mesh partition(const Mesh& global, MPI_Comm comm);
+
+    /** @brief 推进一个时间步（需 config().dt > 0） */
+    SessionResult step();
+
+    /** @brief 至多 max_iters 次定常 SIMPLE 迭代 */
+    SessionResult solveSteady(int max_iters);
+
+    /**
+     * @brief 恰好 sweeps 次定常 SIMPLE 迭代，不做收敛 / 停滞判断（FAS 光滑）
+     *
+     * config().p_cheb_sweeps > 0 时压力修正方程只做 Chebyshev 光滑，res_p 记为 0。
+     */
+    SessionResult smooth(int sweeps);
+
+    /** @brief 当前状态的非线性残差（含强迫项），见 simpleResidual */
+    void residual(FasFields& r);
+
+    /** @brief 场变量清零、时间归零（网格与边界条件保持不变） */
+    void reset();
+
+    /** @brief 按 saveMeshData 的格式输出当前结果 */
+    void save(const std::string& folder) const;
+
+    // -------------------- 访问器（零拷贝） --------------------
+    Mesh&       mesh()       { return mesh_; }
+    const Mesh& mesh() const { return mesh_; }
+    MatrixXd&   u() { return mesh_.u_star; }  ///< 单元中心 u（最近一次修正后）
+    MatrixXd&   v() { return mesh_.v_star; }  ///< 单元中心 v（最近一次修正后）
+    MatrixXd&   p() { return mesh_.p; }       ///< 单元中心压力
+    FasFields&  forcing() { return forcing_; } ///< 定常迭代的附加源项（FAS）
+
+    SessionConfig&       config()       { return cfg_; }
+    const SessionConfig& config() const { return cfg_; }
+
+    MPI_Comm comm()   const { return comm_; }
+    int      rank()   const { return rank_; }
+    int      nprocs() const { return nprocs_; }
+    double   time()   const { return time_; }   ///< 已推进的物理时间
+    int      steps()  const { return steps_; }  ///< 已推进的时间步数
+
+private:
+    /**
+     * @brief 一次 SIMPLE 迭代（定常或非定常离散），写入 r 的三个残差
+     * @param smoothing  由 smooth() 调用（允许压力修正方程改用 Chebyshev 光滑）
+     */
+    void simpleIteration(bool unsteady, SessionResult& r, bool smoothing = false);
+
+    /** @brief 停滞 / 收敛的全局判断（两次 Allreduce，与求解器程序一致） */
+    bool checkStop(int n, SessionResult& r, double prev[3]);
+
+    Mesh          mesh_;
+    Equation      equ_u_, equ_v_, equ_p_;
+    SessionConfig cfg_;
+    FasFields     forcing_;
+    MPI_Comm      comm_;
+    int           rank_   = 0;
+    int           nprocs_ = 1;
+    double        time_   = 0.0;
+    int           steps_  = 0;
+};
+
+
+// ============================================================================
+// 网格序列（粗网格初值）
+// ============================================================================
+
+/**
+ * @brief 在逐级粗化的网格上求解，插值得到细网格的初始场
+ *
+ * @details
+ * global 连续用 coarsenMesh 粗化 levels 次（粗网格过小——任一方向少于 8 个单元，
+ * 或列数少于 4 × 进程数——或内部点数未减半时提前停止）。从最粗一级开始，每级在 comm 上
+ * 分割并用 SolverSession::solveSteady 宽松求解（至多 max_iters 次，或残差降至
+ * 首次迭代的 rtol 倍），收集为全局场后用 prolongFields 插值到上一级。
+ *
+ * 最后一级插值结果按本进程列范围写入 local 的真实列（u / v / p 及面速度），
+ * ghost 列与检查点重启时一样由压力交换重建。
+ *
+ * @param global     未分割的全局网格（各进程均持有）
+ * @param local      本进程子网格（由 global 分割得到，场变量将被覆盖）
+ * @param levels     最多粗化级数
+ * @param max_iters  每级 SIMPLE 迭代上限
+ * @param rtol       每级的相对残差收敛判据
+ * @param cfg        粗网格求解参数（outer_rtol 被 rtol 覆盖）
+ * @param comm       求解通信域（local 按其进程数分割）
+ * @param verbose    rank 0 是否打印每级摘要
+ * @return 所有粗网格级别上的 SIMPLE 迭代总数
+ */
+int sequenceInitialGuess(const Mesh& global, Mesh& local, int levels, int max_iters,
+                         double rtol, SessionConfig cfg, MPI_Comm comm, bool verbose);
+
+
+// ============================================================================
+// FAS 非线性多重网格
+// ============================================================================
+
+/**
+ * @brief 定常 SIMPLE 离散在当前状态下的非线性残差
+ *
+ * @details
+ * SIMPLE 的状态为 (u*, v*, p) 与面速度 F，不动点满足三组方程：
+ * - 动量：r_u / r_v = b − A(F)·u*（不松弛，按单元体积积分，对流通量取 F）；
+ * - 面速度：r_F = RC(u*, v*, p; A_p(F)) − F（RC 为 Rhie-Chow 插值，即 face_velocity）；
+ * - 连续性：r_m = F 的质量不平衡（即压力修正方程的源项）。
+ *
+ * 单元残差只写内部点。mesh 的面速度保持不变；mesh.u / v 被置为 u* / v*（含 ghost 列），
+ * p_prime 被清零，方程对象的系数被覆盖。comm 为 mesh 分割所用的通信域（ghost 交换）。
+ */
+void simpleResidual(Mesh& mesh, Equation& equ_u, Equation& equ_v, Equation& equ_p,
+                    double mu, FasFields& r, MPI_Comm comm);
+
+/**
+ * @class FasMultigrid
+ * @brief 以 SIMPLE 迭代为光滑器的 FAS（全近似格式）非线性多重网格
+ *
+ * @details
+ * 粗网格由 coarsenMesh 逐级得到，每级用一个 SolverSession 在 comm 上求解。
+ * 粗网格按细网格的列范围对齐分割（子单元组起点落在细网格真实列 [c0, c1) 的粗列归本进程），
+ * 因此限制 / 插值只需本进程与 ghost 列的数据，层间不做全局收集。
+ * coarsenMesh 保持边界层不变，各级网格求解同一区域上的同一问题。
+ *
+ * cycle() 对细网格当前状态做一次 V 循环的粗网格修正（细网格光滑由调用方完成）：
+ * 1. 细网格残差 r_f = r(x_f)；状态 x_c⁰ = R·x_f：单元量取体积平均，面速度取
+ *    子面的通量平均（质量守恒，粗网格质量不平衡等于子单元之和）；
+ * 2. 强迫项 τ = R·r_f − r_c(x_c⁰)（单元残差求和、面残差通量平均），
+ *    粗网格求解 r_c(x_c) + τ = 0：pre_sweeps 次 SIMPLE → 递归 → post_sweeps 次 SIMPLE；
+ * 3. x_f += ω·P·(x_c − x_c⁰)，x = (u*, v*, p)（双线性插值，面速度取相邻单元速度修正量的平均）。
+ * 粗网格级（最粗一级除外）的压力修正方程可改用 Chebyshev 光滑（SessionConfig::p_cheb_sweeps），
+ * 低频压力误差由更粗一级修正，最粗一级仍以 PCG 求解。
+ * 面速度作为独立未知量参与限制与强迫；粗网格动量方程改解修正量，细网格收敛时 x_c⁰
+ * 恰为粗网格的不动点，修正量为零。粗网格残差增长一个量级以上或出现非有限值时舍弃本次修正。
+ */
+class FasMultigrid {
+public:
+    int pre_sweeps  = 2;   ///< 每级限制后的 SIMPLE 迭代次数
+    int post_sweeps = 2;   ///< 每级插值前的 SIMPLE 迭代次数
+    double damping  = 1.0; ///< 插值修正量（速度与压力）的阻尼 ω
+
+    long cycles   = 0;     ///< 已执行的 V 循环数
+    long sweeps   = 0;     ///< 所有粗网格级别上的 SIMPLE 迭代总数
+    long rejected = 0;     ///< 因粗网格残差增长一个量级以上或出现非有限值而被舍弃的修正次数
+
+    /**
+     * @brief 建立粗网格层级
+     * @param global  未分割的全局网格（各进程均持有）
+     * @param fine    本进程细网格子网格（引用须在对象生命周期内有效）
+     * @param levels  最多粗化级数（粗网格过小时提前停止，规则同 sequenceInitialGuess）
+     * @param cfg     粗网格求解参数（mu 与松弛因子须与细网格一致）
+     * @param comm    细网格分割所用的通信域（各级粗网格沿用）
+     */
+    FasMultigrid(const Mesh& global, Mesh& fine, int levels, const SessionConfig& cfg,
+                 MPI_Comm comm);
+
+    /** @brief 实际建立的粗网格级数 */
+    int levels() const { return static_cast<int>(coarse_.size()); }
+
+    /**
+     * @brief 对细网格当前状态做一次粗网格修正（修正 u*、v*、p 与面速度）
+     * @return 修正前细网格五组非线性残差的全局 L2 范数中的最大者
+     */
+    double cycle();
+
+private:
+    struct Level {
+        MatrixXi bc;                            ///< 本进程各列（含 ghost）的原始边界类型
+        std::unique_ptr<SolverSession> session;
+    };
+
+    /** @brief 以第 l 级（0 为细网格）为细网格做粗网格修正 */
+    bool correct(int l, const FasFields& r);
+
+    Mesh&              fine_;
+    MatrixXi           fine_bc_;
+    Equation           equ_u_, equ_v_, equ_p_;   ///< 细网格残差计算用
+    SessionConfig      cfg_;
+    std::vector<Level> coarse_;                  ///< coarse_[k] 为第 k+1 级
+    MPI_Comm           comm_;
+};
+
+#endif // SESSION_H
@@ -2,6 +2,8 @@
 #include <filesystem>
 #include <chrono>
 #include "parallel.h"
+#include "session.h"
+#include <functional>
 #include <eigen3/Eigen/QR>
 #include <eigen3/Eigen/Dense>
 
@@ -14,9 +16,10 @@ int main(int argc, char* argv[])
     // 初始化MPI环境
     MPI_Init(&argc, &argv);
     
+    MPI_Comm comm = MPI_COMM_WORLD;   // 求解器通信域（显式传入所有通信函数）
     int rank, num_procs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
     
     // -------------------- 参数设置 --------------------
     std::string mesh_folder;
@@ -24,11 +27,76 @@ int main(int argc, char* argv[])
     int timesteps, n_splits;
     MPI_Comm_size(MPI_COMM_WORLD, &n_splits);  // 获取 MPI 总进程数    
     parseInputParameters(argc, argv, mesh_folder, timesteps, mu, n_splits);   
+    RunOptions opts(argc, argv, 4);
+    if (rank == 0) opts.print();
+
+    const bool fixed_iters   = opts.getBool("fixed-iters", false);  // 固定迭代次数（扩展性测试）
+    const bool write_output  = !opts.getBool("no-output", false);
+    const int  save_interval = opts.getInt("save-interval", 5);
+    const int  verbose       = opts.getBool("quiet", false) ? 0 : 1;
+
+    // 线性求解器：double PCG 或混合精度迭代精化（--precision=mixed）
+    const bool mixed_precision = (opts.getString("precision", "double") == "mixed");
+    auto solveField = mixed_precision ? solveFieldPCGMixed : solveFieldPCG;
+
+    // 压力修正方程的 Krylov 子空间回收（--recycle=K，0 为关闭）
+    DeflationSpace deflation;
+    deflation.k = opts.getInt("recycle", 0);
+    deflation.m = opts.getInt("recycle-dirs", 16);
+
+    // 压力修正方程的预条件：jacobi（默认）或 Chebyshev 多项式（--precond=chebyshev）
+    const bool use_cheb = (opts.getString("precond", "jacobi") == "chebyshev");
+    ChebyshevPrecond cheb;
+    cheb.degree        = opts.getInt("cheb-degree", 4);
+    cheb.lanczos_steps = opts.getInt("cheb-lanczos", 10);
+    cheb.refresh       = opts.getInt("cheb-refresh", 20);
+
+    // s-step PCG（--sstep=S，0 为关闭），按方程选择（--sstep-eqs，默认仅压力方程）
+    SStepConfig sstep;
+    sstep.s               = opts.getInt("sstep", 0);
+    sstep.chebyshev_basis = (opts.getString("sstep-basis", "chebyshev") != "monomial");
+    const std::string sstep_eqs = opts.getString("sstep-eqs", "p");
+    using FieldSolver = std::function<void(Equation&, Mesh&, MatrixXd&, double, int,
+                                           int, int, MPI_Comm, double&, int)>;
+    auto pickSolver = [&](char eq) -> FieldSolver {
+        if (sstep.s > 0 && sstep_eqs.find(eq) != std::string::npos)
+            return [&sstep](Equation& e, Mesh& m, MatrixXd& f, double tol, int max_it,
+                            int rk, int np, MPI_Comm cm, double& l2, int vb) {
+                solveFieldPCGSStep(e, m, f, tol, max_it, rk, np, cm, l2, sstep, vb);
+            };
+        return solveField;
+    };
+    const FieldSolver solveU = pickSolver('u');
+    const FieldSolver solveV = pickSolver('v');
+    const FieldSolver solveP = pickSolver('p');
+    // u、v 动量方程同步求解（--uv-solve=fused）：两方程共享接口交换与 Allreduce；
+    // 混合精度或 s-step 作用于 u/v 时回退为依次求解
+    const bool uv_fused_req = (opts.getString("uv-solve", "sequential") == "fused");
+    const bool uv_fused     = uv_fused_req && !mixed_precision
+                              && !(sstep.s > 0 && sstep_eqs.find_first_of("uv") != std::string::npos);
+    if (rank == 0 && uv_fused_req && !uv_fused)
+        std::cout << "提示: --uv-solve=fused 不支持混合精度或 u/v 的 s-step，改为依次求解" << std::endl;
+
+    // 场布局（--layout=rect|compact）：compact 时场数组只存活动单元及其边界环（见 Mesh::useCompactLayout）；
+    // 检查点、网格序列与 FAS 按矩形场读写子网格，不能与之同时使用
+    const bool compact_layout = (opts.getString("layout", "rect") == "compact");
+    if (compact_layout) {
+        for (const char* key : { "checkpoint", "restart", "sequencing", "fas" }) {
+            if (!opts.has(key)) continue;
+            if (rank == 0) std::cerr << "--" << key << " 不能与 --layout=compact 同时使用" << std::endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
     
     // -------------------- 网格分割 --------------------
-    Mesh original_mesh(mesh_folder);
+    Mesh original_mesh = loadMesh(mesh_folder);
     
-    std::vector<Mesh> sub_meshes = splitMeshVertically(original_mesh, n_splits);
+    // 内部点编号策略（--ordering=row|col|rcm|tiled），由各子网格继承
+    original_mesh.ordering   = parseCellOrdering(opts.getString("ordering", "row"));
+    original_mesh.order_tile = opts.getInt("order-tile", 16);
+
+    // --partition=weighted 时按流体单元数（或实测代价）均衡各进程负载
+    std::vector<Mesh> sub_meshes = partitionMesh(original_mesh, n_splits, opts, rank == 0);
     if (rank == 0) {
         printSimulationSetup(sub_meshes, n_splits);
     }
@@ -49,6 +117,57 @@ int main(int argc, char* argv[])
     mesh.p.setZero();
     mesh.p_prime.setZero();
     mesh.p_star.setZero();
+    if (compact_layout) {
+        const long rect_cells = static_cast<long>(mesh.nx) * mesh.ny;
+        mesh.useCompactLayout();
+        sub_meshes.clear();
+        long cells[2] = { mesh.nstored, rect_cells };
+        long total[2] = { 0, 0 };
+        MPI_Reduce(cells, total, 2, MPI_LONG, MPI_SUM, 0, comm);
+        if (rank == 0) {
+            std::cout << "紧凑场布局: 每个场存储 " << total[0] << " 个单元 (矩形布局 "
+                      << total[1] << " 个, " << (1000 * total[0] / total[1]) / 10.0
+                      << "%)" << std::endl;
+        }
+    }
+
+    // -------------------- 检查点 / 重启 --------------------
+    // --restart=FILE 从检查点继续（进程数可与写出时不同）；
+    // --checkpoint=FILE 每 checkpoint-interval 步及收到 SIGUSR1 / SIGTERM 时写出
+    const std::string ckpt_file    = opts.getString("checkpoint", "");
+    const std::string restart_file = opts.getString("restart", "");
+    const int ckpt_interval = opts.getInt("checkpoint-interval", 0);
+    int first_iter = 1;
+    if (!restart_file.empty()) {
+        int step;
+        double time;
+        readCheckpoint(restart_file, mesh, original_mesh.nx, step, time, comm);
+        first_iter = step + 1;
+        if (rank == 0) {
+            std::cout << "从检查点 " << restart_file << " 重启：已完成 " << step << " 步" << std::endl;
+        }
+    }
+    if (!ckpt_file.empty()) installCheckpointSignals();
+
+    // -------------------- 网格序列 --------------------
+    // --sequencing=L：在 L 级 2 倍粗化网格上由粗到细宽松求解，插值得到初始场
+    const int seq_levels = opts.getInt("sequencing", 0);
+    if (seq_levels > 0 && restart_file.empty()) {
+        SessionConfig seq_cfg;
+        seq_cfg.mu              = mu;
+        seq_cfg.mixed_precision = mixed_precision;
+        auto seq_start = std::chrono::steady_clock::now();
+        const int seq_iters = sequenceInitialGuess(original_mesh, mesh, seq_levels,
+                                                   opts.getInt("seq-iters", 200),
+                                                   opts.getDouble("seq-rtol", 1e-2),
+                                                   seq_cfg, comm, verbose);
+        if (rank == 0) {
+            std::cout << "网格序列完成: 粗网格共 " << seq_iters << " 次 SIMPLE 迭代, 耗时 "
+                      << std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                       - seq_start).count()
+                      << " 秒" << std::endl;
+        }
+    }
    
     // -------------------- 建立方程系统 --------------------
     Equation equ_u(mesh);
@@ -64,10 +183,75 @@ int main(int argc, char* argv[])
     const int max_iter_p = 200;   // 压力最大迭代次数
     const double stagnation_tol = 1e-3;   // 0.1% 停滞阈值
 
-    double l2_norm_x, l2_norm_y, l2_norm_p;
+    // 非精确 SIMPLE（--inexact）：各方程的线性求解精度由外层残差决定（Eisenstat–Walker）
+    InexactTolerance ew_u, ew_v, ew_p;
+    for (InexactTolerance* ew : {&ew_u, &ew_v, &ew_p}) {
+        ew->enabled = opts.getBool("inexact", false);
+        ew->gamma   = opts.getDouble("ew-gamma", 0.9);
+        ew->alpha   = opts.getDouble("ew-alpha", 2.0);
+        ew->eta_max = opts.getDouble("ew-eta-max", 0.1);
+        ew->tol_min = opts.getDouble("ew-tol-min", 1e-10);
+    }
+    ew_u.tol_fixed = ew_v.tol_fixed = tol_uv;
+    ew_p.tol_fixed = tol_p;
+
+    // Anderson 加速（--anderson=M，0 为关闭）：对每次 SIMPLE 扫描后的 (u*, v*, p, 面速度) 做混合
+    AndersonMixer anderson;
+    anderson.depth = opts.getInt("anderson", 0);
+    anderson.beta  = opts.getDouble("anderson-beta", 1.0);
+    anderson.start = opts.getInt("anderson-start", 1);
+    anderson.build(mesh);
+    // 混合要求每次扫描是同一个确定映射 G：压力修正方程改为固定步数的 Chebyshev-PCG
+    // （停滞退出与谱区间刷新会让 G 随迭代跳变）
+    cheb.fixed = (anderson.depth > 0);
+    const int anderson_p_iters = opts.getInt("anderson-p-iters", 20);
+    // 外迭代收敛判据（--outer-tol）：‖G(x) − x‖ 相对首次扫描下降到该值时停止
+    const double outer_tol   = opts.getDouble("outer-tol", 0.0);
+    const bool   track_outer = (anderson.depth > 0 || outer_tol > 0.0);
+    double outer_res0 = -1.0;
+
+    // FAS 非线性多重网格（--fas=L，0 为关闭）：每次 SIMPLE 扫描后做一次粗网格修正
+    std::unique_ptr<FasMultigrid> fas;
+    const double fas_tol = opts.getDouble("fas-tol", 0.0);
+    // 动量方程改解修正量后线性残差不再反映外层收敛，--fas-tol 取代停滞与残差判据
+    const bool   fas_stop = opts.getInt("fas", 0) > 0 && fas_tol > 0.0;
+    double fas_res0 = -1.0;
+    if (opts.getInt("fas", 0) > 0) {
+        SessionConfig fas_cfg;
+        fas_cfg.mu              = mu;
+        fas_cfg.alpha_p         = alpha_p;
+        fas_cfg.alpha_uv        = alpha_uv;
+        fas_cfg.mixed_precision = mixed_precision;
+        fas_cfg.p_cheb_sweeps   = opts.getInt("fas-cheb", 0);
+        fas_cfg.p_cheb_degree   = cheb.degree;
+        fas = std::make_unique<FasMultigrid>(original_mesh, mesh, opts.getInt("fas", 0), fas_cfg, comm);
+        fas->pre_sweeps = fas->post_sweeps = opts.getInt("fas-sweeps", 2);
+        fas->damping    = opts.getDouble("fas-damping", 1.0);
+        // 细网格动量方程同样改解修正量，使扫描的不动点与非线性残差为零一致
+        for (InexactTolerance* ew : {&ew_u, &ew_v}) {
+            if (ew->enabled) continue;
+            ew->enabled = true;
+            ew->eta_max = ew->tol_min = tol_uv;
+        }
+        if (rank == 0) {
+            std::cout << "FAS 多重网格: " << fas->levels() << " 级粗网格, 每级光滑 "
+                      << fas->pre_sweeps << " + " << fas->post_sweeps << " 次";
+            if (fas_cfg.p_cheb_sweeps > 0)
+                std::cout << ", 压力修正方程 Chebyshev 光滑 " << fas_cfg.p_cheb_sweeps << " 次";
+            std::cout << std::endl;
+        }
+    }
+
+    double l2_norm_x = 0.0, l2_norm_y = 0.0, l2_norm_p = 0.0;
     double prev_l2_u = -1.0;
     double prev_l2_v = -1.0;
     double prev_l2_p = -1.0;
+    int iters_done = 0;
+    total_comm_time = 0.0;
+    // 按内核的硬件计数器（--counters）：IPC、带宽、算术强度
+    kernel_profiler.init(opts.getBool("counters", false), rank);
+    const double n_cells = static_cast<double>(mesh.nx) * mesh.ny;
+    const double n_int   = mesh.internumber;
     auto start_time = std::chrono::steady_clock::now();
     
     if (rank == 0) {
@@ -75,54 +259,119 @@ int main(int argc, char* argv[])
     }
     
     // ==================== SIMPLE算法主循环 ====================
-    for (int n = 1; n <= timesteps; n++) {
+    for (int n = first_iter; n <= timesteps; n++) {
+        iters_done = n;
+        if (track_outer) anderson.capture(mesh);
         
         // -------------------- 步骤1: 求解动量方程 --------------------
         // 离散动量方程
+        kernel_profiler.start(KERNEL_MOMENTUM);
         momentum_function(mesh, equ_u, equ_v, mu, alpha_uv);
+        kernel_profiler.stop(KERNEL_MOMENTUM, n_cells);
+        const double tol_u_k = ew_u.begin(equ_u, mesh, &mesh.u_star, rank, num_procs, comm);
+        const double tol_v_k = ew_v.begin(equ_v, mesh, &mesh.v_star, rank, num_procs, comm);
 
         //解速度场
-        solveFieldPCG(equ_u, mesh, mesh.u,
-             tol_uv, max_iter_uv,
-             rank, num_procs,
-             l2_norm_x,1);
-
-        solveFieldPCG(equ_v, mesh, mesh.v,
-             tol_uv, max_iter_uv,
-             rank, num_procs,
-             l2_norm_y, 1);
+        if (uv_fused) {
+            // 同步求解的耗时全部计入 u 内核
+            kernel_profiler.start(KERNEL_SOLVE_U);
+            solveFieldPCGPair(equ_u, equ_v, mesh.u, mesh.v,
+                 tol_u_k, tol_v_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_x, l2_norm_y, verbose);
+            kernel_profiler.stop(KERNEL_SOLVE_U, 2 * n_int * solver_stats.iterations);
+            ew_u.end(equ_u, mesh, &mesh.u, rank, num_procs, comm);
+            ew_v.end(equ_v, mesh, &mesh.v, rank, num_procs, comm);
+        } else {
+            kernel_profiler.start(KERNEL_SOLVE_U);
+            solveU(equ_u, mesh, mesh.u,
+                 tol_u_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_x, verbose);
+            kernel_profiler.stop(KERNEL_SOLVE_U, n_int * solver_stats.iterations);
+            ew_u.end(equ_u, mesh, &mesh.u, rank, num_procs, comm);
+
+            kernel_profiler.start(KERNEL_SOLVE_V);
+            solveV(equ_v, mesh, mesh.v,
+                 tol_v_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_y, verbose);
+            kernel_profiler.stop(KERNEL_SOLVE_V, n_int * solver_stats.iterations);
+            ew_v.end(equ_v, mesh, &mesh.v, rank, num_procs, comm);
+        }
         //交换Ap 用于动量插值
-        exchangeColumns(equ_u.A_p, rank, num_procs);
+        exchangeColumns(equ_u.A_p, mesh, rank, num_procs, comm);
         
 
         
         // -------------------- 步骤2: 速度插值到面 --------------------
+        kernel_profiler.start(KERNEL_FACE_VELOCITY);
         face_velocity(mesh, equ_u);
+        kernel_profiler.stop(KERNEL_FACE_VELOCITY, n_cells);
 
         
         // -------------------- 步骤3: 求解压力修正方程 --------------------
         
+        kernel_profiler.start(KERNEL_PRESSURE);
         pressure_function(mesh, equ_p, equ_u);
+        kernel_profiler.stop(KERNEL_PRESSURE, n_cells);
+        const double tol_p_k = ew_p.begin(equ_p, mesh, nullptr, rank, num_procs, comm);
         
         
-        solveFieldPCG(equ_p, mesh, mesh.p_prime,
-             tol_p, max_iter_p,
-             rank, num_procs,
-             l2_norm_p, 1);
+        kernel_profiler.start(KERNEL_SOLVE_P);
+        if (cheb.fixed) {
+            solveFieldPCGCheb(equ_p, mesh, mesh.p_prime,
+                 0.0, anderson_p_iters,
+                 rank, num_procs, comm,
+                 l2_norm_p, cheb, verbose);
+        } else if (deflation.k > 0) {
+            solveFieldPCGDeflated(equ_p, mesh, mesh.p_prime,
+                 tol_p_k, max_iter_p,
+                 rank, num_procs, comm,
+                 l2_norm_p, deflation, verbose);
+        } else if (use_cheb) {
+            solveFieldPCGCheb(equ_p, mesh, mesh.p_prime,
+                 tol_p_k, max_iter_p,
+                 rank, num_procs, comm,
+                 l2_norm_p, cheb, verbose);
+        } else {
+            solveP(equ_p, mesh, mesh.p_prime,
+                 tol_p_k, max_iter_p,
+                 rank, num_procs, comm,
+                 l2_norm_p, verbose);
+        }
+        kernel_profiler.stop(KERNEL_SOLVE_P, n_int * solver_stats.iterations);
+        ew_p.end(equ_p, mesh, nullptr, rank, num_procs, comm);
 
         
         // -------------------- 步骤4: 修正压力和速度 --------------------
+        kernel_profiler.start(KERNEL_CORRECT);
         correct_pressure(mesh, alpha_p);
         correct_velocity(mesh, equ_u);
+        kernel_profiler.stop(KERNEL_CORRECT, n_cells);
         
         // 更新压力场,并交换
         mesh.p = mesh.p_star;
-        exchangeColumns(mesh.p, rank, num_procs);
+        exchangeColumns(mesh.p, mesh, rank, num_procs, comm);
+
+        // FAS 粗网格修正（给出修正前的非线性残差）
+        double fas_res = 0.0;
+        if (fas) {
+            fas_res = fas->cycle();
+            if (fas_res0 < 0.0) fas_res0 = fas_res;
+        }
+
+        // Anderson 混合（同时给出不动点残差 ‖G(x) − x‖）
+        double outer_res = 0.0;
+        if (track_outer) {
+            outer_res = anderson.mix(mesh, rank, num_procs, comm);
+            if (outer_res0 < 0.0) outer_res0 = outer_res;
+        }
 
         // -------------------- 步骤5: 收敛性检查 --------------------
  
         // 仅rank 0打印残差信息
-        if (rank == 0) {
+        if (rank == 0 && verbose) {
             std::cout << std::scientific 
                       << "迭代 " << std::setw(4) << n 
                       << " | 全局残差 → "
@@ -130,11 +379,31 @@ int main(int argc, char* argv[])
                       << " v: " << std::setprecision(4) << l2_norm_y
                       << " p: " << std::setprecision(4) << l2_norm_p
                       << std::endl;
+            if (track_outer)
+                std::cout << "  [外迭代] ‖G(x) − x‖ = " << outer_res
+                          << " (相对 " << outer_res / outer_res0 << ")" << std::endl;
+            if (fas)
+                std::cout << "  [FAS] 非线性残差 = " << fas_res
+                          << " (相对 " << fas_res / fas_res0 << ")" << std::endl;
+        }
+        if (fas && fas_tol > 0.0 && fas_res <= fas_tol * fas_res0) {
+            if (rank == 0) {
+                std::cout << "\n✓ 非线性残差下降至 " << fas_tol
+                          << " (迭代次数: " << n << ")" << std::endl;
+            }
+            break;
+        }
+        if (outer_tol > 0.0 && outer_res <= outer_tol * outer_res0) {
+            if (rank == 0) {
+                std::cout << "\n✓ 外迭代残差下降至 " << outer_tol
+                          << " (迭代次数: " << n << ")" << std::endl;
+            }
+            break;
         }
             // ==================== 循环步内停滞判断 ====================
             int local_stagnated = 0;
 
-            if (n > 1) {
+            if (n > 1 && !fixed_iters && !fas_stop) {
             double du = std::abs(l2_norm_x - prev_l2_u) / (prev_l2_u + 1e-20);
             double dv = std::abs(l2_norm_y - prev_l2_v) / (prev_l2_v + 1e-20);
             double dp = std::abs(l2_norm_p - prev_l2_p) / (prev_l2_p + 1e-20);
@@ -154,7 +423,7 @@ int main(int argc, char* argv[])
             // 全局同步判断
             int global_stagnated = 0;
             MPI_Allreduce(&local_stagnated, &global_stagnated,
-              1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+              1, MPI_INT, MPI_MAX, comm);
 
             if (global_stagnated) {
                 if (rank == 0) {
@@ -165,9 +434,9 @@ int main(int argc, char* argv[])
             break;
             }        
         // 检查全局收敛
-        int local_converged = checkConvergence(l2_norm_x, l2_norm_y, l2_norm_p);
+        int local_converged = !fixed_iters && !fas_stop && checkConvergence(l2_norm_x, l2_norm_y, l2_norm_p);
         int global_converged;
-        MPI_Allreduce(&local_converged, &global_converged, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        MPI_Allreduce(&local_converged, &global_converged, 1, MPI_INT, MPI_MIN, comm);
         
         if (global_converged) {
             if (rank == 0) {
@@ -177,19 +446,81 @@ int main(int argc, char* argv[])
         }
         
         // -------------------- 步骤6: 数据保存 --------------------
-        if (n % 5 == 0) {
+        if (write_output && save_interval > 0 && n % save_interval == 0) {
             saveMeshData(mesh, rank,"result");
         }
+
+        // -------------------- 步骤7: 检查点 --------------------
+        if (!ckpt_file.empty()) {
+            const int sig = pollCheckpointSignal(comm);
+            if (sig > 0 || (ckpt_interval > 0 && n % ckpt_interval == 0)) {
+                writeCheckpoint(ckpt_file, mesh, original_mesh.nx, n, 0.0, comm);
+                if (rank == 0) {
+                    std::cout << "  检查点已写出: " << ckpt_file << " (迭代 " << n << ")" << std::endl;
+                }
+            }
+            if (sig == 2) {
+                if (rank == 0) std::cout << "\n收到 SIGTERM，保存检查点后停止" << std::endl;
+                break;
+            }
+        }
     }
     
-    // ==================== 计算完成 ====================
-    saveMeshData(mesh, rank,"result");
-    
     auto total_elapsed_time = std::chrono::duration<double>(
         std::chrono::steady_clock::now() - start_time).count();
+
+    if (opts.getBool("perf", false)) {
+        reportPerfSummary("steady", total_elapsed_time, iters_done,
+                          static_cast<long>(original_mesh.nx) * original_mesh.ny,
+                          rank, num_procs, comm, l2_norm_x, l2_norm_y, l2_norm_p);
+    }
+    kernel_profiler.report(rank, num_procs, comm);
+
+    // ==================== 计算完成 ====================
+    if (write_output) {
+        saveMeshData(mesh, rank,"result");
+    }
     
     if (rank == 0) {
         std::cout << "\n==================== 计算完成 ====================" << std::endl;
+        if (deflation.k > 0 && deflation.solves > 0) {
+            std::cout << "压力方程子空间回收: k = " << deflation.k
+                      << ", 平均每次求解 " << double(deflation.iterations) / deflation.solves
+                      << " 次迭代, 额外 SpMV(S·W) " << deflation.extra_spmv << " 次" << std::endl;
+        }
+        if (use_cheb && cheb.solves > 0) {
+            std::cout << "压力方程 Chebyshev 预条件: 阶数 " << cheb.degree
+                      << ", 谱区间 [" << cheb.lmin << ", " << cheb.lmax << "]"
+                      << ", 平均每次求解 " << double(cheb.iterations) / cheb.solves
+                      << " 次外层迭代, 谱估计 " << cheb.estimates << " 次" << std::endl;
+        }
+        if (sstep.s > 0 && sstep.solves > 0) {
+            std::cout << "s-step PCG (s = " << sstep.s << ", 方程 " << sstep_eqs << "): "
+                      << sstep.iterations << " 次等效迭代, " << sstep.rounds
+                      << " 次 Gram 归约" << std::endl;
+        }
+        if (anderson.depth > 0) {
+            std::cout << "Anderson 加速: 深度 " << anderson.depth << ", β = " << anderson.beta
+                      << ", 混合 " << anderson.mixes << " 次, 重启 " << anderson.restarts
+                      << " 次 (压力修正每次固定 " << anderson_p_iters << " 步 Chebyshev-PCG)"
+                      << std::endl;
+        }
+        if (fas) {
+            std::cout << "FAS 多重网格: " << fas->levels() << " 级, V 循环 " << fas->cycles
+                      << " 次, 粗网格 SIMPLE 迭代 " << fas->sweeps << " 次, 舍弃修正 "
+                      << fas->rejected << " 次" << std::endl;
+        }
+        std::cout << "线性求解 Krylov 迭代: u " << ew_u.iterations << ", v " << ew_v.iterations
+                  << ", p " << ew_p.iterations
+                  << (ew_p.enabled ? " (非精确 SIMPLE)" : " (固定精度)") << std::endl;
+        if (reduction_overlap.reductions > 0) {
+            std::cout << "PCG 非阻塞归约: " << reduction_overlap.reductions << " 次, 重叠窗口 "
+                      << reduction_overlap.window << " 秒, 等待 " << reduction_overlap.wait
+                      << " 秒, 等待前已完成 " << 100.0 * reduction_overlap.completed
+                                                  / reduction_overlap.reductions
+                      << "%, 延迟隐藏比例 ≤ " << 100.0 * reduction_overlap.hiddenFraction()
+                      << "%" << std::endl;
+        }
         std::cout << "总耗时: " << total_elapsed_time << " 秒" << std::endl;
         std::cout << "===================================================\n" << std::endl;
     }
@@ -2,20 +2,197 @@
 #include <filesystem>
 #include <chrono>
 #include "parallel.h"
+#include <functional>
+#include <memory>
 #include <eigen3/Eigen/QR>
 #include <eigen3/Eigen/Dense>
 
 namespace fs = std::filesystem;
 
+// ==================== 批量模式 ====================
+
+/// 批量模式中一个算例的网格、方程与 SIMPLE 状态
+struct BatchCase {
+    Mesh     mesh;
+    Equation equ_u, equ_v, equ_p;
+    double   mu, dt;
+    double   prev_u = -1.0, prev_v = -1.0, prev_p = -1.0;
+
+    BatchCase(const Mesh& m, double mu_, double dt_)
+        : mesh(m), equ_u(mesh), equ_v(mesh), equ_p(mesh), mu(mu_), dt(dt_)
+    {
+        // 批量求解直接读取五点系数，跳过稀疏矩阵组装
+        equ_u.assemble_sparse = equ_v.assemble_sparse = equ_p.assemble_sparse = false;
+    }
+};
+
+/**
+ * @brief 批量模式（--batch=FILE）：本进程组同时推进全部算例
+ *
+ * 离散与修正按算例逐个进行；三个线性求解把仍在迭代的算例压紧后交给
+ * solveFieldPCGBatched，每 BATCH_W 个算例占满一组 SIMD 通道。
+ * 时间步内已收敛 / 停滞的算例移出活动列表，PCG 内提前收敛的算例按通道屏蔽。
+ */
+static void runBatch(const std::vector<EnsembleCase>& cases, const Mesh& original_mesh,
+                     const RunOptions& opts, int n_splits, int timesteps,
+                     int rank, int num_procs, MPI_Comm comm,
+                     double alpha_p, double tol_uv, double tol_p,
+                     int max_iter_uv, int max_iter_p, int max_simple_iter,
+                     double stagnation_tol, bool fixed_iters, bool write_output,
+                     int save_interval, int verbose)
+{
+    // 各算例先在完整网格上覆盖区域速度，再按相同方式分割
+    std::vector<std::unique_ptr<BatchCase>> batch;
+    for (const EnsembleCase& c : cases) {
+        Mesh full = original_mesh;
+        for (size_t z = 0; z < c.zones.size(); ++z) full.setZoneUV(c.zones[z], c.zone_u[z], c.zone_v[z]);
+        if (!c.zones.empty()) full.initializeBoundaryConditions();
+        Mesh sub = partitionMesh(full, n_splits, opts, false)[rank];
+        sub.u0.setZero();      sub.v0.setZero();
+        sub.u_star.setZero();  sub.v_star.setZero();
+        sub.u_face.setZero();  sub.v_face.setZero();
+        sub.u.setZero();       sub.v.setZero();
+        sub.p.setZero();       sub.p_prime.setZero();  sub.p_star.setZero();
+        batch.push_back(std::make_unique<BatchCase>(sub, c.mu, c.dt));
+    }
+    const int n_cases = static_cast<int>(batch.size());
+
+    BatchStats stats;
+    long case_iters = 0;
+    std::vector<Equation*> equs;
+    std::vector<MatrixXd*> fields;
+    std::vector<double> l2_u, l2_v, l2_p;
+    total_comm_time = 0.0;
+    auto start_time = std::chrono::steady_clock::now();
+
+    if (rank == 0) {
+        std::cout << "\n==================== 开始批量非定常计算 ====================" << std::endl;
+        std::cout << "批量模式: " << n_cases << " 个算例, SIMD 宽度 " << BATCH_W
+                  << " (" << (n_cases + BATCH_W - 1) / BATCH_W << " 个 AoSoA 块)" << std::endl;
+    }
+
+    for (int time_step = 0; time_step <= timesteps; ++time_step) {
+        MPI_Barrier(comm);
+
+        std::vector<BatchCase*> running;
+        for (auto& c : batch) {
+            c->prev_u = c->prev_v = c->prev_p = -1.0;
+            running.push_back(c.get());
+        }
+
+        for (int n = 1; n <= max_simple_iter && !running.empty(); n++) {
+            const int na = static_cast<int>(running.size());
+            case_iters += na;
+
+            // -------------------- 动量方程 --------------------
+            for (BatchCase* c : running)
+                momentum_function_unsteady(c->mesh, c->equ_u, c->equ_v, c->mu, c->dt);
+
+            equs.clear();  fields.clear();
+            for (BatchCase* c : running) { equs.push_back(&c->equ_u); fields.push_back(&c->mesh.u); }
+            solveFieldPCGBatched(equs, fields, tol_uv, max_iter_uv, rank, num_procs, comm, l2_u, stats, verbose);
+
+            equs.clear();  fields.clear();
+            for (BatchCase* c : running) { equs.push_back(&c->equ_v); fields.push_back(&c->mesh.v); }
+            solveFieldPCGBatched(equs, fields, tol_uv, max_iter_uv, rank, num_procs, comm, l2_v, stats, verbose);
+
+            // -------------------- 面速度与压力修正方程 --------------------
+            equs.clear();  fields.clear();
+            for (BatchCase* c : running) {
+                exchangeColumns(c->equ_u.A_p, rank, num_procs, comm);
+                face_velocity(c->mesh, c->equ_u);
+                pressure_function(c->mesh, c->equ_p, c->equ_u);
+                equs.push_back(&c->equ_p);
+                fields.push_back(&c->mesh.p_prime);
+            }
+            solveFieldPCGBatched(equs, fields, tol_p, max_iter_p, rank, num_procs, comm, l2_p, stats, verbose);
+
+            // -------------------- 修正压力和速度 --------------------
+            for (BatchCase* c : running) {
+                correct_pressure(c->mesh, alpha_p);
+                correct_velocity(c->mesh, c->equ_u);
+                c->mesh.p = c->mesh.p_star;
+                exchangeColumns(c->mesh.p, rank, num_procs, comm);
+            }
+
+            // -------------------- 逐算例停滞 / 收敛判断 --------------------
+            std::vector<int> local_stop(na, 0), global_stop(na, 0);
+            for (int a = 0; a < na; ++a) {
+                BatchCase* c = running[a];
+                if (!fixed_iters) {
+                    if (n > 1) {
+                        double du = std::abs(l2_u[a] - c->prev_u) / (c->prev_u + 1e-20);
+                        double dv = std::abs(l2_v[a] - c->prev_v) / (c->prev_v + 1e-20);
+                        double dp = std::abs(l2_p[a] - c->prev_p) / (c->prev_p + 1e-20);
+                        if (std::max({du, dv, dp}) < stagnation_tol) local_stop[a] = 1;
+                    }
+                    if (checkConvergence(l2_u[a], l2_v[a], l2_p[a])) local_stop[a] = 1;
+                }
+                c->prev_u = l2_u[a];
+                c->prev_v = l2_v[a];
+                c->prev_p = l2_p[a];
+            }
+            MPI_Allreduce(local_stop.data(), global_stop.data(), na, MPI_INT, MPI_MAX, comm);
+
+            std::vector<BatchCase*> still;
+            for (int a = 0; a < na; ++a)
+                if (!global_stop[a]) still.push_back(running[a]);
+            running.swap(still);
+
+            if (rank == 0 && verbose) {
+                std::cout << "  时间步 " << time_step << " 迭代 " << std::setw(3) << n
+                          << " | 仍在迭代的算例 " << running.size() << " / " << n_cases << std::endl;
+            }
+        }
+
+        // -------------------- 时间推进 --------------------
+        const bool save_now = write_output && save_interval > 0 && time_step % save_interval == 0;
+        for (int c = 0; c < n_cases; ++c) {
+            Mesh& m = batch[c]->mesh;
+            if (save_now) saveMeshData(m, rank, ensembleCaseFolder(c, batch[c]->mu));
+            m.u0 = m.u_star;
+            m.v0 = m.v_star;
+        }
+    }
+    if (write_output) {
+        for (int c = 0; c < n_cases; ++c)
+            saveMeshData(batch[c]->mesh, rank, ensembleCaseFolder(c, batch[c]->mu));
+    }
+
+    auto total_elapsed_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time).count();
+
+    if (opts.getBool("perf", false)) {
+        reportPerfSummary("unsteady-batch", total_elapsed_time, static_cast<int>(case_iters),
+                          static_cast<long>(original_mesh.nx) * original_mesh.ny,
+                          rank, num_procs, comm);
+    }
+
+    if (rank == 0) {
+        std::cout << "\n==================== 批量计算完成 ====================" << std::endl;
+        std::cout << "算例数: " << n_cases << ", 算例 SIMPLE 迭代合计: " << case_iters << std::endl;
+        std::cout << "批量 PCG: " << stats.solves << " 次块求解, 算例迭代合计 " << stats.lane_iterations
+                  << ", SIMD 通道利用率 "
+                  << std::fixed << std::setprecision(1)
+                  << 100.0 * stats.lane_iterations / std::max(1L, stats.block_iterations * BATCH_W)
+                  << "%" << std::endl;
+        std::cout << "总耗时: " << std::setprecision(3) << total_elapsed_time << " 秒, 平均每算例 "
+                  << total_elapsed_time / n_cases << " 秒" << std::endl;
+        std::cout << "结果目录: ensemble/case_<编号>_mu_<mu>/" << std::endl;
+        std::cout << "===================================================\n" << std::endl;
+    }
+}
+
 // ==================== 主函数 ====================
 int main(int argc, char* argv[]) 
 {    
     // 初始化MPI环境
     MPI_Init(&argc, &argv);
     
+    MPI_Comm comm = MPI_COMM_WORLD;   // 求解器通信域（显式传入所有通信函数，集合模式下改为组通信域）
     int rank, num_procs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
     
     // -------------------- 参数设置 --------------------
     std::string mesh_folder;
@@ -35,12 +212,133 @@ int main(int argc, char* argv[])
 
     // 验证参数一致性
     verifyParameterConsistency_unsteady(mesh_folder, dt, timesteps, mu, n_splits, rank, num_procs);
+
+    // 可选参数（所有进程均可直接读取 argv）
+    RunOptions opts(argc, argv, 5);
+    if (rank == 0) opts.print();
+
+    // -------------------- 集合模式（--ensemble=FILE） --------------------
+    // 按算例数把 MPI_COMM_WORLD 划分为若干组，每组以各自的 mu / dt / 区域速度独立求解；
+    // 之后的 rank / num_procs 均为组内编号，求解器通信经 comm 限定在组内
+    const int world_rank = rank;
+    const std::string ensemble_file = opts.getString("ensemble", "");
+    const bool ensemble = !ensemble_file.empty();
+    const std::string batch_file = opts.getString("batch", "");   // 批量模式（见 runBatch）
+    if (ensemble && !batch_file.empty()) {
+        if (rank == 0) std::cerr << "--ensemble 与 --batch 不能同时使用" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (!batch_file.empty()) {
+        // 批量模式只有 double Jacobi-PCG 与全场输出，其余逐算例功能不支持
+        for (const char* key : { "stats", "probes", "checkpoint", "restart", "inexact", "precision",
+                                 "recycle", "precond", "sstep", "uv-solve" }) {
+            if (!opts.has(key)) continue;
+            if (rank == 0) std::cerr << "--" << key << " 不能与 --batch 同时使用" << std::endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+    std::vector<EnsembleCase> cases;
+    int case_id = 0;
+    MPI_Comm group_comm = MPI_COMM_NULL;
+    if (ensemble) {
+        if (world_rank == 0) cases = readEnsembleCases(ensemble_file);
+        broadcastEnsembleCases(cases, world_rank);
+        const int n_cases = static_cast<int>(cases.size());
+        if (n_cases == 0 || n_cases > num_procs) {
+            if (world_rank == 0) {
+                std::cerr << "集合算例数 (" << n_cases << ") 须在 1 与进程数 ("
+                          << num_procs << ") 之间" << std::endl;
+            }
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        case_id = world_rank * n_cases / num_procs;   // 连续的进程块组成一组
+        MPI_Comm_split(MPI_COMM_WORLD, case_id, world_rank, &group_comm);
+        comm = group_comm;
+        MPI_Comm_rank(group_comm, &rank);
+        MPI_Comm_size(group_comm, &num_procs);
+        n_splits = num_procs;
+        mu = cases[case_id].mu;
+        dt = cases[case_id].dt;
+    }
+
+    const bool fixed_iters  = opts.getBool("fixed-iters", false);  // 固定每步 SIMPLE 次数（扩展性测试）
+    const bool write_output = !opts.getBool("no-output", false);
+    const int  save_interval = opts.getInt("save-interval", 1);        // 全场输出间隔（0 = 仅最终）
+    const int  verbose      = opts.getBool("quiet", ensemble) ? 0 : 1;  // 集合模式默认静默
+
+    // 时间平均统计（--stats）：从 stats-start 步起在线累积，每 stats-interval 步输出一次累积量
+    const bool collect_stats  = opts.getBool("stats", false);
+    const int  stats_start    = opts.getInt("stats-start", 0);
+    const int  stats_interval = opts.getInt("stats-interval", 0);   // 0 = 仅最终输出
+
+    // 监测点（--probes=FILE）：每 probe-interval 个时间步采样一次，写入 <结果目录>/probes.csv
+    const std::string probe_file = opts.getString("probes", "");
+    const int probe_interval = std::max(1, opts.getInt("probe-interval", 1));
+    const std::string result_dir = ensemble ? ensembleCaseFolder(case_id, mu) : "result";
+    const std::string case_tag   = ensemble ? "[算例 " + std::to_string(case_id) + "] " : "";
+
+    // 线性求解器：double PCG 或混合精度迭代精化（--precision=mixed）
+    const bool mixed_precision = (opts.getString("precision", "double") == "mixed");
+    auto solveField = mixed_precision ? solveFieldPCGMixed : solveFieldPCG;
+
+    // 压力修正方程的 Krylov 子空间回收（--recycle=K，0 为关闭）
+    DeflationSpace deflation;
+    deflation.k = opts.getInt("recycle", 0);
+    deflation.m = opts.getInt("recycle-dirs", 16);
+
+    // 压力修正方程的预条件：jacobi（默认）或 Chebyshev 多项式（--precond=chebyshev）
+    const bool use_cheb = (opts.getString("precond", "jacobi") == "chebyshev");
+    ChebyshevPrecond cheb;
+    cheb.degree        = opts.getInt("cheb-degree", 4);
+    cheb.lanczos_steps = opts.getInt("cheb-lanczos", 10);
+    cheb.refresh       = opts.getInt("cheb-refresh", 20);
+
+    // s-step PCG（--sstep=S，0 为关闭），按方程选择（--sstep-eqs，默认仅压力方程）
+    SStepConfig sstep;
+    sstep.s               = opts.getInt("sstep", 0);
+    sstep.chebyshev_basis = (opts.getString("sstep-basis", "chebyshev") != "monomial");
+    const std::string sstep_eqs = opts.getString("sstep-eqs", "p");
+    using FieldSolver = std::function<void(Equation&, Mesh&, MatrixXd&, double, int,
+                                           int, int, MPI_Comm, double&, int)>;
+    auto pickSolver = [&](char eq) -> FieldSolver {
+        if (sstep.s > 0 && sstep_eqs.find(eq) != std::string::npos)
+            return [&sstep](Equation& e, Mesh& m, MatrixXd& f, double tol, int max_it,
+                            int rk, int np, MPI_Comm cm, double& l2, int vb) {
+                solveFieldPCGSStep(e, m, f, tol, max_it, rk, np, cm, l2, sstep, vb);
+            };
+        return solveField;
+    };
+    const FieldSolver solveU = pickSolver('u');
+    const FieldSolver solveV = pickSolver('v');
+    const FieldSolver solveP = pickSolver('p');
+    // u、v 动量方程同步求解（--uv-solve=fused）：两方程共享接口交换与 Allreduce；
+    // 混合精度或 s-step 作用于 u/v 时回退为依次求解
+    const bool uv_fused_req = (opts.getString("uv-solve", "sequential") == "fused");
+    const bool uv_fused     = uv_fused_req && !mixed_precision
+                              && !(sstep.s > 0 && sstep_eqs.find_first_of("uv") != std::string::npos);
+    if (rank == 0 && uv_fused_req && !uv_fused)
+        std::cout << "提示: --uv-solve=fused 不支持混合精度或 u/v 的 s-step，改为依次求解" << std::endl;
     
     // -------------------- 网格分割 --------------------
-    Mesh original_mesh(mesh_folder);
-    std::vector<Mesh> sub_meshes = splitMeshVertically(original_mesh, n_splits);
+    // 集合模式下仅 world rank 0 读取网格，再广播给所有组
+    Mesh original_mesh;
+    if (!ensemble || world_rank == 0) original_mesh = loadMesh(mesh_folder);
+    if (ensemble) {
+        broadcastMesh(original_mesh, 0, MPI_COMM_WORLD);
+        const EnsembleCase& c = cases[case_id];
+        for (size_t z = 0; z < c.zones.size(); ++z) {
+            original_mesh.setZoneUV(c.zones[z], c.zone_u[z], c.zone_v[z]);
+        }
+        if (!c.zones.empty()) original_mesh.initializeBoundaryConditions();
+    }
+    // 内部点编号策略（--ordering=row|col|rcm|tiled），由各子网格继承
+    original_mesh.ordering   = parseCellOrdering(opts.getString("ordering", "row"));
+    original_mesh.order_tile = opts.getInt("order-tile", 16);
+
+    // --partition=weighted 时按流体单元数（或实测代价）均衡各进程负载
+    std::vector<Mesh> sub_meshes = partitionMesh(original_mesh, n_splits, opts, rank == 0);
     
-    if (rank == 0) {
+    if (world_rank == 0) {
         printSimulationSetup_unsteady(sub_meshes, n_splits, dt, timesteps);
     }
     
@@ -72,78 +370,197 @@ int main(int argc, char* argv[])
     const double tol_p = 1e-5;    // 压力求解精度
     const int max_iter_uv = 10;   // 速度最大迭代次数
     const int max_iter_p = 200;   // 压力最大迭代次数
-    const int max_simple_iter = 20;  // 每个时间步SIMPLE最大迭代次数
+    const int max_simple_iter = opts.getInt("simple-iters", 20);  // 每个时间步SIMPLE最大迭代次数
     const double stagnation_tol = 1e-3;   // 0.1% 停滞阈值
-    double l2_norm_x, l2_norm_y, l2_norm_p;
+
+    if (!batch_file.empty()) {
+        std::vector<EnsembleCase> batch_cases;
+        if (rank == 0) batch_cases = readEnsembleCases(batch_file);
+        broadcastEnsembleCases(batch_cases, rank);
+        runBatch(batch_cases, original_mesh, opts, n_splits, timesteps, rank, num_procs, comm,
+                 alpha_p, tol_uv, tol_p, max_iter_uv, max_iter_p, max_simple_iter,
+                 stagnation_tol, fixed_iters, write_output, save_interval, verbose);
+        MPI_Finalize();
+        return 0;
+    }
+
+    // 非精确 SIMPLE（--inexact）：各方程的线性求解精度由外层残差决定（Eisenstat–Walker）
+    InexactTolerance ew_u, ew_v, ew_p;
+    for (InexactTolerance* ew : {&ew_u, &ew_v, &ew_p}) {
+        ew->enabled = opts.getBool("inexact", false);
+        ew->gamma   = opts.getDouble("ew-gamma", 0.9);
+        ew->alpha   = opts.getDouble("ew-alpha", 2.0);
+        ew->eta_max = opts.getDouble("ew-eta-max", 0.1);
+        ew->tol_min = opts.getDouble("ew-tol-min", 1e-10);
+    }
+    ew_u.tol_fixed = ew_v.tol_fixed = tol_uv;
+    ew_p.tol_fixed = tol_p;
+    double l2_norm_x = 0.0, l2_norm_y = 0.0, l2_norm_p = 0.0;
+
+    FlowStatistics stats;
+    stats.reset(mesh);
+
+    // -------------------- 检查点 / 重启 --------------------
+    // --restart=FILE 从检查点继续（进程数可与写出时不同）；
+    // --checkpoint=FILE 每 checkpoint-interval 个时间步及收到 SIGUSR1 / SIGTERM 时写出。
+    // 集合模式下文件位于各算例的结果目录内
+    auto case_path = [&](const std::string& f) {
+        return (ensemble && !f.empty()) ? result_dir + "/" + fs::path(f).filename().string() : f;
+    };
+    const std::string ckpt_file    = case_path(opts.getString("checkpoint", ""));
+    const std::string restart_file = case_path(opts.getString("restart", ""));
+    const int ckpt_interval = opts.getInt("checkpoint-interval", 0);
+    int first_step = 0;
+    if (!restart_file.empty()) {
+        int step;
+        double time;
+        readCheckpoint(restart_file, mesh, original_mesh.nx, step, time, comm,
+                       collect_stats ? &stats : nullptr);
+        first_step = step + 1;
+        if (rank == 0) {
+            std::cout << case_tag << "从检查点 " << restart_file << " 重启：已完成时间步 "
+                      << step << " (t = " << time << ")" << std::endl;
+            if (collect_stats && stats.samples == 0 && step >= stats_start) {
+                std::cout << case_tag << "警告: 检查点不含时间平均统计，统计将从第 "
+                          << first_step << " 步重新累积" << std::endl;
+            }
+        }
+    }
+    if (!ckpt_file.empty()) installCheckpointSignals();
+
+    ProbeSet probes;
+    if (!probe_file.empty()) {
+        probes.load(probe_file, rank, comm);
+        probes.resolve(mesh, rank, num_procs);
+        probes.open(result_dir + "/probes.csv", rank, restart_file.empty() ? -1 : first_step - 1);
+    }
     
+    int iters_done = 0;
+    total_comm_time = 0.0;
+    // 按内核的硬件计数器（--counters）：IPC、带宽、算术强度
+    kernel_profiler.init(opts.getBool("counters", false), rank);
+    const double n_cells = static_cast<double>(mesh.nx) * mesh.ny;
+    const double n_int   = mesh.internumber;
     auto start_time = std::chrono::steady_clock::now();
     
-    if (rank == 0) {
+    if (world_rank == 0) {
         std::cout << "\n==================== 开始非定常计算 ====================" << std::endl;
+        if (ensemble) {
+            std::cout << "集合模式: " << cases.size() << " 个算例, " << num_procs
+                      << " 个进程/组（按组内进程数分割网格）" << std::endl;
+        }
     }
     
     // ==================== 时间推进主循环 ====================
-    for (int time_step = 0; time_step <= timesteps; ++time_step) {
+    for (int time_step = first_step; time_step <= timesteps; ++time_step) {
         
-        if (rank == 0) {
+        if (rank == 0 && verbose) {
             std::cout << "\n-------------------- 时间步: " << time_step 
                       << " / " << timesteps << " --------------------" << std::endl;
         }
         
-        MPI_Barrier(MPI_COMM_WORLD);
+        MPI_Barrier(comm);
         
     
         double prev_l2_u = -1.0;
         double prev_l2_v = -1.0;
         double prev_l2_p = -1.0;
+        ew_u.reset();
+        ew_v.reset();
+        ew_p.reset();
 
         // ==================== SIMPLE迭代求解 ====================
         for (int n = 1; n <= max_simple_iter; n++) {
+            iters_done++;
 
             
             // -------------------- 步骤1: 求解动量方程 --------------------
 
             
             // 离散非定常动量方程
+            kernel_profiler.start(KERNEL_MOMENTUM);
             momentum_function_unsteady(mesh, equ_u, equ_v, mu, dt);
+            kernel_profiler.stop(KERNEL_MOMENTUM, n_cells);
+            const double tol_u_k = ew_u.begin(equ_u, mesh, &mesh.u_star, rank, num_procs, comm);
+            const double tol_v_k = ew_v.begin(equ_v, mesh, &mesh.v_star, rank, num_procs, comm);
 
             
             
             //解速度场
-             solveFieldPCG(equ_u, mesh, mesh.u,
-             tol_uv, max_iter_uv,
-             rank, num_procs,
-             l2_norm_x,1);
-
-            solveFieldPCG(equ_v, mesh, mesh.v,
-             tol_uv, max_iter_uv,
-             rank, num_procs,
-             l2_norm_y, 1);
-            exchangeColumns(equ_u.A_p, rank, num_procs);
+            if (uv_fused) {
+                // 同步求解的耗时全部计入 u 内核
+                kernel_profiler.start(KERNEL_SOLVE_U);
+                solveFieldPCGPair(equ_u, equ_v, mesh.u, mesh.v,
+                 tol_u_k, tol_v_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_x, l2_norm_y, verbose);
+                kernel_profiler.stop(KERNEL_SOLVE_U, 2 * n_int * solver_stats.iterations);
+                ew_u.end(equ_u, mesh, &mesh.u, rank, num_procs, comm);
+                ew_v.end(equ_v, mesh, &mesh.v, rank, num_procs, comm);
+            } else {
+                kernel_profiler.start(KERNEL_SOLVE_U);
+                solveU(equ_u, mesh, mesh.u,
+                 tol_u_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_x, verbose);
+                kernel_profiler.stop(KERNEL_SOLVE_U, n_int * solver_stats.iterations);
+                ew_u.end(equ_u, mesh, &mesh.u, rank, num_procs, comm);
+
+                kernel_profiler.start(KERNEL_SOLVE_V);
+                solveV(equ_v, mesh, mesh.v,
+                 tol_v_k, max_iter_uv,
+                 rank, num_procs, comm,
+                 l2_norm_y, verbose);
+                kernel_profiler.stop(KERNEL_SOLVE_V, n_int * solver_stats.iterations);
+                ew_v.end(equ_v, mesh, &mesh.v, rank, num_procs, comm);
+            }
+            exchangeColumns(equ_u.A_p, rank, num_procs, comm);
             
 
             
             // -------------------- 步骤2: 速度插值到面 --------------------
+            kernel_profiler.start(KERNEL_FACE_VELOCITY);
             face_velocity(mesh, equ_u);
+            kernel_profiler.stop(KERNEL_FACE_VELOCITY, n_cells);
 
             // -------------------- 步骤3: 求解压力修正方程 --------------------
  
+            kernel_profiler.start(KERNEL_PRESSURE);
             pressure_function(mesh, equ_p, equ_u);
+            kernel_profiler.stop(KERNEL_PRESSURE, n_cells);
+            const double tol_p_k = ew_p.begin(equ_p, mesh, nullptr, rank, num_procs, comm);
 
-            solveFieldPCG(equ_p, mesh, mesh.p_prime,
-             tol_p, max_iter_p,
-             rank, num_procs,
-             l2_norm_p, 1);
+            kernel_profiler.start(KERNEL_SOLVE_P);
+            if (deflation.k > 0) {
+                solveFieldPCGDeflated(equ_p, mesh, mesh.p_prime,
+                     tol_p_k, max_iter_p,
+                     rank, num_procs, comm,
+                     l2_norm_p, deflation, verbose);
+            } else if (use_cheb) {
+                solveFieldPCGCheb(equ_p, mesh, mesh.p_prime,
+                     tol_p_k, max_iter_p,
+                     rank, num_procs, comm,
+                     l2_norm_p, cheb, verbose);
+            } else {
+                solveP(equ_p, mesh, mesh.p_prime,
+                     tol_p_k, max_iter_p,
+                     rank, num_procs, comm,
+                     l2_norm_p, verbose);
+            }
+            kernel_profiler.stop(KERNEL_SOLVE_P, n_int * solver_stats.iterations);
+            ew_p.end(equ_p, mesh, nullptr, rank, num_procs, comm);
             
             // -------------------- 步骤4: 修正压力和速度 --------------------
+            kernel_profiler.start(KERNEL_CORRECT);
             correct_pressure(mesh, alpha_p);
             correct_velocity(mesh, equ_u);
+            kernel_profiler.stop(KERNEL_CORRECT, n_cells);
             
             // 更新压力场
             mesh.p = mesh.p_star;
             
 
-            exchangeColumns(mesh.p, rank, num_procs);
+            exchangeColumns(mesh.p, rank, num_procs, comm);
 
             
             // -------------------- 步骤5: 收敛性检查 --------------------
@@ -151,7 +568,7 @@ int main(int argc, char* argv[])
            
             
             // 仅rank 0打印残差信息
-            if (rank == 0) {
+            if (rank == 0 && verbose) {
                 std::cout << std::scientific 
                           << "  迭代 " << std::setw(3) << n 
                           << " | 全局残差 → "
@@ -163,7 +580,7 @@ int main(int argc, char* argv[])
             // ==================== 时间步内停滞判断 ====================
             int local_stagnated = 0;
 
-            if (n > 1) {
+            if (n > 1 && !fixed_iters) {
             double du = abs(l2_norm_x - prev_l2_u) / (prev_l2_u + 1e-20);
             double dv = abs(l2_norm_y - prev_l2_v) / (prev_l2_v + 1e-20);
             double dp = abs(l2_norm_p - prev_l2_p) / (prev_l2_p + 1e-20);
@@ -183,24 +600,24 @@ int main(int argc, char* argv[])
             // 全局同步判断
             int global_stagnated = 0;
             MPI_Allreduce(&local_stagnated, &global_stagnated,
-              1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+              1, MPI_INT, MPI_MAX, comm);
 
             if (global_stagnated) {
                 if (rank == 0) {
-                  std::cout << "  SIMPLE 停滞退出：残差变化 < "
+                  std::cout << "  " << case_tag << "SIMPLE 停滞退出：残差变化 < "
                   << stagnation_tol * 100.0 << "%，迭代步 = "
                   << n << std::endl;
             }
             break;
             }
             // 检查全局收敛
-            int local_converged = checkConvergence(l2_norm_x, l2_norm_y, l2_norm_p);
+            int local_converged = !fixed_iters && checkConvergence(l2_norm_x, l2_norm_y, l2_norm_p);
             int global_converged;
-            MPI_Allreduce(&local_converged, &global_converged, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+            MPI_Allreduce(&local_converged, &global_converged, 1, MPI_INT, MPI_MIN, comm);
             
             if (global_converged) {
                 if (rank == 0) {
-                    std::cout << "  时间步 " << time_step 
+                    std::cout << "  " << case_tag << "时间步 " << time_step 
                               << " 收敛 (SIMPLE迭代: " << n << ")" << std::endl;
                 }
                 break;
@@ -211,23 +628,130 @@ int main(int argc, char* argv[])
         
         // -------------------- 步骤6: 时间推进 --------------------
         // 保存当前时间步数据
-        saveMeshData(mesh, rank,"result");
+        if (write_output && save_interval > 0 && time_step % save_interval == 0) {
+            saveMeshData(mesh, rank, result_dir);
+        }
+
+        // 监测点采样
+        if (!probe_file.empty() && time_step % probe_interval == 0) {
+            probes.sample(mesh, time_step, time_step * dt, rank, comm);
+        }
+
+        // 累积时间平均统计量
+        if (collect_stats && time_step >= stats_start) {
+            stats.update(mesh);
+            if (write_output && stats_interval > 0 && stats.samples % stats_interval == 0) {
+                stats.save(mesh, rank, result_dir + "/stats");
+            }
+        }
         
         // 更新上一时间步速度场
         mesh.u0 = mesh.u_star;
         mesh.v0 = mesh.v_star;
+
+        // 检查点
+        if (!ckpt_file.empty()) {
+            const int sig = pollCheckpointSignal(comm);
+            if (sig > 0 || (ckpt_interval > 0 && time_step % ckpt_interval == 0)) {
+                writeCheckpoint(ckpt_file, mesh, original_mesh.nx, time_step, time_step * dt, comm,
+                                collect_stats ? &stats : nullptr);
+                if (rank == 0) {
+                    std::cout << "  " << case_tag << "检查点已写出: " << ckpt_file
+                              << " (时间步 " << time_step << ")" << std::endl;
+                }
+            }
+            if (sig == 2) {
+                if (rank == 0) std::cout << "\n" << case_tag << "收到 SIGTERM，保存检查点后停止" << std::endl;
+                break;
+            }
+        }
         
-        MPI_Barrier(MPI_COMM_WORLD);
+        MPI_Barrier(comm);
     }
     
-    // ==================== 计算完成 ====================
-    saveMeshData(mesh, rank,"result");
-    
     auto total_elapsed_time = std::chrono::duration<double>(
         std::chrono::steady_clock::now() - start_time).count();
+
+    if (opts.getBool("perf", false)) {
+        reportPerfSummary("unsteady", total_elapsed_time, iters_done,
+                          static_cast<long>(original_mesh.nx) * original_mesh.ny,
+                          rank, num_procs, comm, l2_norm_x, l2_norm_y, l2_norm_p);
+    }
+    kernel_profiler.report(rank, num_procs, comm);
+
+    // ==================== 计算完成 ====================
+    if (write_output) {
+        saveMeshData(mesh, rank, result_dir);
+        if (collect_stats) stats.save(mesh, rank, result_dir + "/stats");
+    }
     
-    if (rank == 0) {
+    // 集合模式：各组根进程的结果汇总到 world rank 0 打印
+    if (ensemble) {
+        const double local_row[5] = { static_cast<double>(case_id), mu, dt,
+                                      static_cast<double>(iters_done), total_elapsed_time };
+        std::vector<double> rows(5 * (world_rank == 0 ? cases.size() : 0));
+        int root_flag = (rank == 0);
+        MPI_Comm roots;
+        MPI_Comm_split(MPI_COMM_WORLD, root_flag ? 0 : MPI_UNDEFINED, world_rank, &roots);
+        if (root_flag) {
+            MPI_Gather(local_row, 5, MPI_DOUBLE, rows.data(), 5, MPI_DOUBLE, 0, roots);
+            MPI_Comm_free(&roots);
+        }
+        if (world_rank == 0) {
+            std::cout << "\n==================== 集合计算完成 ====================" << std::endl;
+            std::cout << "算例  mu            dt            SIMPLE迭代  耗时(秒)  结果目录" << std::endl;
+            for (size_t c = 0; c < cases.size(); ++c) {
+                const double* r = &rows[5 * c];
+                std::cout << std::setw(4) << static_cast<int>(r[0]) << "  "
+                          << std::scientific << std::setprecision(4)
+                          << r[1] << "  " << r[2] << "  "
+                          << std::setw(10) << static_cast<int>(r[3]) << "  "
+                          << std::fixed << std::setprecision(3) << std::setw(8) << r[4] << "  "
+                          << ensembleCaseFolder(static_cast<int>(r[0]), r[1]) << std::endl;
+            }
+            std::cout << "===================================================\n" << std::endl;
+        }
+        comm = MPI_COMM_WORLD;
+        MPI_Comm_free(&group_comm);
+    }
+
+    if (rank == 0 && !ensemble) {
         std::cout << "\n==================== 计算完成 ====================" << std::endl;
+        if (deflation.k > 0 && deflation.solves > 0) {
+            std::cout << "压力方程子空间回收: k = " << deflation.k
+                      << ", 平均每次求解 " << double(deflation.iterations) / deflation.solves
+                      << " 次迭代, 额外 SpMV(S·W) " << deflation.extra_spmv << " 次" << std::endl;
+        }
+        if (use_cheb && cheb.solves > 0) {
+            std::cout << "压力方程 Chebyshev 预条件: 阶数 " << cheb.degree
+                      << ", 谱区间 [" << cheb.lmin << ", " << cheb.lmax << "]"
+                      << ", 平均每次求解 " << double(cheb.iterations) / cheb.solves
+                      << " 次外层迭代, 谱估计 " << cheb.estimates << " 次" << std::endl;
+        }
+        if (sstep.s > 0 && sstep.solves > 0) {
+            std::cout << "s-step PCG (s = " << sstep.s << ", 方程 " << sstep_eqs << "): "
+                      << sstep.iterations << " 次等效迭代, " << sstep.rounds
+                      << " 次 Gram 归约" << std::endl;
+        }
+        std::cout << "线性求解 Krylov 迭代: u " << ew_u.iterations << ", v " << ew_v.iterations
+                  << ", p " << ew_p.iterations
+                  << (ew_p.enabled ? " (非精确 SIMPLE)" : " (固定精度)") << std::endl;
+        if (reduction_overlap.reductions > 0) {
+            std::cout << "PCG 非阻塞归约: " << reduction_overlap.reductions << " 次, 重叠窗口 "
+                      << reduction_overlap.window << " 秒, 等待 " << reduction_overlap.wait
+                      << " 秒, 等待前已完成 " << 100.0 * reduction_overlap.completed
+                                                  / reduction_overlap.reductions
+                      << "%, 延迟隐藏比例 ≤ " << 100.0 * reduction_overlap.hiddenFraction()
+                      << "%" << std::endl;
+        }
+        if (!probe_file.empty()) {
+            std::cout << "监测点: " << probes.names.size() << " 个, " << probes.samples
+                      << " 次采样, 输出到 " << result_dir << "/probes.csv" << std::endl;
+        }
+        if (collect_stats) {
+            std::cout << "时间平均统计: " << stats.samples << " 个样本, 输出到 "
+                      << result_dir << "/stats/" << std::endl;
+        }
         std::cout << "总时间步数: " << timesteps + 1 << std::endl;
         std::cout << "总耗时: " << total_elapsed_time << " 秒" << std::endl;
         std::cout << "平均每步: " << total_elapsed_time / (timesteps + 1) << " 秒" << std::endl;